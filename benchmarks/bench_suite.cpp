@@ -0,0 +1,431 @@
+// benchmarks/bench_suite.cpp
+// Hot-path benchmark suite. Every case runs a warm-up pass and then a fixed
+// number of timed operations on a freshly seeded database, recording each
+// operation's latency. Results go to stdout (or --out) as JSON, one object per
+// case, so two runs can be diffed to catch regressions; a readable summary goes
+// to stderr.
+//
+// Usage: sqlite_flux_bench [--quick] [--filter <substring>] [--out <file.json>] [--db <path>]
+#include "Analyzer.h"
+#include "QueryBuilder.h"
+#include "InsertBuilder.h"
+#include "UpdateBuilder.h"
+#include "DeleteBuilder.h"
+#include "ConnectionPool.h"
+#include "AsyncExecutor.h"
+#include <sqlite3.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct Config
+	{
+		std::string dbPath = "sqlite_flux_bench.db";
+		std::string filter;
+		std::string outPath;
+		bool quick = false;
+
+		// Scaled down by --quick for smoke runs
+		int64_t ops(int64_t full) const { return quick ? std::max<int64_t>(full / 20, 10) : full; }
+	}; // end of struct Config
+
+	struct Result
+	{
+		std::string name;
+		std::string unit = "op";  // What one sample measures
+		int64_t itemsPerOp = 1;   // Rows (etc.) handled by one operation
+		int threads = 1;
+		std::vector<double> samplesNs;
+		double wallNs = 0;        // Whole timed phase, all threads
+	}; // end of struct Result
+
+	double percentile(const std::vector<double>& sorted, double p)
+	{
+		if (sorted.empty()) return 0;
+		size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+		return sorted[std::min(index, sorted.size() - 1)];
+	} // end of percentile
+
+	void removeDatabase(const std::string& dbPath)
+	{
+		std::remove(dbPath.c_str());
+		std::remove((dbPath + "-wal").c_str());
+		std::remove((dbPath + "-shm").c_str());
+	} // end of removeDatabase
+
+	// Fresh database with `rows` rows in items(id, user_id, kind, payload, score)
+	void seedDatabase(const std::string& dbPath, int64_t rows)
+	{
+		removeDatabase(dbPath);
+
+		sqlite_flux::Analyzer db(dbPath);
+		bool ok = db.execute(R"(
+			CREATE TABLE items (
+				id INTEGER PRIMARY KEY,
+				user_id INTEGER NOT NULL,
+				kind TEXT NOT NULL,
+				payload TEXT,
+				score REAL
+			);
+			CREATE INDEX idx_items_user ON items(user_id);
+		)");
+		ok = ok && db.execute(
+			"WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < " + std::to_string(rows) + ") "
+			"INSERT INTO items(user_id, kind, payload, score) "
+			"SELECT i % 100, CASE i % 3 WHEN 0 THEN 'click' WHEN 1 THEN 'view' ELSE 'purchase' END, "
+			"'payload-' || i, i * 0.5 FROM n");
+		if (!ok)
+		{
+			throw std::runtime_error("Failed to seed database: " + db.getLastError());
+		} // end of if
+	} // end of seedDatabase
+
+	// Time `ops` calls of op(i) after `warmup` untimed ones
+	Result measure(const std::string& name, int64_t warmup, int64_t ops, const std::function<void(int64_t)>& op)
+	{
+		for (int64_t i = 0; i < warmup; ++i)
+		{
+			op(i);
+		} // end of for
+
+		Result result;
+		result.name = name;
+		result.samplesNs.reserve(static_cast<size_t>(ops));
+
+		auto begin = Clock::now();
+		for (int64_t i = 0; i < ops; ++i)
+		{
+			auto start = Clock::now();
+			op(warmup + i);
+			result.samplesNs.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+		} // end of for
+		result.wallNs = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+
+		return result;
+	} // end of measure
+
+	// ============================================================================
+	// Benchmarks
+	// ============================================================================
+
+	Result benchAnalyzerQuery(const Config& config)
+	{
+		seedDatabase(config.dbPath, 10000);
+		sqlite_flux::Analyzer db(config.dbPath);
+
+		// 100 rows x 5 columns decoded into Row maps per call
+		auto result = measure("analyzer_query_decode_100rows", 20, config.ops(2000), [&db](int64_t i) {
+			int64_t first = (i * 100) % 9900;
+			auto rows = db.query("SELECT * FROM items WHERE id > ? AND id <= ?", { first, first + 100 });
+			if (rows.size() != 100) throw std::runtime_error("analyzer_query_decode: unexpected row count");
+			});
+		result.unit = "query";
+		result.itemsPerOp = 100;
+		return result;
+	} // end of benchAnalyzerQuery
+
+	Result benchQueryBuilder(const Config& config)
+	{
+		seedDatabase(config.dbPath, 10000);
+		sqlite_flux::Analyzer db(config.dbPath);
+
+		// Builder construction, validation, SQL generation and execution
+		auto result = measure("querybuilder_execute_indexed", 20, config.ops(5000), [&db](int64_t i) {
+			sqlite_flux::QueryBuilder query(db, "items");
+			auto rows = query.Columns("id", "kind", "score")
+				.Filter("user_id", i % 100)
+				.OrderBy("id")
+				.Limit(20)
+				.Execute();
+			if (rows.size() != 20) throw std::runtime_error("querybuilder_execute: unexpected row count");
+			});
+		result.unit = "query";
+		result.itemsPerOp = 20;
+		return result;
+	} // end of benchQueryBuilder
+
+	Result benchPreparedInsert(const Config& config)
+	{
+		seedDatabase(config.dbPath, 0);
+		sqlite_flux::Analyzer db(config.dbPath);
+		const int64_t batchRows = 1000;
+
+		const std::vector<std::string> columns = { "user_id", "kind", "payload", "score" };
+		auto result = measure("prepared_insert_batch_1000rows", 2, config.ops(100), [&](int64_t i) {
+			auto batch = sqlite_flux::InsertBuilder(db, "items").Prepare(columns);
+			std::vector<sqlite_flux::ColumnValue> row(columns.size());
+			for (int64_t r = 0; r < batchRows; ++r)
+			{
+				int64_t n = i * batchRows + r;
+				row[0] = n % 100;
+				row[1] = std::string("view");
+				row[2] = "payload-" + std::to_string(n);
+				row[3] = static_cast<double>(n);
+				batch.Values(row).ExecuteBatch();
+			} // end of for
+			if (batch.Finalize() != batchRows) throw std::runtime_error("prepared_insert: short batch");
+			});
+		result.unit = "batch";
+		result.itemsPerOp = batchRows;
+		return result;
+	} // end of benchPreparedInsert
+
+	Result benchUpdateBuilder(const Config& config)
+	{
+		seedDatabase(config.dbPath, 10000);
+		sqlite_flux::Analyzer db(config.dbPath);
+		db.execute("PRAGMA synchronous=NORMAL");
+
+		// One autocommit UPDATE by primary key per operation
+		auto result = measure("update_builder_by_pk", 20, config.ops(2000), [&db](int64_t i) {
+			int64_t changed = sqlite_flux::UpdateBuilder(db, "items")
+				.Set("score", static_cast<double>(i))
+				.Where("id", i % 10000 + 1)
+				.Execute();
+			if (changed != 1) throw std::runtime_error("update_builder: row not updated");
+			});
+		result.unit = "statement";
+		return result;
+	} // end of benchUpdateBuilder
+
+	Result benchDeleteBuilder(const Config& config)
+	{
+		const int64_t ops = config.ops(2000);
+		const int64_t warmup = 20;
+		seedDatabase(config.dbPath, ops + warmup);
+		sqlite_flux::Analyzer db(config.dbPath);
+		db.execute("PRAGMA synchronous=NORMAL");
+
+		// One autocommit DELETE by primary key per operation (each row exists once)
+		auto result = measure("delete_builder_by_pk", warmup, ops, [&db](int64_t i) {
+			int64_t deleted = sqlite_flux::DeleteBuilder(db, "items").Where("id", i + 1).Execute();
+			if (deleted != 1) throw std::runtime_error("delete_builder: row not deleted");
+			});
+		result.unit = "statement";
+		return result;
+	} // end of benchDeleteBuilder
+
+	// Every thread acquires and releases a connection in a loop
+	Result benchPoolAcquire(const Config& config, int threads)
+	{
+		seedDatabase(config.dbPath, 0);
+		sqlite_flux::PoolOptions options;
+		options.poolSize = 4;
+		options.minPoolSize = 4;
+		sqlite_flux::ConnectionPool pool(config.dbPath, options);
+
+		const int64_t perThread = config.ops(50000);
+		std::vector<std::vector<double>> samples(static_cast<size_t>(threads));
+		std::atomic<int> ready{ 0 };
+		std::atomic<bool> go{ false };
+
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; ++t)
+		{
+			workers.emplace_back([&, t] {
+				auto& mine = samples[static_cast<size_t>(t)];
+				mine.reserve(static_cast<size_t>(perThread));
+				for (int64_t i = 0; i < 100; ++i)
+				{
+					auto conn = pool.acquire();
+				} // end of for
+
+				ready.fetch_add(1);
+				while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+				for (int64_t i = 0; i < perThread; ++i)
+				{
+					auto start = Clock::now();
+					{
+						auto conn = pool.acquire();
+					} // end of lease scope
+					mine.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+				} // end of for
+				});
+		} // end of for
+
+		while (ready.load() < threads) std::this_thread::yield();
+		auto begin = Clock::now();
+		go.store(true, std::memory_order_release);
+		for (auto& worker : workers) worker.join();
+
+		Result result;
+		result.name = "pool_acquire_release_" + std::to_string(threads) + "threads";
+		result.unit = "acquire";
+		result.threads = threads;
+		result.wallNs = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+		for (auto& mine : samples)
+		{
+			result.samplesNs.insert(result.samplesNs.end(), mine.begin(), mine.end());
+		} // end of for
+		return result;
+	} // end of benchPoolAcquire
+
+	Result benchAsyncRoundTrip(const Config& config)
+	{
+		seedDatabase(config.dbPath, 100);
+		sqlite_flux::ConnectionPool pool(config.dbPath, 4);
+		sqlite_flux::AsyncExecutor executor(pool, 2);
+
+		// Submit, hop to a worker, run a trivial query and hand the result back
+		auto result = measure("async_query_round_trip", 100, config.ops(5000), [&executor](int64_t) {
+			auto rows = executor.query("SELECT id FROM items WHERE id = 1").get();
+			if (rows.size() != 1) throw std::runtime_error("async_round_trip: unexpected row count");
+			});
+		result.unit = "round trip";
+		return result;
+	} // end of benchAsyncRoundTrip
+
+	// ============================================================================
+	// Reporting
+	// ============================================================================
+
+	std::string jsonString(const std::string& text)
+	{
+		std::string out = "\"";
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\') out += '\\';
+			out += c;
+		} // end of for
+		return out + "\"";
+	} // end of jsonString
+
+	void writeJson(std::ostream& out, const std::vector<Result>& results, const Config& config)
+	{
+		out << std::fixed << std::setprecision(1);
+		out << "{\n"
+			<< "  \"suite\": \"sqlite_flux_bench\",\n"
+			<< "  \"sqlite_version\": " << jsonString(sqlite3_libversion()) << ",\n"
+			<< "  \"timestamp\": " << static_cast<int64_t>(std::time(nullptr)) << ",\n"
+			<< "  \"quick\": " << (config.quick ? "true" : "false") << ",\n"
+			<< "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+			<< "  \"benchmarks\": [";
+
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			const Result& r = results[i];
+			std::vector<double> sorted = r.samplesNs;
+			std::sort(sorted.begin(), sorted.end());
+
+			double total = 0;
+			for (double ns : sorted) total += ns;
+			const double mean = sorted.empty() ? 0 : total / static_cast<double>(sorted.size());
+			const double opsPerSec = r.wallNs > 0 ? static_cast<double>(sorted.size()) * 1e9 / r.wallNs : 0;
+
+			out << (i == 0 ? "\n" : ",\n")
+				<< "    {\n"
+				<< "      \"name\": " << jsonString(r.name) << ",\n"
+				<< "      \"unit\": " << jsonString(r.unit) << ",\n"
+				<< "      \"threads\": " << r.threads << ",\n"
+				<< "      \"samples\": " << sorted.size() << ",\n"
+				<< "      \"items_per_op\": " << r.itemsPerOp << ",\n"
+				<< "      \"ops_per_sec\": " << opsPerSec << ",\n"
+				<< "      \"items_per_sec\": " << opsPerSec * static_cast<double>(r.itemsPerOp) << ",\n"
+				<< "      \"mean_ns\": " << mean << ",\n"
+				<< "      \"min_ns\": " << (sorted.empty() ? 0 : sorted.front()) << ",\n"
+				<< "      \"p50_ns\": " << percentile(sorted, 0.50) << ",\n"
+				<< "      \"p90_ns\": " << percentile(sorted, 0.90) << ",\n"
+				<< "      \"p99_ns\": " << percentile(sorted, 0.99) << ",\n"
+				<< "      \"max_ns\": " << (sorted.empty() ? 0 : sorted.back()) << "\n"
+				<< "    }";
+		} // end of for
+
+		out << "\n  ]\n}\n";
+	} // end of writeJson
+
+	void printSummary(const Result& r)
+	{
+		std::vector<double> sorted = r.samplesNs;
+		std::sort(sorted.begin(), sorted.end());
+		const double opsPerSec = r.wallNs > 0 ? static_cast<double>(sorted.size()) * 1e9 / r.wallNs : 0;
+
+		std::cerr << std::left << std::setw(36) << r.name << std::right << std::fixed << std::setprecision(0)
+			<< std::setw(12) << opsPerSec << " " << r.unit << "/s"
+			<< "   p50 " << std::setw(9) << percentile(sorted, 0.50) << " ns"
+			<< "   p99 " << std::setw(9) << percentile(sorted, 0.99) << " ns\n";
+	} // end of printSummary
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		Config config;
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			if (arg == "--quick") config.quick = true;
+			else if (arg == "--filter" && i + 1 < argc) config.filter = argv[++i];
+			else if (arg == "--out" && i + 1 < argc) config.outPath = argv[++i];
+			else if (arg == "--db" && i + 1 < argc) config.dbPath = argv[++i];
+			else
+			{
+				std::cerr << "Usage: sqlite_flux_bench [--quick] [--filter <substring>] [--out <file.json>] [--db <path>]\n";
+				return 2;
+			} // end of else
+		} // end of for
+
+		std::vector<std::pair<std::string, std::function<Result()>>> cases = {
+			{ "analyzer_query_decode_100rows", [&] { return benchAnalyzerQuery(config); } },
+			{ "querybuilder_execute_indexed", [&] { return benchQueryBuilder(config); } },
+			{ "prepared_insert_batch_1000rows", [&] { return benchPreparedInsert(config); } },
+			{ "update_builder_by_pk", [&] { return benchUpdateBuilder(config); } },
+			{ "delete_builder_by_pk", [&] { return benchDeleteBuilder(config); } },
+			{ "async_query_round_trip", [&] { return benchAsyncRoundTrip(config); } },
+		};
+
+		const int maxThreads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 4u));
+		for (int threads = 1; threads <= maxThreads; threads *= 2)
+		{
+			cases.emplace_back("pool_acquire_release_" + std::to_string(threads) + "threads",
+				[&config, threads] { return benchPoolAcquire(config, threads); });
+		} // end of for
+
+		std::vector<Result> results;
+		for (auto& [name, run] : cases)
+		{
+			if (!config.filter.empty() && name.find(config.filter) == std::string::npos) continue;
+
+			results.push_back(run());
+			printSummary(results.back());
+		} // end of for
+
+		removeDatabase(config.dbPath);
+
+		if (config.outPath.empty())
+		{
+			writeJson(std::cout, results, config);
+		} // end of if
+		else
+		{
+			std::ofstream out(config.outPath);
+			writeJson(out, results, config);
+			if (!out)
+			{
+				throw std::runtime_error("Failed to write " + config.outPath);
+			} // end of if
+		} // end of else
+
+		return 0;
+	} // end of try
+	catch (const std::exception& e)
+	{
+		std::cerr << "Benchmark failed: " << e.what() << "\n";
+		return 1;
+	} // end of catch
+} // end of main
@@ -0,0 +1,141 @@
+// benchmarks/bulk_insert_benchmark.cpp
+// Compares PreparedInsert (one bound statement per row) against BulkInsert
+// (multi-row VALUES) with and without bulk-load pragmas/deferred indexes.
+//
+// Usage: sqlite_flux_bulk_insert_bench [rows] [database path]
+#include "Analyzer.h"
+#include "QueryBuilder.h"
+#include "InsertBuilder.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace
+{
+	const char* kSchema = R"(
+		CREATE TABLE events (
+			id INTEGER PRIMARY KEY,
+			user_id INTEGER NOT NULL,
+			kind TEXT NOT NULL,
+			payload TEXT,
+			score REAL
+		);
+		CREATE INDEX idx_events_user ON events(user_id);
+		CREATE INDEX idx_events_kind ON events(kind);
+	)";
+
+	const std::vector<std::string> kColumns = { "user_id", "kind", "payload", "score" };
+
+	// Fresh database per run so every strategy starts from the same state
+	void resetDatabase(const std::string& dbPath)
+	{
+		std::remove(dbPath.c_str());
+		std::remove((dbPath + "-wal").c_str());
+		std::remove((dbPath + "-shm").c_str());
+
+		sqlite_flux::Analyzer db(dbPath);
+		if (!db.execute(kSchema))
+		{
+			throw std::runtime_error("Failed to create schema: " + db.getLastError());
+		} // end of if
+	} // end of resetDatabase
+
+	void fillRow(std::vector<sqlite_flux::ColumnValue>& row, int64_t i)
+	{
+		row[0] = i % 5000;
+		row[1] = std::string(i % 3 == 0 ? "click" : (i % 3 == 1 ? "view" : "purchase"));
+		row[2] = "payload-" + std::to_string(i);
+		row[3] = static_cast<double>(i) * 0.5;
+	} // end of fillRow
+
+	double timeRun(const std::string& dbPath, int64_t rows,
+		const std::function<int64_t(sqlite_flux::InsertBuilder&, int64_t)>& load)
+	{
+		resetDatabase(dbPath);
+
+		sqlite_flux::Analyzer db(dbPath);
+		sqlite_flux::QueryFactory factory(db);
+		auto builder = factory.InsertInto("events");
+
+		auto start = std::chrono::steady_clock::now();
+		int64_t inserted = load(builder, rows);
+		auto end = std::chrono::steady_clock::now();
+
+		if (inserted != rows || db.getRowCount("events").value_or(0) != rows)
+		{
+			throw std::runtime_error("Row count mismatch after load");
+		} // end of if
+
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	} // end of timeRun
+
+	void report(const std::string& name, int64_t rows, double ms, double baselineMs)
+	{
+		std::cout << std::left << std::setw(36) << name
+			<< std::right << std::setw(10) << std::fixed << std::setprecision(1) << ms << " ms"
+			<< std::setw(12) << static_cast<int64_t>(rows * 1000.0 / ms) << " rows/s"
+			<< std::setw(8) << std::setprecision(2) << (baselineMs / ms) << "x\n";
+	} // end of report
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		int64_t rows = argc > 1 ? std::stoll(argv[1]) : 200000;
+		std::string dbPath = argc > 2 ? argv[2] : "bulk_insert_bench.db";
+
+		std::cout << "=== Bulk insert benchmark: " << rows << " rows, 2 secondary indexes ===\n\n";
+
+		double prepared = timeRun(dbPath, rows, [](sqlite_flux::InsertBuilder& builder, int64_t count) {
+			auto batch = builder.Prepare(kColumns);
+			std::vector<sqlite_flux::ColumnValue> row(kColumns.size());
+			for (int64_t i = 0; i < count; ++i)
+			{
+				fillRow(row, i);
+				batch.Values(row).ExecuteBatch();
+			} // end of for
+			return batch.Finalize();
+			});
+
+		auto bulkRun = [](const sqlite_flux::BulkInsertOptions& options) {
+			return [options](sqlite_flux::InsertBuilder& builder, int64_t count) {
+				auto bulk = builder.PrepareBulk(kColumns, options);
+				std::vector<sqlite_flux::ColumnValue> row(kColumns.size());
+				for (int64_t i = 0; i < count; ++i)
+				{
+					fillRow(row, i);
+					bulk.Add(row);
+				} // end of for
+				return bulk.Finalize();
+				};
+			};
+
+		sqlite_flux::BulkInsertOptions defaults;
+		double bulk = timeRun(dbPath, rows, bulkRun(defaults));
+
+		sqlite_flux::BulkInsertOptions fast;
+		fast.fastPragmas = true;
+		fast.deferIndexes = true;
+		fast.rowsPerTransaction = 0;
+		double bulkFast = timeRun(dbPath, rows, bulkRun(fast));
+
+		report("PreparedInsert (row at a time)", rows, prepared, prepared);
+		report("BulkInsert (multi-row VALUES)", rows, bulk, prepared);
+		report("BulkInsert + pragmas + deferred idx", rows, bulkFast, prepared);
+
+		std::remove(dbPath.c_str());
+		std::remove((dbPath + "-wal").c_str());
+		std::remove((dbPath + "-shm").c_str());
+		return 0;
+	} // end of try
+	catch (const std::exception& e)
+	{
+		std::cerr << "Benchmark failed: " << e.what() << "\n";
+		return 1;
+	} // end of catch
+} // end of main
\ No newline at end of file
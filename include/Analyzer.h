@@ -2,22 +2,63 @@
 #pragma once
 
 #include "TableTypes.h"
+#include "ResultTable.h"
+#include "ArenaResultTable.h"
+#include "ConnectionOptions.h"
+#include "SchemaSnapshot.h"
+#include "BlobStream.h"
+#include "RowView.h"
+#include <array>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <optional>
+#include <span>
+#include <cstddef>
+#include <cstdint>
 
 // Forward declaration to avoid including sqlite3.h in header
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace sqlite_flux
 {
 
+	class Cursor;  // Defined in Cursor.h
+	class ResultCache;  // Defined in ResultCache.h
+
+	// Prepared statement cache counters (snapshot)
+	struct StatementCacheStats
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t evictions = 0;
+		size_t size = 0;
+		size_t capacity = 0;
+	}; // end of struct StatementCacheStats
+
+	// Outcome of a WAL checkpoint. Frame counts are -1 outside WAL mode.
+	struct CheckpointResult
+	{
+		bool success = false;
+		bool busy = false;             // Restart/Truncate gave up waiting (the copy may still be partial)
+		int logFrames = 0;             // Frames in the WAL
+		int checkpointedFrames = 0;    // Of those, frames now copied into the database
+		std::string error;
+
+		explicit operator bool() const { return success; }
+	}; // end of struct CheckpointResult
+
 	class Analyzer
 	{
 	public:
 		// Constructor with default database path
 		explicit Analyzer(const std::string& dbPath);
 
+		// Constructor with explicit open options (read-only, exclusive use, ...)
+		Analyzer(const std::string& dbPath, const ConnectionOptions& options);
+
 		// Destructor
 		~Analyzer();
 
@@ -27,10 +68,14 @@ namespace sqlite_flux
 		Analyzer(Analyzer&&) noexcept;
 		Analyzer& operator=(Analyzer&&) noexcept;
 
-		// Open/close database
+		// Open/close database (not safe to call concurrently with other operations)
 		bool open(const std::string& dbPath);
+		bool open(const std::string& dbPath, const ConnectionOptions& options);
 		void close();
-		bool isOpen() const;
+		bool isOpen() const;  // lock-free
+
+		// Options the connection was opened with
+		const ConnectionOptions& getOptions() const;
 
 		// Table discovery
 		std::vector<std::string> getTableNames() const;
@@ -39,6 +84,59 @@ namespace sqlite_flux
 
 		// Query operations (thread-safe)
 		ResultSet query(const std::string& sql) const;
+
+		// Parameterized query: params are bound positionally to ? placeholders
+		ResultSet query(const std::string& sql, const std::vector<ColumnValue>& params) const;
+
+		// First column of the first row, stepped once with no Row built; nullopt if
+		// the query returns no row or fails (see getLastError())
+		std::optional<ColumnValue> queryScalar(const std::string& sql, const std::vector<ColumnValue>& params = {}) const;
+
+		// Positional query: column names stored once, cells in one flat vector
+		ResultTable queryTable(const std::string& sql, const std::vector<ColumnValue>& params = {}) const;
+
+		// Positional query decoded into one arena from this connection's pool:
+		// no allocation per TEXT/BLOB cell, one release when the table goes
+		ArenaResultTable queryArena(const std::string& sql, const std::vector<ColumnValue>& params = {}) const;
+
+		// Fixed-size parameter lists (e.g. from FixedQuery): the SQL is only viewed
+		// and the values stay on the caller's stack, so nothing is allocated before
+		// the cached statement runs
+		template<size_t N>
+		ResultSet query(std::string_view sql, const std::array<ColumnValue, N>& params) const { return queryImpl(sql, params); }
+
+		template<size_t N>
+		std::optional<ColumnValue> queryScalar(std::string_view sql, const std::array<ColumnValue, N>& params) const
+		{
+			return queryScalarImpl(sql, params);
+		} // end of queryScalar
+
+		template<size_t N>
+		ResultTable queryTable(std::string_view sql, const std::array<ColumnValue, N>& params) const { return queryTableImpl(sql, params); }
+
+		template<size_t N>
+		ArenaResultTable queryArena(std::string_view sql, const std::array<ColumnValue, N>& params) const { return queryArenaImpl(sql, params); }
+
+		// Streaming query: rows are produced lazily by the returned Cursor (include Cursor.h)
+		// An invalid Cursor is returned on prepare/bind errors (see getLastError())
+		Cursor stream(const std::string& sql, const std::vector<ColumnValue>& params = {}) const;
+
+		// Run a read through the statement cache, calling onRow(const RowView&) for
+		// each row; the view is only valid during the call. onRow runs under the
+		// connection lock and must not use this Analyzer. False on prepare, bind or
+		// step errors, or if the result has fewer than minColumns columns (see
+		// getLastError()).
+		template<typename F>
+		bool forEachRow(std::string_view sql, std::span<const ColumnValue> params, F&& onRow,
+			size_t minColumns = 0) const;
+
+		// Incremental I/O on the BLOB in column_ of row rowid, without loading it
+		// whole; an invalid Blob is returned on error (see getLastError()). Blob
+		// writes bypass the update hook, so a ReadWrite Blob drops cached results
+		// for tableName itself after each write.
+		Blob openBlob(const std::string& tableName, const std::string& column_, int64_t rowid,
+			BlobMode mode = BlobMode::Read) const;
+
 		ResultSet selectAll(const std::string& tableName) const;
 		ResultSet selectWhere(const std::string& tableName,
 			const std::string& whereClause) const;
@@ -46,30 +144,152 @@ namespace sqlite_flux
 		// Execute operations (INSERT, UPDATE, DELETE) - thread-safe
 		bool execute(const std::string& sql);
 
+		// Parameterized execute (single statement only) - thread-safe
+		bool execute(const std::string& sql, const std::vector<ColumnValue>& params);
+
+		// Execute one DML statement and capture its changes/last insert rowid under
+		// the same lock, so another thread's statement cannot interleave - thread-safe
+		ExecuteResult executeDml(const std::string& sql, const std::vector<ColumnValue>& params = {});
+
+		template<size_t N>
+		ExecuteResult executeDml(std::string_view sql, const std::array<ColumnValue, N>& params) { return executeDmlImpl(sql, params); }
+
 		// Transaction support - thread-safe
 		bool beginTransaction();
 		bool commit();
 		bool rollback();
 
-		// Get last error message
+		// True while an explicit transaction is open. SQLite rolls some failures
+		// (SQLITE_FULL, SQLITE_IOERR, ...) back to autocommit on its own.
+		bool isInTransaction() const;
+
+		// Last error raised by this Analyzer on the calling thread (lock-free)
 		std::string getLastError() const;
 
 		// Get row count for a table
 		std::optional<int64_t> getRowCount(const std::string& tableName) const;
 
 		// Schema caching - thread-safe
+		// The cache is one immutable SchemaSnapshot, re-read whenever PRAGMA
+		// schema_version has moved on (an ALTER/CREATE/DROP on any connection)
 		void cacheAllSchemas();
 		bool isSchemaCached() const;
-		void clearSchemaCache();
+		void clearSchemaCache();  // Affects every connection sharing the schema
+
+		// Cached schema as is, without checking schema_version
 		std::optional<TableSchema> getCachedSchema(const std::string& tableName) const;
 
+		// Current snapshot (refreshed first if stale); null if the database is not open
+		std::shared_ptr<const SchemaSnapshot> getSchemaSnapshot() const;
+
+		// One table of the current snapshot (keeps the snapshot alive); null if absent
+		std::shared_ptr<const TableDescriptor> getTableDescriptor(const std::string& tableName) const;
+
+		// Share one snapshot between connections to the same file, e.g. a pool's.
+		// Call before the Analyzer is used from other threads.
+		void shareSchema(std::shared_ptr<SharedSchema> schema);
+		std::shared_ptr<SharedSchema> getSharedSchema() const;
+
 		// WAL mode configuration for web applications
 		bool enableWALMode();
 		bool isWALMode() const;
 
+		// Copy WAL frames back into the database file (sqlite3_wal_checkpoint_v2)
+		// - thread-safe. Restart and Truncate wait up to the busy timeout.
+		CheckpointResult checkpoint(CheckpointMode mode = CheckpointMode::Passive);
+
+		// Start a read transaction on other at the version this connection is
+		// reading (sqlite3_snapshot_get/open) - thread-safe. Needs an open read
+		// transaction here, WAL mode, and SQLITE_ENABLE_SNAPSHOT in both this
+		// library's and SQLite's build; otherwise false, other stays in autocommit.
+		bool shareReadSnapshot(Analyzer& other) const;
+
+		// Prepared statement cache (LRU keyed by SQL text) - thread-safe
+		// query() and execute() reuse cached statements instead of re-preparing
+		void setStatementCacheCapacity(size_t capacity);
+		size_t getStatementCacheCapacity() const;
+		StatementCacheStats getStatementCacheStats() const;
+		void clearStatementCache();
+
+		// Prepare statements ahead of time so the first request hits the cache
+		// Returns false if any statement failed to prepare
+		bool warmStatementCache(const std::vector<std::string>& sqls);
+
+		// Prepare a standalone statement owned by the caller (not cached)
+		// Caller must release it with sqlite3_finalize(); returns nullptr on error
+		sqlite3_stmt* prepareStatement(const std::string& sql);
+
+		// Bind params to a caller-owned statement, step it to completion and reset it
+		// for the next use - thread-safe
+		ExecuteResult executePrepared(sqlite3_stmt* stmt, std::span<const ColumnValue> params);
+
+		// Answer query() from cache (null detaches it). Read-only statements run
+		// outside a transaction are cached; writes on this connection invalidate
+		// the tables they touch once committed. Share one cache between connections
+		// to the same file so each sees the others' writes. Call before the
+		// Analyzer is used from other threads; clears the statement cache.
+		void setResultCache(std::shared_ptr<ResultCache> cache);
+		std::shared_ptr<ResultCache> getResultCache() const;
+
+		// Drop cached results that read tableName (deferred to the end of an open
+		// transaction); for writes SQLite's update hook misses, e.g. WITHOUT ROWID
+		// tables or DELETE without WHERE
+		void invalidateResultCache(const std::string& tableName);
+
+		// Maximum number of ? parameters a single statement may use on this connection
+		int getVariableLimit() const;
+
+		// Default number of cached statements per connection
+		static constexpr size_t DefaultStatementCacheCapacity = 64;
+
 	private:
+		// Shared by the std::vector and std::array overloads
+		ResultSet queryImpl(std::string_view sql, std::span<const ColumnValue> params) const;
+		std::optional<ColumnValue> queryScalarImpl(std::string_view sql, std::span<const ColumnValue> params) const;
+		ResultTable queryTableImpl(std::string_view sql, std::span<const ColumnValue> params) const;
+		ArenaResultTable queryArenaImpl(std::string_view sql, std::span<const ColumnValue> params) const;
+		ExecuteResult executeDmlImpl(std::string_view sql, std::span<const ColumnValue> params);
+
+		// forEachRow's statement, held under lock from beginRows() to endRows()
+		bool beginRows(std::string_view sql, std::span<const ColumnValue> params, size_t minColumns,
+			std::unique_lock<std::mutex>& lock, RowView& row) const;
+		bool nextRow() const;
+		bool endRows() const;
+
 		struct Impl;
 		std::unique_ptr<Impl> pImpl_;
 	};
 
+	// ============================================================================
+	// Template implementation for Analyzer::forEachRow
+	// ============================================================================
+
+	template<typename F>
+	bool Analyzer::forEachRow(std::string_view sql, std::span<const ColumnValue> params, F&& onRow,
+		size_t minColumns) const
+	{
+		std::unique_lock<std::mutex> lock;
+		RowView row;
+		if (!beginRows(sql, params, minColumns, lock, row))
+		{
+			return false;
+		} // end of if
+
+		// Only stepping leaves the library; onRow is inlined into the loop
+		try
+		{
+			while (nextRow())
+			{
+				onRow(static_cast<const RowView&>(row));
+			} // end of while
+		} // end of try
+		catch (...)
+		{
+			endRows();
+			throw;
+		} // end of catch
+
+		return endRows();
+	} // end of forEachRow
+
 } // namespace sqlite_flux
\ No newline at end of file
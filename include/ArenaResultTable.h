@@ -0,0 +1,199 @@
+// include/ArenaResultTable.h
+#pragma once
+
+#include "ResultArena.h"
+#include "ResultTable.h"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace sqlite_flux
+{
+
+	// A cell whose TEXT/BLOB bytes live in the result's arena
+	using ArenaValue = std::variant<std::monostate,  // NULL
+		int64_t,                                     // INTEGER
+		double,                                      // REAL
+		std::string_view,                            // TEXT
+		std::span<const uint8_t>>;                   // BLOB
+
+	// Owning copy of an arena cell
+	ColumnValue toColumnValue(const ArenaValue& value_);
+
+	// ============================================================================
+	// ArenaResultTable - ResultTable whose cells and bytes live in one arena
+	// ============================================================================
+	//
+	// Decoding allocates from a ResultArena instead of once per TEXT/BLOB cell,
+	// and destroying the last copy of the table frees everything in one go (the
+	// arena goes back to its connection's pool for the next query). Views handed
+	// out by cells stay valid while any copy of the table is alive. Copies share
+	// the same immutable storage, so they are cheap and safe to read from many
+	// threads.
+
+	class ArenaResultTable
+	{
+	public:
+		// Lightweight view of one row; valid while the table is alive
+		class RowRef
+		{
+		public:
+			RowRef(const ArenaResultTable* table, size_t row) : table_(table), row_(row) {}
+
+			// Positional access (no bounds check)
+			const ArenaValue& operator[](size_t col) const { return table_->cell(row_, col); }
+
+			// Name access (throws std::out_of_range for unknown columns)
+			const ArenaValue& operator[](const std::string& column_) const { return table_->at(row_, column_); }
+
+			// T is one of ArenaValue's alternatives (or std::string, copied out of
+			// TEXT); std::nullopt on NULL/type mismatch
+			template<typename T>
+			std::optional<T> get(size_t col) const;
+
+			template<typename T>
+			std::optional<T> get(const std::string& column_) const;
+
+			size_t size() const { return table_->columnCount(); }
+			size_t index() const { return row_; }
+
+			// Materialize as an owning, name-keyed Row
+			Row toRow() const;
+
+		private:
+			const ArenaResultTable* table_;
+			size_t row_;
+		}; // end of class RowRef
+
+		class const_iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = RowRef;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = RowRef;
+
+			const_iterator() = default;
+			const_iterator(const ArenaResultTable* table, size_t row) : table_(table), row_(row) {}
+
+			RowRef operator*() const { return RowRef(table_, row_); }
+			const_iterator& operator++() { ++row_; return *this; }
+			const_iterator operator++(int) { auto copy = *this; ++row_; return copy; }
+			bool operator==(const const_iterator& other) const { return row_ == other.row_; }
+			bool operator!=(const const_iterator& other) const { return row_ != other.row_; }
+
+		private:
+			const ArenaResultTable* table_ = nullptr;
+			size_t row_ = 0;
+		}; // end of class const_iterator
+
+		// Filled by the code decoding a result; frozen once handed to the table
+		class Builder
+		{
+		public:
+			Builder(std::shared_ptr<const ResultHeader> header, std::shared_ptr<ResultArena> arena);
+
+			void appendNull();
+			void append(int64_t value_);
+			void append(double value_);
+			void appendText(const char* data, size_t size);  // Copied into the arena
+			void appendBlob(const void* data, size_t size);  // Copied into the arena
+
+			ArenaResultTable finish() &&;
+
+		private:
+			std::shared_ptr<const ResultHeader> header_;
+			std::shared_ptr<ResultArena> arena_;
+			std::pmr::vector<ArenaValue> cells_;
+		}; // end of class Builder
+
+		ArenaResultTable() = default;
+
+		// Shape
+		size_t size() const { return rowCount(); }
+		size_t rowCount() const;
+		size_t columnCount() const { return header_ ? header_->names.size() : 0; }
+		bool empty() const { return !storage_ || storage_->cells.empty(); }
+
+		// Column metadata
+		const std::vector<std::string>& columnNames() const;
+		std::optional<size_t> columnIndex(const std::string& column_) const;
+		const std::shared_ptr<const ResultHeader>& header() const { return header_; }
+
+		// Cell access
+		const ArenaValue& cell(size_t row, size_t col) const { return storage_->cells[row * columnCount() + col]; }
+		const ArenaValue& at(size_t row, size_t col) const;                    // bounds-checked
+		const ArenaValue& at(size_t row, const std::string& column_) const;    // bounds-checked
+
+		RowRef operator[](size_t row) const { return RowRef(this, row); }
+
+		const_iterator begin() const { return const_iterator(this, 0); }
+		const_iterator end() const { return const_iterator(this, rowCount()); }
+
+		// Bytes the result took from its arena (0 for an empty table)
+		size_t arenaBytes() const;
+
+		// Owning copies, for results that must outlive the arena's reuse
+		ResultTable toResultTable() const;
+		ResultSet toResultSet() const;
+
+	private:
+		// Cells are destroyed before the arena they were allocated from
+		struct Storage
+		{
+			std::shared_ptr<ResultArena> arena;
+			std::pmr::vector<ArenaValue> cells;
+		}; // end of struct Storage
+
+		std::shared_ptr<const ResultHeader> header_;
+		std::shared_ptr<const Storage> storage_;
+	}; // end of class ArenaResultTable
+
+	// ============================================================================
+	// Template implementations
+	// ============================================================================
+
+	template<typename T>
+	std::optional<T> ArenaResultTable::RowRef::get(size_t col) const
+	{
+		const ArenaValue& value_ = (*this)[col];
+		if constexpr (std::is_same_v<T, std::string>)
+		{
+			if (auto* text = std::get_if<std::string_view>(&value_))
+			{
+				return std::string(*text);
+			} // end of if
+		} // end of if constexpr
+		else if (auto* val = std::get_if<T>(&value_))
+		{
+			return *val;
+		} // end of else if
+		return std::nullopt;
+	} // end of get
+
+	template<typename T>
+	std::optional<T> ArenaResultTable::RowRef::get(const std::string& column_) const
+	{
+		auto col = table_->columnIndex(column_);
+		if (!col)
+		{
+			return std::nullopt;
+		} // end of if
+		return get<T>(*col);
+	} // end of get
+
+	// getValue() overload so code written against Row works with RowRef
+	template<typename T>
+	std::optional<T> getValue(const ArenaResultTable::RowRef& row, const std::string& key)
+	{
+		return row.get<T>(key);
+	} // end of getValue
+
+} // namespace sqlite_flux
@@ -3,50 +3,199 @@
 
 #include "ConnectionPool.h"
 #include "QueryBuilder.h"
+#include "SmallTask.h"
+#include "WriteBatcher.h"
 #include <coroutine>
 #include <future>
 #include <functional>
 #include <exception>
 #include <thread>
 #include <vector>
-#include <queue>
+#include <deque>
+#include <stdexcept>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <optional>
+#include <type_traits>
 
 namespace sqlite_flux
 {
 
+	namespace detail
+	{
+		// ========================================================================
+		// TaskPromiseBase - Completion handshake shared by Task<T> and Task<void>
+		// ========================================================================
+		// continuation_ is nullptr while the coroutine runs unawaited, the address
+		// of the awaiting coroutine once someone co_awaits it, and the promise's own
+		// address once it has finished. Whoever gets there second resumes the
+		// awaiter, so completion on a worker and co_await on the caller can race.
+
+		struct TaskPromiseBase
+		{
+			std::exception_ptr exception_;
+			std::atomic<void*> continuation_{ nullptr };
+
+			bool isDone() const noexcept
+			{
+				return continuation_.load(std::memory_order_acquire) == static_cast<const void*>(this);
+			} // end of isDone
+
+			// Returns false if the task already finished (awaiter must not suspend)
+			bool setContinuation(std::coroutine_handle<> awaiting) noexcept
+			{
+				void* expected = nullptr;
+				return continuation_.compare_exchange_strong(expected, awaiting.address(),
+					std::memory_order_acq_rel, std::memory_order_acquire);
+			} // end of setContinuation
+
+			struct FinalAwaiter
+			{
+				bool await_ready() const noexcept { return false; }
+
+				template<typename Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finished) noexcept
+				{
+					TaskPromiseBase& promise = finished.promise();
+					void* awaiting = promise.continuation_.exchange(
+						static_cast<void*>(&promise), std::memory_order_acq_rel);
+
+					// Symmetric transfer straight into the awaiting coroutine
+					return awaiting ? std::coroutine_handle<>::from_address(awaiting) : std::noop_coroutine();
+				} // end of await_suspend
+
+				void await_resume() const noexcept {}
+			}; // end of struct FinalAwaiter
+
+			// Eager start: the body runs until its first real suspension point
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			FinalAwaiter final_suspend() noexcept { return {}; }
+
+			void unhandled_exception() noexcept
+			{
+				exception_ = std::current_exception();
+			} // end of unhandled_exception
+		}; // end of struct TaskPromiseBase
+
+		// Waits for completion only (no result, no rethrow)
+		struct CompletionAwaiter
+		{
+			TaskPromiseBase& promise;
+
+			bool await_ready() const noexcept { return promise.isDone(); }
+			bool await_suspend(std::coroutine_handle<> awaiting) noexcept { return promise.setContinuation(awaiting); }
+			void await_resume() const noexcept {}
+		}; // end of struct CompletionAwaiter
+
+		// ========================================================================
+		// Blocking wait - lets plain threads call Task::get()
+		// ========================================================================
+
+		struct BlockingWaitState
+		{
+			std::mutex mutex;
+			std::condition_variable cv;
+			bool done = false;
+		}; // end of struct BlockingWaitState
+
+		class BlockingWaitTask
+		{
+		public:
+			struct promise_type
+			{
+				BlockingWaitState* state = nullptr;
+
+				BlockingWaitTask get_return_object()
+				{
+					return BlockingWaitTask{ std::coroutine_handle<promise_type>::from_promise(*this) };
+				} // end of get_return_object
+
+				std::suspend_always initial_suspend() noexcept { return {}; }
+
+				auto final_suspend() noexcept
+				{
+					struct Notify
+					{
+						bool await_ready() const noexcept { return false; }
+
+						void await_suspend(std::coroutine_handle<promise_type> self) noexcept
+						{
+							// Signal under the lock: the waiter cannot return (and destroy
+							// the state) until we have released it
+							BlockingWaitState* state = self.promise().state;
+							std::lock_guard lock(state->mutex);
+							state->done = true;
+							state->cv.notify_all();
+						} // end of await_suspend
+
+						void await_resume() const noexcept {}
+					}; // end of struct Notify
+					return Notify{};
+				} // end of final_suspend
+
+				void return_void() noexcept {}
+				void unhandled_exception() noexcept { std::terminate(); }
+			}; // end of struct promise_type
+
+			explicit BlockingWaitTask(std::coroutine_handle<promise_type> h) : handle_(h) {}
+			~BlockingWaitTask() { handle_.destroy(); }
+
+			BlockingWaitTask(const BlockingWaitTask&) = delete;
+			BlockingWaitTask& operator=(const BlockingWaitTask&) = delete;
+
+			void start(BlockingWaitState& state)
+			{
+				handle_.promise().state = &state;
+				handle_.resume();
+			} // end of start
+
+		private:
+			std::coroutine_handle<promise_type> handle_;
+		}; // end of class BlockingWaitTask
+
+		inline BlockingWaitTask makeBlockingWait(TaskPromiseBase& promise)
+		{
+			co_await CompletionAwaiter{ promise };
+		} // end of makeBlockingWait
+
+		inline void blockUntilDone(TaskPromiseBase& promise)
+		{
+			if (promise.isDone()) return;
+
+			BlockingWaitState state;
+			auto waiter = makeBlockingWait(promise);
+			waiter.start(state);
+
+			std::unique_lock lock(state.mutex);
+			state.cv.wait(lock, [&state] { return state.done; });
+		} // end of blockUntilDone
+	} // namespace detail
+
 	// ============================================================================
 	// Task<T> - Coroutine return type for async operations
 	// ============================================================================
+	// Starts eagerly and completes on whichever thread finishes the work. A Task
+	// can be co_awaited once (the awaiter resumes where the task completed) or
+	// waited on with get(). Destroying an unfinished Task waits for it.
 
 	template<typename T>
 	class Task
 	{
 	public:
-		struct promise_type
+		struct promise_type : detail::TaskPromiseBase
 		{
-			T value_;
-			std::exception_ptr exception_;
+			std::optional<T> value_;
 
 			Task get_return_object()
 			{
 				return Task{ std::coroutine_handle<promise_type>::from_promise(*this) };
 			} // end of get_return_object
 
-			std::suspend_never initial_suspend() noexcept { return {}; }
-			std::suspend_always final_suspend() noexcept { return {}; }
-
-			void return_value(T value_)
+			void return_value(T value)
 			{
-				value_ = std::move(value_);
+				value_.emplace(std::move(value));
 			} // end of return_value
-
-			void unhandled_exception()
-			{
-				exception_ = std::current_exception();
-			} // end of unhandled_exception
 		}; // end of struct promise_type
 
 		using handle_type = std::coroutine_handle<promise_type>;
@@ -55,10 +204,7 @@ namespace sqlite_flux
 
 		~Task()
 		{
-			if (handle_)
-			{
-				handle_.destroy();
-			} // end of if
+			reset();
 		} // end of destructor
 
 		// Disable copy, enable move
@@ -74,10 +220,7 @@ namespace sqlite_flux
 		{
 			if (this != &other)
 			{
-				if (handle_)
-				{
-					handle_.destroy();
-				} // end of if
+				reset();
 				handle_ = other.handle_;
 				other.handle_ = nullptr;
 			} // end of if
@@ -87,12 +230,13 @@ namespace sqlite_flux
 		// Awaiter interface for co_await support
 		bool await_ready() const noexcept
 		{
-			return handle_ && handle_.done();
+			return !handle_ || handle_.promise().isDone();
 		} // end of await_ready
 
-		void await_suspend(std::coroutine_handle<> awaiting) noexcept
+		bool await_suspend(std::coroutine_handle<> awaiting) noexcept
 		{
-			// Task executes immediately, so just resume the awaiting coroutine
+			// false: finished meanwhile, so continue without suspending
+			return handle_.promise().setContinuation(awaiting);
 		} // end of await_suspend
 
 		T await_resume()
@@ -107,22 +251,36 @@ namespace sqlite_flux
 				std::rethrow_exception(handle_.promise().exception_);
 			} // end of if
 
-			return std::move(handle_.promise().value_);
+			return std::move(*handle_.promise().value_);
 		} // end of await_resume
 
 		// Get the result (blocks until ready)
 		T get()
 		{
+			if (handle_)
+			{
+				detail::blockUntilDone(handle_.promise());
+			} // end of if
 			return await_resume();
 		} // end of get
 
 		// Check if task is ready
 		bool ready() const noexcept
 		{
-			return await_ready();
+			return handle_ && handle_.promise().isDone();
 		} // end of ready
 
 	private:
+		void reset() noexcept
+		{
+			if (handle_)
+			{
+				detail::blockUntilDone(handle_.promise());
+				handle_.destroy();
+				handle_ = nullptr;
+			} // end of if
+		} // end of reset
+
 		handle_type handle_;
 	}; // end of class Task
 
@@ -134,24 +292,14 @@ namespace sqlite_flux
 	class Task<void>
 	{
 	public:
-		struct promise_type
+		struct promise_type : detail::TaskPromiseBase
 		{
-			std::exception_ptr exception_;
-
 			Task get_return_object()
 			{
 				return Task{ std::coroutine_handle<promise_type>::from_promise(*this) };
 			} // end of get_return_object
 
-			std::suspend_never initial_suspend() noexcept { return {}; }
-			std::suspend_always final_suspend() noexcept { return {}; }
-
 			void return_void() noexcept {}
-
-			void unhandled_exception()
-			{
-				exception_ = std::current_exception();
-			} // end of unhandled_exception
 		}; // end of struct promise_type
 
 		using handle_type = std::coroutine_handle<promise_type>;
@@ -160,10 +308,7 @@ namespace sqlite_flux
 
 		~Task()
 		{
-			if (handle_)
-			{
-				handle_.destroy();
-			} // end of if
+			reset();
 		} // end of destructor
 
 		// Disable copy, enable move
@@ -179,10 +324,7 @@ namespace sqlite_flux
 		{
 			if (this != &other)
 			{
-				if (handle_)
-				{
-					handle_.destroy();
-				} // end of if
+				reset();
 				handle_ = other.handle_;
 				other.handle_ = nullptr;
 			} // end of if
@@ -192,12 +334,12 @@ namespace sqlite_flux
 		// Awaiter interface for co_await support
 		bool await_ready() const noexcept
 		{
-			return handle_ && handle_.done();
+			return !handle_ || handle_.promise().isDone();
 		} // end of await_ready
 
-		void await_suspend(std::coroutine_handle<> awaiting) noexcept
+		bool await_suspend(std::coroutine_handle<> awaiting) noexcept
 		{
-			// Task executes immediately, so just resume the awaiting coroutine
+			return handle_.promise().setContinuation(awaiting);
 		} // end of await_suspend
 
 		void await_resume()
@@ -215,26 +357,151 @@ namespace sqlite_flux
 
 		void get()
 		{
+			if (handle_)
+			{
+				detail::blockUntilDone(handle_.promise());
+			} // end of if
 			await_resume();
 		} // end of get
 
 		bool ready() const noexcept
 		{
-			return await_ready();
+			return handle_ && handle_.promise().isDone();
 		} // end of ready
 
 	private:
+		void reset() noexcept
+		{
+			if (handle_)
+			{
+				detail::blockUntilDone(handle_.promise());
+				handle_.destroy();
+				handle_ = nullptr;
+			} // end of if
+		} // end of reset
+
 		handle_type handle_;
 	}; // end of class Task<void>
 
 	// ============================================================================
-	// ThreadPool - Worker thread pool for async operations
+	// when_all - Await a batch of already-running tasks
 	// ============================================================================
+	// Tasks start eagerly, so they are all in flight before the first co_await.
+	// Every task is awaited even if one fails; the first exception is rethrown.
+
+	template<typename T>
+	Task<std::vector<T>> when_all(std::vector<Task<T>> tasks)
+	{
+		std::vector<T> results;
+		results.reserve(tasks.size());
+		std::exception_ptr firstError;
 
+		for (auto& task : tasks)
+		{
+			try
+			{
+				results.push_back(co_await task);
+			} // end of try
+			catch (...)
+			{
+				if (!firstError) firstError = std::current_exception();
+			} // end of catch
+		} // end of for
+
+		if (firstError)
+		{
+			std::rethrow_exception(firstError);
+		} // end of if
+
+		co_return results;
+	} // end of when_all
+
+	inline Task<void> when_all(std::vector<Task<void>> tasks)
+	{
+		std::exception_ptr firstError;
+
+		for (auto& task : tasks)
+		{
+			try
+			{
+				co_await task;
+			} // end of try
+			catch (...)
+			{
+				if (!firstError) firstError = std::current_exception();
+			} // end of catch
+		} // end of for
+
+		if (firstError)
+		{
+			std::rethrow_exception(firstError);
+		} // end of if
+	} // end of when_all
+
+	// Runs a continuation somewhere else (an event loop, a UI thread, ...)
+	using ResumeExecutor = std::function<void(std::function<void()>)>;
+
+	// Awaitable that resumes the awaiting coroutine through executor
+	inline auto resumeOn(const ResumeExecutor& executor)
+	{
+		struct ResumeOnAwaiter
+		{
+			const ResumeExecutor& executor;
+
+			bool await_ready() const noexcept { return !executor; }
+
+			void await_suspend(std::coroutine_handle<> awaiting)
+			{
+				executor([awaiting] { awaiting.resume(); });
+			} // end of await_suspend
+
+			void await_resume() const noexcept {}
+		}; // end of struct ResumeOnAwaiter
+		return ResumeOnAwaiter{ executor };
+	} // end of resumeOn
+
+	// ============================================================================
+	// ThreadPool - Work-stealing worker pool for async operations
+	// ============================================================================
+
+	// What post()/enqueue() do when queueCapacity tasks are already waiting
+	enum class OverflowPolicy
+	{
+		Block,  // Wait for space (backpressure on the submitter)
+		Reject  // Throw ThreadPoolFullError
+	}; // end of enum class OverflowPolicy
+
+	struct ThreadPoolOptions
+	{
+		size_t numThreads = std::thread::hardware_concurrency();
+
+		// Maximum queued (not yet running) tasks; 0 = unbounded
+		size_t queueCapacity = 65536;
+		OverflowPolicy overflowPolicy = OverflowPolicy::Block;
+
+		// Pin worker i to core i % hardware_concurrency (Linux and Windows only)
+		bool pinToCores = false;
+
+		// Receives queue and run time of every task. Null (the default) skips the
+		// timing; with a sink attached each submission allocates its wrapper.
+		std::shared_ptr<MetricsSink> metrics = nullptr;
+	}; // end of struct ThreadPoolOptions
+
+	class ThreadPoolFullError : public std::runtime_error
+	{
+	public:
+		ThreadPoolFullError() : std::runtime_error("ThreadPool queue is full") {}
+	}; // end of class ThreadPoolFullError
+
+	// Each worker owns a deque: it pushes and pops its own work LIFO (cache-warm
+	// continuations) and steals FIFO from the others when it runs dry. Outside
+	// submissions are spread round-robin. Submissions from the pool's own workers
+	// are never blocked or rejected, so a continuation cannot deadlock its pool.
 	class ThreadPool
 	{
 	public:
 		explicit ThreadPool(size_t numThreads = std::thread::hardware_concurrency());
+		explicit ThreadPool(const ThreadPoolOptions& options);
 		~ThreadPool();
 
 		// Disable copy and move
@@ -247,23 +514,147 @@ namespace sqlite_flux
 		template<typename F, typename... Args>
 		auto enqueue(F&& f, Args&&... args) -> std::future<typename std::invoke_result<F, Args...>::type>;
 
+		// Enqueue a job without a future (applies the overflow policy)
+		void post(SmallTask job);
+
+		// Enqueue unless the queue is full; never blocks
+		bool tryPost(SmallTask job);
+
+		// Awaitable that resumes the awaiting coroutine on a worker thread
+		auto schedule()
+		{
+			struct ScheduleAwaiter
+			{
+				ThreadPool& pool;
+
+				bool await_ready() const noexcept { return false; }
+
+				void await_suspend(std::coroutine_handle<> awaiting)
+				{
+					pool.post([awaiting] { awaiting.resume(); });
+				} // end of await_suspend
+
+				void await_resume() const noexcept {}
+			}; // end of struct ScheduleAwaiter
+			return ScheduleAwaiter{ *this };
+		} // end of schedule
+
 		// Get number of worker threads
 		size_t size() const { return workers_.size(); }
 
-		// Get number of pending tasks
+		// Get number of pending tasks (lock-free)
 		size_t pendingTasks() const;
 
-	private:
-		void workerThread();
+		// Tasks a worker took from another worker's deque
+		uint64_t stolenTasks() const { return stolen_.load(std::memory_order_relaxed); }
 
+	private:
+		struct alignas(64) WorkerQueue
+		{
+			std::mutex mutex;
+			std::deque<SmallTask> tasks;
+		}; // end of struct WorkerQueue
+
+		void workerThread(size_t index);
+		bool tryTake(size_t self, SmallTask& out);
+		bool reserveSlot(bool mayWait);
+		void push(SmallTask job);
+		static void pinCurrentThread(size_t index);
+
+		ThreadPoolOptions options_;
+		std::unique_ptr<WorkerQueue[]> queues_;
 		std::vector<std::thread> workers_;
-		std::queue<std::function<void()>> tasks_;
+		std::atomic<size_t> nextQueue_{ 0 };
+
+		// pending_ counts queued tasks; idle workers sleep on sleepCv_ until it rises
+		std::atomic<size_t> pending_{ 0 };
+		std::atomic<size_t> sleeping_{ 0 };
+		std::mutex sleepMutex_;
+		std::condition_variable sleepCv_;
 
-		mutable std::mutex queueMutex_;
-		std::condition_variable condition_;
+		// Submitters blocked by OverflowPolicy::Block
+		std::atomic<size_t> blockedSubmitters_{ 0 };
+		std::mutex spaceMutex_;
+		std::condition_variable spaceCv_;
+
+		std::atomic<uint64_t> stolen_{ 0 };
 		std::atomic<bool> stop_{ false };
 	}; // end of class ThreadPool
 
+	class AsyncExecutor;
+
+	// ============================================================================
+	// AsyncTransaction - Async operations pinned to one pooled connection
+	// ============================================================================
+	// Obtained from AsyncExecutor::transaction(), which leases the writer
+	// connection and runs BEGIN IMMEDIATE. An executor has one transaction open
+	// at a time (SQLite allows one writer anyway); further transaction() calls
+	// wait, suspended rather than on a worker, until it ends. Every operation
+	// runs on that same connection, one at a time in the order they were
+	// started, so several may be in flight (e.g. under when_all). commit()/
+	// rollback() return the connection to the pool once the operations before
+	// them are done. Destroying an active transaction queues a rollback the
+	// same way; the handle may go before its operations finish.
+
+	class AsyncTransaction
+	{
+	public:
+		~AsyncTransaction();
+
+		AsyncTransaction(AsyncTransaction&& other) noexcept;
+		AsyncTransaction& operator=(AsyncTransaction&& other) noexcept;
+		AsyncTransaction(const AsyncTransaction&) = delete;
+		AsyncTransaction& operator=(const AsyncTransaction&) = delete;
+
+		Task<ResultSet> query(const std::string& sql, std::vector<ColumnValue> params = {});
+		Task<ExecuteResult> execute(const std::string& sql, std::vector<ColumnValue> params = {});
+
+		// Both release the connection, whatever the outcome (a failed COMMIT is
+		// rolled back)
+		Task<ExecuteResult> commit();
+		Task<ExecuteResult> rollback();
+
+		// False once committed, rolled back or moved from
+		bool isActive() const { return active_; }
+
+	private:
+		friend class AsyncExecutor;
+
+		// The pinned connection and its queue of operations (defined in the .cpp);
+		// shared with queued operations so they outlive the handle
+		struct State;
+
+		AsyncTransaction(AsyncExecutor& executor, ConnectionPool::Connection connection);
+
+		// Run work(State&) on a worker once the operations before it are done
+		template<typename F>
+		static auto onConnection(std::shared_ptr<State> state, F work) -> Task<std::invoke_result_t<F&, State&>>;
+		static void submit(const std::shared_ptr<State>& state, SmallTask op);
+		static void drain(const std::shared_ptr<State>& state);
+		static void rollbackAndRelease(State& state) noexcept;
+
+		Task<ExecuteResult> finish(const char* sql);
+		void rollbackNow() noexcept;
+
+		std::shared_ptr<State> state_;
+		bool active_ = false;
+	}; // end of class AsyncTransaction
+
+	// ============================================================================
+	// GroupCommitOptions - Coalesce concurrent AsyncExecutor::write() calls
+	// ============================================================================
+	// Routes write() through a WriteBatcher: writes queue up while a batch is
+	// being written and the next batch runs up to maxBatch of them in one
+	// transaction (one fsync), each under its own savepoint. maxDelay > 0 also
+	// holds a batch back that long to let it fill.
+
+	struct GroupCommitOptions
+	{
+		bool enabled = false;
+		size_t maxBatch = 256;
+		std::chrono::microseconds maxDelay{ 0 };
+	}; // end of struct GroupCommitOptions
+
 	// ============================================================================
 	// AsyncExecutor - High-level async API for database operations
 	// ============================================================================
@@ -271,7 +662,13 @@ namespace sqlite_flux
 	class AsyncExecutor
 	{
 	public:
-		explicit AsyncExecutor(ConnectionPool& pool, size_t threadPoolSize = 4);
+		// Operations run on the executor's worker threads. Awaiting coroutines resume
+		// on the worker that finished the work, or through resumeExecutor if given
+		// (inline, if the result was already there when co_await ran).
+		explicit AsyncExecutor(ConnectionPool& pool, size_t threadPoolSize = 4,
+			ResumeExecutor resumeExecutor = {});
+		AsyncExecutor(ConnectionPool& pool, const ThreadPoolOptions& threadPoolOptions,
+			ResumeExecutor resumeExecutor = {}, const GroupCommitOptions& groupCommit = {});
 		~AsyncExecutor();
 
 		// Disable copy and move
@@ -288,7 +685,16 @@ namespace sqlite_flux
 		// Async execute operations
 		Task<bool> execute(const std::string& sql);
 
-		// Async transaction operations
+		// Single DML statement on the writer connection; coalesced with other
+		// concurrent writes into one transaction when group commit is enabled
+		Task<ExecuteResult> write(const std::string& sql, std::vector<ColumnValue> params = {});
+
+		// Begin a transaction pinned to one connection (the writer in split mode);
+		// waits without holding a worker while another of ours is open
+		Task<AsyncTransaction> transaction();
+
+		// Deprecated: each call leases whichever connection is free, so these do not
+		// form one transaction. Use transaction() instead.
 		Task<bool> beginTransaction();
 		Task<bool> commit();
 		Task<bool> rollback();
@@ -304,8 +710,33 @@ namespace sqlite_flux
 		size_t pendingOperations() const;
 
 	private:
+		friend class AsyncTransaction;
+
+
+		// Hop to a worker, run work there, then hop to resumeExecutor_ (if any)
+		template<typename F>
+		auto run(F work) -> Task<std::invoke_result_t<F&>>;
+
+		Task<ExecuteResult> groupWrite(std::string sql, std::vector<ColumnValue> params);
+		void resumeLater(std::coroutine_handle<> awaiting);
+
+		// Hand the transaction slot to the next waiting transaction() call
+		void releaseTransactionSlot();
+
 		ConnectionPool& pool_;
+
+		ResumeExecutor resumeExecutor_;  // Declared first: workers may still be inside it while they drain
+
+		// The open AsyncTransaction's slot, and the transaction() calls queued for
+		// it; before threadPool_, as a transaction still draining there releases it
+		std::mutex transactionMutex_;
+		bool transactionOpen_ = false;
+		std::deque<std::coroutine_handle<>> transactionWaiters_;
+
 		ThreadPool threadPool_;
+
+		// Destroyed first: its last completions still resume onto threadPool_
+		std::unique_ptr<WriteBatcher> writeBatcher_;
 	}; // end of class AsyncExecutor
 
 	// ============================================================================
@@ -317,25 +748,48 @@ namespace sqlite_flux
 	{
 		using return_type = typename std::invoke_result<F, Args...>::type;
 
-		auto task = std::make_shared<std::packaged_task<return_type()>>(
-			std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-		);
+		// packaged_task is move-only, which SmallTask (unlike std::function) accepts
+		std::packaged_task<return_type()> task(
+			[f = std::forward<F>(f), ... args = std::forward<Args>(args)]() mutable -> return_type {
+				return std::invoke(f, args...);
+			});
 
-		std::future<return_type> result = task->get_future();
+		std::future<return_type> result = task.get_future();
+		post([task = std::move(task)]() mutable { task(); });
+		return result;
+	} // end of enqueue
 
+	// ============================================================================
+	// Template implementation for AsyncExecutor::run
+	// ============================================================================
+
+	template<typename F>
+	auto AsyncExecutor::run(F work) -> Task<std::invoke_result_t<F&>>
+	{
+		using result_type = std::invoke_result_t<F&>;
+
+		// The caller gets the Task back here; the rest runs on a worker
+		co_await threadPool_.schedule();
+
+		std::optional<result_type> result;
+		std::exception_ptr error;
+		try
+		{
+			result.emplace(work());
+		} // end of try
+		catch (...)
 		{
-			std::lock_guard lock(queueMutex_);
+			error = std::current_exception();
+		} // end of catch
 
-			if (stop_.load(std::memory_order_acquire))
-			{
-				throw std::runtime_error("ThreadPool is stopped");
-			} // end of if
+		co_await resumeOn(resumeExecutor_);
 
-			tasks_.emplace([task]() { (*task)(); });
-		} // end of lock scope
+		if (error)
+		{
+			std::rethrow_exception(error);
+		} // end of if
 
-		condition_.notify_one();
-		return result;
-	} // end of enqueue
+		co_return std::move(*result);
+	} // end of run
 
 } // namespace sqlite_flux
\ No newline at end of file
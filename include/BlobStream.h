@@ -0,0 +1,156 @@
+// include/BlobStream.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <span>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Forward declaration to avoid including sqlite3.h in header
+struct sqlite3;
+struct sqlite3_blob;
+
+namespace sqlite_flux
+{
+
+	enum class BlobMode
+	{
+		Read,
+		ReadWrite
+	}; // end of enum class BlobMode
+
+	// ============================================================================
+	// Blob - Incremental I/O on one BLOB cell (sqlite3_blob_*)
+	// ============================================================================
+	//
+	// Reads and writes go straight to the database pages in caller-sized
+	// chunks, so a multi-MB object never has to be materialized. The size is
+	// fixed when the cell is written: preallocate with zeroblob (see
+	// InsertBuilder::ZeroBlob) and fill it in. Any other change to the row
+	// expires the handle; later I/O then fails with SQLITE_ABORT. A Blob must
+	// not outlive its Analyzer, and shares the connection's threading rules
+	// with Cursor: I/O takes the Analyzer's lock, and one Blob is for one
+	// thread at a time. Failures are reported through getLastError().
+
+	class Blob
+	{
+	public:
+		Blob() = default;
+
+		// Takes ownership of an open handle on db; dbMutex, if given, is held
+		// around all I/O on it
+		Blob(sqlite3* db, sqlite3_blob* blob, std::mutex* dbMutex = nullptr);
+
+		~Blob();
+
+		// Disable copy, enable move
+		Blob(const Blob&) = delete;
+		Blob& operator=(const Blob&) = delete;
+		Blob(Blob&& other) noexcept;
+		Blob& operator=(Blob&& other) noexcept;
+
+		// Read up to dst.size() bytes at the current position and advance
+		// Returns the bytes read: 0 at the end of the blob or on error
+		size_t read(std::span<uint8_t> dst);
+
+		// Write all of src at the current position and advance; false if it would
+		// run past size() or on error
+		bool write(std::span<const uint8_t> src);
+
+		// Positioned I/O, leaving the current position alone
+		bool readAt(size_t offset, std::span<uint8_t> dst);
+		bool writeAt(size_t offset, std::span<const uint8_t> src);
+
+		// Current position (false if offset is past size())
+		size_t tell() const { return position_; }
+		bool seek(size_t offset);
+
+		// Point the handle at the same column of another row, rewinding to 0;
+		// much cheaper than opening a new Blob. On failure the handle is expired.
+		bool reopen(int64_t rowid);
+
+		void close();
+
+		// Called with dbMutex held after every successful write, which the
+		// update hook never sees; Analyzer::openBlob drops cached results with it
+		void notifyWrites(std::function<void()> onWrite);
+
+		// State
+		bool isValid() const { return blob_ != nullptr; }
+		size_t size() const { return size_; }
+		bool eof() const { return position_ >= size_; }
+		bool hasError() const { return !lastError_.empty(); }
+		const std::string& getLastError() const { return lastError_; }
+
+	private:
+		bool fail(int rc);
+		std::unique_lock<std::mutex> lockDb() const;
+
+		sqlite3* db_ = nullptr;
+		sqlite3_blob* blob_ = nullptr;
+		std::mutex* dbMutex_ = nullptr;  // The owning Analyzer's, unless it is exclusive-use
+		std::function<void()> onWrite_;
+		size_t size_ = 0;
+		size_t position_ = 0;
+		std::string lastError_;
+	}; // end of class Blob
+
+	// ============================================================================
+	// BlobStreamBuf - std::streambuf over a Blob
+	// ============================================================================
+	//
+	// One fixed buffer is used for both directions, so memory stays constant
+	// however large the blob is. Reads past the end report EOF; writes past
+	// the end fail (the stream's badbit), since a blob cannot grow.
+
+	class BlobStreamBuf : public std::streambuf
+	{
+	public:
+		explicit BlobStreamBuf(Blob& blob, size_t bufferSize = DefaultBufferSize);
+		~BlobStreamBuf() override;
+
+		BlobStreamBuf(const BlobStreamBuf&) = delete;
+		BlobStreamBuf& operator=(const BlobStreamBuf&) = delete;
+
+		static constexpr size_t DefaultBufferSize = 64 * 1024;
+
+	protected:
+		int_type underflow() override;
+		int_type overflow(int_type ch) override;
+		int sync() override;
+		std::streamsize showmanyc() override;
+		std::streamsize xsgetn(char* s, std::streamsize count) override;    // Large reads skip the buffer
+		std::streamsize xsputn(const char* s, std::streamsize count) override;  // Large writes skip the buffer
+		pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+		pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+	private:
+		// Move the Blob back over unread buffered bytes
+		void dropReadAhead();
+
+		// Write out pending output
+		bool flushPut();
+
+		Blob& blob_;
+		std::vector<char> buffer_;
+	}; // end of class BlobStreamBuf
+
+	// ============================================================================
+	// BlobStream - iostream adapter, e.g. for copying a blob to a socket stream
+	// ============================================================================
+
+	class BlobStream : public std::iostream
+	{
+	public:
+		explicit BlobStream(Blob& blob, size_t bufferSize = BlobStreamBuf::DefaultBufferSize);
+
+	private:
+		BlobStreamBuf buf_;
+	}; // end of class BlobStream
+
+} // namespace sqlite_flux
@@ -0,0 +1,156 @@
+// include/BoundedMpmcQueue.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// BoundedMpmcQueue - Lock-free bounded multi-producer/multi-consumer queue
+	// ============================================================================
+	// Dmitry Vyukov's array queue: each cell carries a sequence number that tells
+	// producers and consumers whether it is free to write or ready to read, so
+	// push/pop are a single CAS on the shared position in the common case.
+	// Capacity is rounded up to a power of two.
+
+	template<typename T>
+	class BoundedMpmcQueue
+	{
+		static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>,
+			"BoundedMpmcQueue requires nothrow move and destruction");
+
+	public:
+		explicit BoundedMpmcQueue(size_t capacity)
+			: mask_(roundUpToPowerOfTwo(capacity) - 1)
+			, cells_(std::make_unique<Cell[]>(mask_ + 1))
+		{
+			for (size_t i = 0; i <= mask_; ++i)
+			{
+				cells_[i].sequence.store(i, std::memory_order_relaxed);
+			} // end of for
+		} // end of constructor
+
+		~BoundedMpmcQueue()
+		{
+			T discarded;
+			while (tryPop(discarded))
+			{
+			} // end of while
+		} // end of destructor
+
+		BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+		BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+		// Returns false if the queue is full
+		bool tryPush(T value)
+		{
+			size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+			Cell* cell;
+			for (;;)
+			{
+				cell = &cells_[pos & mask_];
+				size_t seq = cell->sequence.load(std::memory_order_acquire);
+				auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+				if (diff == 0)
+				{
+					if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						break;
+					} // end of if
+				} // end of if
+				else if (diff < 0)
+				{
+					return false;  // Full
+				} // end of else if
+				else
+				{
+					pos = enqueuePos_.load(std::memory_order_relaxed);
+				} // end of else
+			} // end of for
+
+			new (&cell->storage) T(std::move(value));
+			cell->sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		} // end of tryPush
+
+		// Returns false if the queue is empty
+		bool tryPop(T& out)
+		{
+			size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+			Cell* cell;
+			for (;;)
+			{
+				cell = &cells_[pos & mask_];
+				size_t seq = cell->sequence.load(std::memory_order_acquire);
+				auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+				if (diff == 0)
+				{
+					if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						break;
+					} // end of if
+				} // end of if
+				else if (diff < 0)
+				{
+					return false;  // Empty
+				} // end of else if
+				else
+				{
+					pos = dequeuePos_.load(std::memory_order_relaxed);
+				} // end of else
+			} // end of for
+
+			T* item = std::launder(reinterpret_cast<T*>(&cell->storage));
+			out = std::move(*item);
+			item->~T();
+			cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+			return true;
+		} // end of tryPop
+
+		size_t capacity() const { return mask_ + 1; }
+
+		// Approximate under concurrent use
+		size_t sizeApprox() const
+		{
+			size_t enq = enqueuePos_.load(std::memory_order_relaxed);
+			size_t deq = dequeuePos_.load(std::memory_order_relaxed);
+			return enq > deq ? enq - deq : 0;
+		} // end of sizeApprox
+
+	private:
+		struct Cell
+		{
+			std::atomic<size_t> sequence{ 0 };
+			alignas(T) unsigned char storage[sizeof(T)];
+		}; // end of struct Cell
+
+		static size_t roundUpToPowerOfTwo(size_t n)
+		{
+			if (n == 0)
+			{
+				throw std::invalid_argument("BoundedMpmcQueue capacity must be greater than 0");
+			} // end of if
+
+			size_t result = 1;
+			while (result < n) result <<= 1;
+			return result;
+		} // end of roundUpToPowerOfTwo
+
+		// Keep producer and consumer positions on separate cache lines
+		static constexpr size_t CacheLine = 64;
+
+		const size_t mask_;
+		std::unique_ptr<Cell[]> cells_;
+		alignas(CacheLine) std::atomic<size_t> enqueuePos_{ 0 };
+		alignas(CacheLine) std::atomic<size_t> dequeuePos_{ 0 };
+	}; // end of class BoundedMpmcQueue
+
+} // namespace sqlite_flux
\ No newline at end of file
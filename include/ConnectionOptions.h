@@ -0,0 +1,106 @@
+// include/ConnectionOptions.h
+#pragma once
+
+#include "ResultArena.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace sqlite_flux
+{
+
+	class MetricsSink;  // Defined in Metrics.h
+
+	// PRAGMA synchronous levels
+	enum class Synchronous
+	{
+		Off,
+		Normal,
+		Full,
+		Extra
+	}; // end of enum class Synchronous
+
+	// PRAGMA temp_store: where temporary tables and indices live
+	enum class TempStore
+	{
+		Default,  // As compiled into SQLite (normally a file)
+		File,
+		Memory
+	}; // end of enum class TempStore
+
+	// sqlite3_wal_checkpoint_v2 modes, from least to most intrusive
+	enum class CheckpointMode
+	{
+		Passive,   // Copy what it can without waiting on readers or writers
+		Full,      // Wait for writers, then copy the whole log
+		Restart,   // Full, then wait for readers so the next writer restarts the log
+		Truncate   // Restart, then truncate the -wal file to zero bytes
+	}; // end of enum class CheckpointMode
+
+	// Preset tunings, see ConnectionOptions::forProfile
+	enum class ConnectionProfile
+	{
+		Default,        // Defaults of the fields below
+		ReadHeavyMmap,  // Large read-mostly databases: pages read through mmap
+		BulkIngest,     // Write throughput over durability and memory
+		LowMemory       // Small page cache, no mmap, small result arenas
+	}; // end of enum class ConnectionProfile
+
+	// ============================================================================
+	// ConnectionOptions - How an Analyzer opens its SQLite connection
+	// ============================================================================
+	//
+	// Unset optionals leave SQLite's own default (or the database's stored
+	// setting) alone.
+
+	struct ConnectionOptions
+	{
+		// Open with SQLITE_OPEN_READONLY (otherwise READWRITE | CREATE)
+		bool readOnly = false;
+
+		// Caller guarantees the Analyzer is used by one thread at a time (e.g. a
+		// pooled connection). Opens with SQLITE_OPEN_NOMUTEX and skips the
+		// Analyzer's own connection mutex.
+		bool exclusiveUse = false;
+
+		// Extra sqlite3_open_v2 flags, e.g. SQLITE_OPEN_URI or SQLITE_OPEN_NOFOLLOW
+		int openFlags = 0;
+
+		// Switch to journal_mode=WAL on open
+		bool enableWAL = true;
+
+		// PRAGMA synchronous; unset means NORMAL with WAL, SQLite's default otherwise
+		std::optional<Synchronous> synchronous;
+
+		// busy_timeout applied on open (milliseconds)
+		int busyTimeoutMs = 5000;
+
+		// PRAGMA mmap_size: bytes of the file read through a memory map instead of
+		// copied into the page cache (0 disables, SQLite caps it at SQLITE_MAX_MMAP_SIZE)
+		std::optional<int64_t> mmapSizeBytes;
+
+		// PRAGMA cache_size, as a budget in KiB rather than pages
+		std::optional<int64_t> cacheSizeKiB;
+
+		TempStore tempStore = TempStore::Default;
+
+		// PRAGMA wal_autocheckpoint: pages in the WAL after which a commit runs a
+		// checkpoint itself (0 disables; SQLite's default is 1000)
+		std::optional<int> walAutoCheckpointPages;
+
+		// PRAGMA page_size; only takes effect on a database that is still empty
+		// (before its first table), as the file's page size is fixed after that
+		std::optional<int> pageSize;
+
+		// Receives per-statement timings, busy retries and schema cache lookups.
+		// Null (the default) skips all timing.
+		std::shared_ptr<MetricsSink> metrics = nullptr;
+
+		// Sizing of the arenas queryArena() decodes into
+		ResultArenaOptions resultArenas;
+
+		// Options preset for profile; adjust individual fields afterwards
+		static ConnectionOptions forProfile(ConnectionProfile profile);
+	}; // end of struct ConnectionOptions
+
+} // namespace sqlite_flux
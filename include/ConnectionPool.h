@@ -2,25 +2,129 @@
 #pragma once
 
 #include "Analyzer.h"
-#include <queue>
+#include "BoundedMpmcQueue.h"
+#include "Metrics.h"
+#include "ResultCache.h"
+#include <deque>
 #include <mutex>
 #include <condition_variable>
 #include <memory>
 #include <chrono>
 #include <optional>
 #include <atomic>
+#include <string>
+#include <vector>
+#include <thread>
+#include <unordered_map>
 
 namespace sqlite_flux
 {
 
+	class Cursor;  // Defined in Cursor.h
+
+	// ============================================================================
+	// CheckpointOptions - The pool's background WAL checkpointer
+	// ============================================================================
+	//
+	// Without it, checkpoints run at commit time on whichever connection pushes
+	// the WAL past wal_autocheckpoint, and a steady stream of writes (with
+	// readers pinning old snapshots) can grow the -wal file without bound. The
+	// checkpointer runs on its own connection every interval: PASSIVE while no
+	// pooled connection is leased (or once the -wal file passes
+	// restartThresholdBytes), RESTART when the log itself holds more than
+	// restartThresholdBytes, TRUNCATE once the file passes truncateThresholdBytes.
+
+	struct CheckpointOptions
+	{
+		bool enabled = false;
+
+		std::chrono::milliseconds interval{ 1000 };
+
+		// RESTART: writers wrap around to the start of the WAL instead of growing it
+		int64_t restartThresholdBytes = int64_t{ 64 } * 1024 * 1024;
+
+		// TRUNCATE: hand the file's space back
+		int64_t truncateThresholdBytes = int64_t{ 256 } * 1024 * 1024;
+
+		// How long RESTART/TRUNCATE wait on readers and writers before giving up
+		// until the next interval; writers queue behind them meanwhile
+		std::chrono::milliseconds busyTimeout{ 100 };
+
+		// Stop commits on pooled connections from checkpointing themselves
+		// (wal_autocheckpoint=0) unless ConnectionOptions sets it explicitly
+		bool disableAutoCheckpoint = true;
+	}; // end of struct CheckpointOptions
+
+	// ============================================================================
+	// PoolOptions - ConnectionPool configuration
+	// ============================================================================
+
+	struct PoolOptions
+	{
+		// Maximum number of shared connections, or of read-only connections in split mode
+		size_t poolSize = 10;
+
+		bool enableWAL = true;
+
+		// N read-only (query_only) connections plus one dedicated writer. Writers
+		// queue FIFO for the writer lane instead of contending on SQLite's write
+		// lock, and readers never wait behind a write burst for a pool slot.
+		bool readWriteSplit = false;
+
+		// Prepared into each connection's statement cache
+		std::vector<std::string> warmupStatements;
+
+		// Connections opened up front; the rest (up to poolSize) open on demand
+		size_t minPoolSize = 1;
+
+		// Close connections idle for longer than this, down to minPoolSize (0 = never)
+		std::chrono::milliseconds idleTimeout{ 0 };
+
+		// Result cache attached to every connection (see Analyzer::setResultCache)
+		std::shared_ptr<ResultCache> resultCache = nullptr;
+
+		// Metrics for every connection (see ConnectionOptions::metrics) and for
+		// the pool's own acquisitions
+		std::shared_ptr<MetricsSink> metrics = nullptr;
+
+		// Tuning for every connection, e.g. ConnectionOptions::forProfile(...).
+		// The pool sets readOnly and exclusiveUse per lane, and enableWAL and
+		// metrics from the fields above.
+		ConnectionOptions connection = {};
+
+		// Background WAL checkpoints (requires enableWAL); reported through metrics
+		CheckpointOptions checkpoint = {};
+	}; // end of struct PoolOptions
+
+	// Lock-free snapshot of pool counters
+	struct PoolStats
+	{
+		uint64_t acquisitions = 0;  // Successful acquisitions (all lanes)
+		uint64_t affinityHits = 0;  // Served from the calling thread's last slot
+		uint64_t waits = 0;         // Acquisitions that had to block
+		uint64_t created = 0;       // Connections opened (including up-front ones)
+		uint64_t reaped = 0;        // Idle connections closed
+		uint64_t checkpoints = 0;   // Background checkpoints run
+		size_t size = 0;
+		size_t available = 0;
+		size_t inUse = 0;
+	}; // end of struct PoolStats
+
 	class ConnectionPool
 	{
 	public:
+		enum class Lane
+		{
+			Shared,  // Read-write connection from the common pool
+			Read,    // Read-only connection (split mode)
+			Write    // The dedicated writer connection (split mode)
+		}; // end of enum class Lane
+
 		// RAII connection guard - automatically returns connection to pool
 		class Connection
 		{
 		public:
-			Connection(ConnectionPool* pool, std::unique_ptr<Analyzer> conn);
+			Connection(ConnectionPool* pool, Analyzer* conn, size_t slot, Lane lane);
 			~Connection();
 
 			// Disable copy, enable move
@@ -30,24 +134,33 @@ namespace sqlite_flux
 			Connection& operator=(Connection&&) noexcept;
 
 			// Access the underlying Analyzer
-			Analyzer* operator->() { return conn_.get(); }
+			Analyzer* operator->() { return conn_; }
 			Analyzer& operator*() { return *conn_; }
-			const Analyzer* operator->() const { return conn_.get(); }
+			const Analyzer* operator->() const { return conn_; }
 			const Analyzer& operator*() const { return *conn_; }
 
 			// Check if connection is valid
 			bool isValid() const { return conn_ != nullptr; }
 
+			// Lane the connection was leased from
+			Lane lane() const { return lane_; }
+
 		private:
 			ConnectionPool* pool_;
-			std::unique_ptr<Analyzer> conn_;
+			Analyzer* conn_;  // Owned by the pool's slot
+			size_t slot_;
+			Lane lane_;
 		}; // end of class Connection
 
 		// Constructor
+		// warmupStatements are prepared into each connection's statement cache
 		explicit ConnectionPool(
 			const std::string& dbPath,
 			size_t poolSize = 10,
-			bool enableWAL = true);
+			bool enableWAL = true,
+			const std::vector<std::string>& warmupStatements = {});
+
+		ConnectionPool(const std::string& dbPath, const PoolOptions& options);
 
 		// Destructor
 		~ConnectionPool();
@@ -59,32 +172,134 @@ namespace sqlite_flux
 		ConnectionPool& operator=(ConnectionPool&&) = delete;
 
 		// Acquire a connection from the pool (blocks if none available)
+		// In split mode this is the writer lane, so existing callers can still write
 		Connection acquire();
 
-		// Try to acquire a connection with timeout
+		// Try to acquire a connection with timeout (writer lane in split mode)
 		std::optional<Connection> tryAcquire(std::chrono::milliseconds timeout);
 
-		// Get pool statistics
+		// Read-only connection in split mode, a shared connection otherwise
+		Connection acquireRead();
+		std::optional<Connection> tryAcquireRead(std::chrono::milliseconds timeout);
+
+		// The writer connection in split mode (FIFO among waiting writers),
+		// a shared connection otherwise
+		Connection acquireWrite();
+		std::optional<Connection> tryAcquireWrite(std::chrono::milliseconds timeout);
+
+		// Stream a query on a pooled (read) connection held by the Cursor until it is destroyed
+		Cursor stream(const std::string& sql, const std::vector<ColumnValue>& params = {});
+
+		// Get pool statistics (size/available/inUse include the writer in split mode)
+		// All of these read atomics and never take a lock. size() counts open
+		// connections; maxSize() is the most the pool will open.
 		size_t size() const;
+		size_t maxSize() const;
 		size_t available() const;
 		size_t inUse() const;
 		size_t outstandingConnections() const;
+		bool isReadWriteSplit() const { return readWriteSplit_; }
+		size_t waitingWriters() const;
+		PoolStats getStats() const;
 
 	private:
+		// A pooled connection. busy is the ownership flag; inFreeList says whether
+		// the slot index is (or is about to be) in freeList_, so it is never queued twice
+		// while the thread-affine fast path bypasses the queue. A slot without a
+		// connection stays busy and sits in emptySlots_ until someone opens it.
+		struct Slot
+		{
+			std::unique_ptr<Analyzer> conn;
+			std::atomic<bool> busy{ false };
+			std::atomic<bool> inFreeList{ false };
+			std::atomic<int64_t> idleSince{ 0 };  // steady_clock ticks at last release
+		}; // end of struct Slot
+
+		// A writer blocked on the writer lane; release() hands the lane straight
+		// to the oldest waiter so it stays FIFO
+		struct WriteWaiter
+		{
+			bool granted = false;
+		}; // end of struct WriteWaiter
+
+		std::unique_ptr<Analyzer> openConnection(Lane lane);
+		std::optional<Connection> acquireShared(std::optional<std::chrono::milliseconds> timeout);
+		std::optional<Connection> acquireWriter(std::optional<std::chrono::milliseconds> timeout);
+
+		// Lock-free: claim this thread's last slot, else pop the free list
+		bool tryClaimSlot(size_t& slot);
+		Connection makeConnection(size_t slot, Lane lane, std::chrono::nanoseconds waited = {});
+		Connection openInSlot(size_t slot, Lane lane, std::chrono::nanoseconds waited = {});
+
 		// Release connection back to pool
-		void release(std::unique_ptr<Analyzer> conn);
+		void release(size_t slot, Lane lane);
+		void returnSlot(size_t slot);
+		void notifyWaiters();
+
+		// Idle reaping (background thread, only when idleTimeout > 0)
+		void reaperLoop();
+		void reapIdle();
+
+		// Background checkpoints (own thread and connection, only when enabled)
+		void checkpointLoop();
+		void runCheckpoint();
+
+		// Sets shutdown_ and joins the reaper and checkpointer (if running)
+		void stopBackgroundThreads();
 
 		std::string dbPath_;
 		size_t poolSize_;
-		bool enableWAL_;
+		ConnectionOptions connectionOptions_;
+		bool readWriteSplit_;
+		std::vector<std::string> warmupStatements_;
+		std::shared_ptr<ResultCache> resultCache_;
+		std::shared_ptr<MetricsSink> metrics_;
+		const uint64_t id_;  // Tags thread-affine slot hints
+
+		// Shared (or read-only, in split mode) connections: slots_[0, poolSize_)
+		// In split mode slots_[poolSize_] is the writer
+		std::unique_ptr<Slot[]> slots_;
+		BoundedMpmcQueue<size_t> freeList_;
+		BoundedMpmcQueue<size_t> emptySlots_;  // Slots that may open a connection
 
-		std::queue<std::unique_ptr<Analyzer>> pool_;
+		size_t minPoolSize_;
+		std::chrono::milliseconds idleTimeout_;
+
+		// One schema snapshot for all connections; refreshed on schema_version change
+		std::shared_ptr<SharedSchema> sharedSchema_ = std::make_shared<SharedSchema>();
+
+		// Slow path: only touched when the free list is empty
 		mutable std::mutex mutex_;
 		std::condition_variable cv_;
+		std::atomic<size_t> waiters_{ 0 };
+
+		// Writer lane (split mode only)
+		bool writerIdle_ = false;
+		std::deque<WriteWaiter*> writeWaiters_;
+		mutable std::mutex writerMutex_;
+		std::condition_variable writerCv_;
+		std::atomic<size_t> waitingWriters_{ 0 };
 
-		size_t totalConnections_;
+		std::atomic<size_t> liveConnections_{ 0 };
 		std::atomic<bool> shutdown_{ false };
 		std::atomic<size_t> outstandingConnections_{ 0 };
+		std::atomic<uint64_t> acquisitions_{ 0 };
+		std::atomic<uint64_t> affinityHits_{ 0 };
+		std::atomic<uint64_t> waits_{ 0 };
+		std::atomic<uint64_t> created_{ 0 };
+		std::atomic<uint64_t> reaped_{ 0 };
+
+		std::mutex reaperMutex_;
+		std::condition_variable reaperCv_;
+		std::thread reaper_;
+
+		CheckpointOptions checkpointOptions_;
+		std::unique_ptr<Analyzer> checkpointConn_;
+		int64_t frameBytes_ = 0;  // Page size plus the WAL frame header
+		std::atomic<uint64_t> checkpoints_{ 0 };
+		std::mutex checkpointMutex_;
+		std::condition_variable checkpointCv_;
+		std::thread checkpointer_;
 	}; // end of class ConnectionPool
 
 } // namespace sqlite_flux
\ No newline at end of file
@@ -0,0 +1,139 @@
+// include/Cursor.h
+#pragma once
+
+#include "ConnectionPool.h"
+#include "TableTypes.h"
+#include "ColumnValue.h"
+#include "RowView.h"
+#include "Metrics.h"
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <span>
+#include <vector>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+
+// Forward declaration to avoid including sqlite3.h in header
+struct sqlite3_stmt;
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// Cursor - Forward-only streaming over a live statement
+	// ============================================================================
+	//
+	// Rows are decoded one at a time, so memory stays constant regardless of the
+	// result size. A Cursor must not outlive its Analyzer; when created from a
+	// ConnectionPool it keeps the pooled connection checked out until destroyed.
+	// Stepping takes the Analyzer's lock, so other threads may keep using the
+	// Analyzer meanwhile; one Cursor itself is for one thread at a time.
+
+	class Cursor
+	{
+	public:
+		// Input iterator over the current row (advancing steps the statement)
+		class iterator
+		{
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type = Row;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const Row*;
+			using reference = const Row&;
+
+			iterator() = default;
+			explicit iterator(Cursor* cursor) : cursor_(cursor) {}
+
+			const Row& operator*() const { return cursor_->row(); }
+			const Row* operator->() const { return &cursor_->row(); }
+			iterator& operator++();
+			void operator++(int) { ++*this; }
+
+			bool operator==(const iterator& other) const { return atEnd() == other.atEnd(); }
+			bool operator!=(const iterator& other) const { return !(*this == other); }
+
+		private:
+			bool atEnd() const { return !cursor_ || !cursor_->hasRow(); }
+
+			Cursor* cursor_ = nullptr;
+		}; // end of class iterator
+
+		Cursor() = default;
+
+		// Takes ownership of a prepared (and bound) statement; dbMutex, if given,
+		// is held while the statement is stepped or finalized
+		explicit Cursor(sqlite3_stmt* stmt, std::mutex* dbMutex = nullptr);
+
+		~Cursor();
+
+		// Disable copy, enable move
+		Cursor(const Cursor&) = delete;
+		Cursor& operator=(const Cursor&) = delete;
+		Cursor(Cursor&& other) noexcept;
+		Cursor& operator=(Cursor&& other) noexcept;
+
+		// Keep a pooled connection checked out for the cursor's lifetime
+		void holdConnection(ConnectionPool::Connection connection);
+
+		// Time the steps and hand the totals to report just before the statement
+		// is finalized (with dbMutex held); used by Analyzer::stream with metrics
+		void reportTo(std::function<void(StatementMetrics&)> report);
+
+		// Advance to the next row; false at the end of the result or on error
+		bool next();
+
+		// State
+		bool isValid() const { return stmt_ != nullptr; }
+		bool hasRow() const { return hasRow_; }
+		bool done() const { return done_; }
+		bool hasError() const { return !lastError_.empty(); }
+		const std::string& getLastError() const { return lastError_; }
+		int64_t rowsRead() const { return rowsRead_; }
+
+		// Column metadata
+		size_t columnCount() const { return columnNames_.size(); }
+		const std::vector<std::string>& columnNames() const { return columnNames_; }
+		std::optional<size_t> columnIndex(const std::string& column_) const;
+
+		// Current row access (valid until the next call to next())
+		ColumnValue value(size_t col) const;
+		std::vector<ColumnValue> values() const;
+		const Row& row();  // Reuses one map across rows
+
+		// Zero-copy view of the current row (empty when there is none)
+		RowView view() const;
+
+		// Range-for support: begin() steps to the first row if not started
+		iterator begin();
+		iterator end() { return iterator(); }
+
+	private:
+		void finalize();
+		std::unique_lock<std::mutex> lockDb() const;
+
+		// Declared first so the connection is released after the statement is finalized
+		std::optional<ConnectionPool::Connection> connection_;
+
+		sqlite3_stmt* stmt_ = nullptr;
+		std::mutex* dbMutex_ = nullptr;  // The owning Analyzer's, unless it is exclusive-use
+		std::vector<std::string> columnNames_;
+		bool started_ = false;
+		bool hasRow_ = false;
+		bool done_ = false;
+		std::string lastError_;
+		int64_t rowsRead_ = 0;
+
+		std::function<void(StatementMetrics&)> report_;  // Empty: nothing is timed
+		std::chrono::nanoseconds stepTime_{ 0 };
+
+		Row row_;
+		std::vector<ColumnValue*> rowSlots_;  // Stable pointers into row_ values
+		bool rowCurrent_ = false;
+	}; // end of class Cursor
+
+} // namespace sqlite_flux
\ No newline at end of file
@@ -5,12 +5,71 @@
 #include "TableTypes.h"
 #include "ColumnValue.h"
 #include "QueryBuilder.h"  // For FilterCondition and CompareOp
+#include "FilterShapeCache.h"
 #include <string>
 #include <vector>
+#include <future>
 
 namespace sqlite_flux
 {
 
+	class WriteBatcher;  // Defined in WriteBatcher.h
+
+	// ============================================================================
+	// PreparedDelete - High-performance batch delete operations
+	// ============================================================================
+	//
+	// Each WHERE shape (filter columns and operators) is prepared the first
+	// time it is seen and rebound for every later item with the same shape.
+
+	class PreparedDelete
+	{
+	public:
+		PreparedDelete(Analyzer& analyzer, const std::string& tableName, bool allowUnsafe = false);
+
+		~PreparedDelete();
+
+		// Disable copy, enable move constructor only (no move assignment due to reference member)
+		PreparedDelete(const PreparedDelete&) = delete;
+		PreparedDelete& operator=(const PreparedDelete&) = delete;
+		PreparedDelete(PreparedDelete&& other) noexcept;
+		PreparedDelete& operator=(PreparedDelete&&) = delete;
+
+		// Set WHERE conditions for current batch item
+		PreparedDelete& Where(const std::string& column_, const ColumnValue& value_,
+			CompareOp op_ = CompareOp::Equal);
+
+		// Execute current batch item; an item without conditions throws unless
+		// the builder was Unsafe()
+		void ExecuteBatch();
+
+		// Finalize batch and commit transaction
+		// Returns total number of rows deleted
+		int64_t Finalize();
+
+		// Get number of rows deleted in current batch
+		int64_t getDeleteCount() const { return deleteCount_; }
+
+		// Distinct WHERE shapes prepared so far
+		size_t getStatementCount() const { return statements_.size(); }
+
+	private:
+		Analyzer& analyzer_;
+		std::string tableName_;
+		bool allowUnsafe_ = false;
+		std::vector<FilterCondition> currentFilters_;
+		std::vector<ColumnValue> params_;  // Current item's WHERE values, reused across items
+		FilterShapeCache statements_;
+		bool inTransaction_ = false;
+		int64_t deleteCount_ = 0;
+		int64_t changesSinceCommit_ = 0;  // Rolled back if the next commit fails
+		int64_t operationCount_ = 0;
+		int64_t batchSize_ = 1000;  // Auto-commit every N operations
+
+		sqlite3_stmt* statementForCurrentShape();
+		void cleanup();
+	}; // end of class PreparedDelete
+
 	// ============================================================================
 	// DeleteBuilder - Fluent API for DELETE operations
 	// ============================================================================
@@ -36,13 +95,23 @@ namespace sqlite_flux
 		// Execute delete and return number of rows affected
 		int64_t Execute();
 
-		// Generate SQL statement (for debugging/logging)
+		// Queue the delete on a WriteBatcher; the result carries the affected count
+		std::future<ExecuteResult> Submit(WriteBatcher& batcher);
+
+		// Prepare for batch operations; conditions are given per item on the
+		// PreparedDelete, so the builder itself must not have any
+		PreparedDelete Prepare();
+
+		// Generate SQL statement (for debugging/logging) - values appear as ? placeholders
 		std::string buildSql() const;
 
+		// Values bound to the placeholders of buildSql(), in order
+		std::vector<ColumnValue> buildParams() const;
+
 	private:
 		Analyzer& analyzer_;
 		std::string tableName_;
-		TableSchema schema_;
+		std::shared_ptr<const TableDescriptor> table_;  // Shared with every builder on this table
 
 		std::vector<FilterCondition> filters_;
 		std::string orderByColumn_;
@@ -0,0 +1,60 @@
+// include/FilterShapeCache.h
+#pragma once
+
+#include "QueryBuilder.h"  // For FilterCondition and CompareOp
+#include <string>
+#include <utility>
+#include <vector>
+
+// Forward declaration
+struct sqlite3_stmt;
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// FilterShapeCache - Caller-owned statements keyed by WHERE shape
+	// ============================================================================
+	//
+	// A shape is the sequence of filter columns and operators, without the
+	// values, so every batch item filtering the same way reuses one prepared
+	// statement and only rebinds. Batch jobs use one or a few shapes, so
+	// lookup is a linear scan that allocates nothing. Owns its statements and
+	// finalizes them on clear() and destruction. Not thread-safe.
+
+	class FilterShapeCache
+	{
+	public:
+		FilterShapeCache() = default;
+		~FilterShapeCache();
+
+		FilterShapeCache(const FilterShapeCache&) = delete;
+		FilterShapeCache& operator=(const FilterShapeCache&) = delete;
+		FilterShapeCache(FilterShapeCache&& other) noexcept;
+		FilterShapeCache& operator=(FilterShapeCache&& other) noexcept;
+
+		// Statement prepared for the shape of filters, or nullptr
+		sqlite3_stmt* find(const std::vector<FilterCondition>& filters) const;
+
+		// Take ownership of stmt, prepared for the shape of filters
+		void add(const std::vector<FilterCondition>& filters, sqlite3_stmt* stmt);
+
+		// Finalize every statement
+		void clear();
+
+		size_t size() const { return entries_.size(); }
+
+		// " WHERE a = ? AND b > ?" for filters (empty without filters)
+		static std::string whereClause(const std::vector<FilterCondition>& filters);
+
+	private:
+		struct Entry
+		{
+			std::vector<std::pair<std::string, CompareOp>> shape;
+			sqlite3_stmt* stmt = nullptr;
+		}; // end of struct Entry
+
+		std::vector<Entry> entries_;
+	}; // end of class FilterShapeCache
+
+} // namespace sqlite_flux
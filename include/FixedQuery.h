@@ -0,0 +1,343 @@
+// include/FixedQuery.h
+#pragma once
+
+#include "Analyzer.h"
+#include "QueryBuilder.h"  // For CompareOp and compareOpSql
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// FixedString - A string literal usable as a template argument
+	// ============================================================================
+
+	template<size_t N>
+	struct FixedString
+	{
+		char value[N]{};
+
+		consteval FixedString(const char (&text)[N])
+		{
+			for (size_t i = 0; i < N; ++i) value[i] = text[i];
+		} // end of FixedString constructor
+
+		constexpr std::string_view view() const { return std::string_view(value, N - 1); }
+	}; // end of struct FixedString
+
+	namespace detail
+	{
+
+		// Plain identifiers only (optionally qualified, e.g. "u.id"): the names are
+		// pasted into the SQL text, so anything else is rejected at compile time
+		constexpr bool isSqlIdentifier(std::string_view name)
+		{
+			if (name.empty() || (name.front() >= '0' && name.front() <= '9')) return false;
+
+			for (char c : name)
+			{
+				bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.';
+				if (!ok) return false;
+			} // end of for
+
+			return true;
+		} // end of isSqlIdentifier
+
+		// Select entries may be expressions ("count(*)", "max(age) AS oldest"), but
+		// a single one, so no statement separators
+		constexpr bool isSqlExpression(std::string_view text)
+		{
+			return !text.empty() && text.find(';') == std::string_view::npos;
+		} // end of isSqlExpression
+
+	} // namespace detail
+
+	// ============================================================================
+	// Clauses of a FixedQuery
+	// ============================================================================
+
+	namespace fixed
+	{
+
+		enum class ClauseKind
+		{
+			Where,
+			OrderBy,
+			Limit,
+			Offset
+		}; // end of enum class ClauseKind
+
+		// Selected columns or expressions; Select<> selects *
+		template<FixedString... Names>
+		struct Select
+		{
+			static_assert((detail::isSqlExpression(Names.view()) && ...), "Select entry must be one non-empty expression");
+
+			static constexpr std::array<std::string_view, sizeof...(Names)> names{ Names.view()... };
+		}; // end of struct Select
+
+		// "column op ?" ANDed with the other Where clauses; each takes one value,
+		// passed to Execute in declaration order
+		template<FixedString Column, CompareOp Op = CompareOp::Equal>
+		struct Where
+		{
+			static_assert(detail::isSqlIdentifier(Column.view()), "Where column must be a plain identifier");
+
+			static constexpr ClauseKind kind = ClauseKind::Where;
+			static constexpr std::string_view column = Column.view();
+			static constexpr CompareOp op = Op;
+		}; // end of struct Where
+
+		template<FixedString Column, bool Ascending = true>
+		struct OrderBy
+		{
+			static_assert(detail::isSqlIdentifier(Column.view()), "OrderBy column must be a plain identifier");
+
+			static constexpr ClauseKind kind = ClauseKind::OrderBy;
+			static constexpr std::string_view column = Column.view();
+			static constexpr bool ascending = Ascending;
+		}; // end of struct OrderBy
+
+		template<int Rows>
+		struct Limit
+		{
+			static_assert(Rows >= 0, "Limit must be non-negative");
+
+			static constexpr ClauseKind kind = ClauseKind::Limit;
+			static constexpr int value = Rows;
+		}; // end of struct Limit
+
+		template<int Rows>
+		struct Offset
+		{
+			static_assert(Rows >= 0, "Offset must be non-negative");
+
+			static constexpr ClauseKind kind = ClauseKind::Offset;
+			static constexpr int value = Rows;
+		}; // end of struct Offset
+
+		template<typename T>
+		struct IsSelect : std::false_type {};
+
+		template<FixedString... Names>
+		struct IsSelect<Select<Names...>> : std::true_type {};
+
+	} // namespace fixed
+
+	namespace detail
+	{
+
+		// Appends to out when it is set, otherwise only counts, so the same pass
+		// sizes the buffer and then fills it
+		struct SqlWriter
+		{
+			char* out = nullptr;
+			size_t size = 0;
+
+			constexpr void append(char c)
+			{
+				if (out) out[size] = c;
+				++size;
+			} // end of append
+
+			constexpr void append(std::string_view text)
+			{
+				for (char c : text) append(c);
+			} // end of append
+
+			constexpr void append(int value)
+			{
+				char digits[12]{};
+				int count = 0;
+				do
+				{
+					digits[count++] = static_cast<char>('0' + value % 10);
+					value /= 10;
+				} while (value > 0);
+
+				while (count > 0) append(digits[--count]);
+			} // end of append
+		}; // end of struct SqlWriter
+
+		// Same clause order and spelling as QueryBuilder::buildSql
+		template<FixedString Table, typename Columns, typename... Clauses>
+		constexpr void writeFixedSelect(SqlWriter& sql)
+		{
+			sql.append(std::string_view("SELECT "));
+			if constexpr (Columns::names.empty())
+			{
+				sql.append('*');
+			} // end of if constexpr
+			else
+			{
+				for (size_t i = 0; i < Columns::names.size(); ++i)
+				{
+					if (i > 0) sql.append(std::string_view(", "));
+					sql.append(Columns::names[i]);
+				} // end of for
+			} // end of else
+
+			sql.append(std::string_view(" FROM "));
+			sql.append(Table.view());
+
+			bool first = true;
+			[[maybe_unused]] auto where = [&](auto clause) {
+				using C = decltype(clause);
+				if constexpr (C::kind == fixed::ClauseKind::Where)
+				{
+					sql.append(std::string_view(first ? " WHERE " : " AND "));
+					sql.append(C::column);
+					sql.append(' ');
+					sql.append(compareOpSql(C::op));
+					sql.append(std::string_view(C::op == CompareOp::In ? " (?)" : " ?"));
+					first = false;
+				} // end of if constexpr
+				};
+			(where(Clauses{}), ...);
+
+			first = true;
+			[[maybe_unused]] auto orderBy = [&](auto clause) {
+				using C = decltype(clause);
+				if constexpr (C::kind == fixed::ClauseKind::OrderBy)
+				{
+					sql.append(std::string_view(first ? " ORDER BY " : ", "));
+					sql.append(C::column);
+					sql.append(std::string_view(C::ascending ? " ASC" : " DESC"));
+					first = false;
+				} // end of if constexpr
+				};
+			(orderBy(Clauses{}), ...);
+
+			// SQLite needs a LIMIT before OFFSET; -1 means no limit
+			int limit = -1;
+			int offset = -1;
+			[[maybe_unused]] auto paging = [&](auto clause) {
+				using C = decltype(clause);
+				if constexpr (C::kind == fixed::ClauseKind::Limit) limit = C::value;
+				if constexpr (C::kind == fixed::ClauseKind::Offset) offset = C::value;
+				};
+			(paging(Clauses{}), ...);
+
+			if (limit >= 0 || offset >= 0)
+			{
+				sql.append(std::string_view(" LIMIT "));
+				if (limit >= 0) sql.append(limit);
+				else sql.append(std::string_view("-1"));
+			} // end of if
+			if (offset >= 0)
+			{
+				sql.append(std::string_view(" OFFSET "));
+				sql.append(offset);
+			} // end of if
+		} // end of writeFixedSelect
+
+		// NUL-terminated SQL text of the shape, computed entirely at compile time
+		template<FixedString Table, typename Columns, typename... Clauses>
+		constexpr auto renderFixedSelect()
+		{
+			constexpr size_t length = [] {
+				SqlWriter sizing;
+				writeFixedSelect<Table, Columns, Clauses...>(sizing);
+				return sizing.size;
+				}();
+
+			std::array<char, length + 1> text{};
+			SqlWriter writer{ text.data() };
+			writeFixedSelect<Table, Columns, Clauses...>(writer);
+			return text;
+		} // end of renderFixedSelect
+
+		template<fixed::ClauseKind Kind, typename... Clauses>
+		inline constexpr size_t ClauseCount = ((Clauses::kind == Kind ? 1 : 0) + ... + 0);
+
+	} // namespace detail
+
+	// ============================================================================
+	// FixedQuery - A SELECT whose shape is fixed at compile time
+	// ============================================================================
+	//
+	// For the query shapes a service runs on every request, declare the shape
+	// once as a type:
+	//
+	//   using UsersByAge = sqlite_flux::FixedQuery<"users",
+	//       sqlite_flux::fixed::Select<"id", "name">,
+	//       sqlite_flux::fixed::Where<"age", sqlite_flux::CompareOp::GreaterThanOrEqual>,
+	//       sqlite_flux::fixed::OrderBy<"id">,
+	//       sqlite_flux::fixed::Limit<50>>;
+	//
+	//   ResultTable rows = UsersByAge::ExecuteTable(db, 21);
+	//
+	// The SQL text is a constant rendered by the compiler, and the values
+	// are bound from a stack array, so running a shape builds no string, vector
+	// or FilterCondition. It only looks up the connection's cached statement
+	// and rebinds it. Table, Where and OrderBy names must be plain identifiers
+	// (checked at compile time); Select entries are pasted as written. Nothing
+	// is validated against the schema: an unknown column fails to prepare,
+	// giving an empty result and getLastError() like Analyzer::query.
+
+	template<FixedString Table, typename Columns, typename... Clauses>
+	class FixedQuery
+	{
+		static_assert(detail::isSqlIdentifier(Table.view()), "FixedQuery table must be a plain identifier");
+		static_assert(fixed::IsSelect<Columns>::value, "FixedQuery's second argument must be fixed::Select<...>");
+		static_assert(detail::ClauseCount<fixed::ClauseKind::Limit, Clauses...> <= 1, "FixedQuery takes at most one Limit");
+		static_assert(detail::ClauseCount<fixed::ClauseKind::Offset, Clauses...> <= 1, "FixedQuery takes at most one Offset");
+
+	public:
+		// Values Execute expects: one per Where clause
+		static constexpr size_t ParameterCount = detail::ClauseCount<fixed::ClauseKind::Where, Clauses...>;
+
+		static constexpr std::string_view sql() { return std::string_view(text_.data(), text_.size() - 1); }
+
+		template<typename... Args>
+		static ResultSet Execute(const Analyzer& analyzer, Args&&... args)
+		{
+			return analyzer.query(sql(), bind(std::forward<Args>(args)...));
+		} // end of Execute
+
+		template<typename... Args>
+		static ResultTable ExecuteTable(const Analyzer& analyzer, Args&&... args)
+		{
+			return analyzer.queryTable(sql(), bind(std::forward<Args>(args)...));
+		} // end of ExecuteTable
+
+		template<typename... Args>
+		static ArenaResultTable ExecuteArena(const Analyzer& analyzer, Args&&... args)
+		{
+			return analyzer.queryArena(sql(), bind(std::forward<Args>(args)...));
+		} // end of ExecuteArena
+
+		// First column of the first row; nullopt if there is no row or it is not a T
+		template<typename T, typename... Args>
+		static std::optional<T> ExecuteScalar(const Analyzer& analyzer, Args&&... args)
+		{
+			auto value = analyzer.queryScalar(sql(), bind(std::forward<Args>(args)...));
+			if (!value)
+			{
+				return std::nullopt;
+			} // end of if
+
+			if (auto* val = std::get_if<T>(&*value))
+			{
+				return *val;
+			} // end of if
+			return std::nullopt;
+		} // end of ExecuteScalar
+
+	private:
+		template<typename... Args>
+		static std::array<ColumnValue, ParameterCount> bind(Args&&... args)
+		{
+			static_assert(sizeof...(Args) == ParameterCount, "FixedQuery takes exactly one value per Where clause");
+			return { ColumnValue(std::forward<Args>(args))... };
+		} // end of bind
+
+		static constexpr auto text_ = detail::renderFixedSelect<Table, Columns, Clauses...>();
+	}; // end of class FixedQuery
+
+} // namespace sqlite_flux
@@ -6,8 +6,11 @@
 #include "ColumnValue.h"
 #include <string>
 #include <vector>
+#include <future>
 #include <unordered_map>
 #include <memory>
+#include <span>
+#include <utility>
 
 // Forward declaration
 struct sqlite3_stmt;
@@ -15,6 +18,8 @@ struct sqlite3_stmt;
 namespace sqlite_flux
 {
 
+	class WriteBatcher;  // Defined in WriteBatcher.h
+
 	// ============================================================================
 	// ConflictResolution - SQLite conflict handling strategies
 	// ============================================================================
@@ -48,6 +53,9 @@ namespace sqlite_flux
 		// Set values for current batch item
 		PreparedInsert& Values(const std::unordered_map<std::string, ColumnValue>& values);
 
+		// Set values positionally, in getColumns() order (no per-row map lookup)
+		PreparedInsert& Values(std::span<const ColumnValue> values);
+
 		// Execute current batch item (adds to transaction)
 		void ExecuteBatch();
 
@@ -58,21 +66,115 @@ namespace sqlite_flux
 		// Get number of successful inserts in current batch
 		int64_t getInsertCount() const { return insertCount_; }
 
+		// Column order used by the prepared statement and positional Values()
+		const std::vector<std::string>& getColumns() const { return columns_; }
+
 	private:
 		Analyzer& analyzer_;
 		std::string tableName_;
 		std::vector<std::string> columns_;
-		std::string currentSql_;  // Current SQL statement being built
+		std::vector<ColumnValue> currentValues_;  // Bound to stmt_ on ExecuteBatch
+		bool hasValues_ = false;
 		sqlite3_stmt* stmt_ = nullptr;
 		bool inTransaction_ = false;
 		int64_t insertCount_ = 0;
 		int64_t batchSize_ = 1000;  // Auto-commit every N operations
 
 		void prepareStatement(ConflictResolution conflict);
-		void bindValue(int index, const ColumnValue& value_);
 		void cleanup();
 	}; // end of class PreparedInsert
 
+	// ============================================================================
+	// BulkInsertOptions - Tuning for large one-off loads
+	// ============================================================================
+
+	struct BulkInsertOptions
+	{
+		// Rows packed into one INSERT ... VALUES (...),(...) statement
+		// 0 = as many as SQLITE_MAX_VARIABLE_NUMBER allows (capped at MaxAutoRowsPerStatement)
+		size_t rowsPerStatement = 0;
+
+		// Commit every N rows (0 = one transaction for the whole load)
+		int64_t rowsPerTransaction = 100000;
+
+		// Use synchronous=OFF and a larger page cache during the load, restored afterwards
+		bool fastPragmas = false;
+		int64_t cacheSizeKiB = 256 * 1024;
+
+		// Drop the table's non-unique CREATE INDEX indexes during the load and rebuild
+		// them at the end (unique indexes and constraint indexes are always kept)
+		bool deferIndexes = false;
+
+		static constexpr size_t MaxAutoRowsPerStatement = 1000;
+	}; // end of struct BulkInsertOptions
+
+	// ============================================================================
+	// BulkInsert - Multi-row VALUES batching for bulk loads
+	// ============================================================================
+
+	class BulkInsert
+	{
+	public:
+		BulkInsert(Analyzer& analyzer, const std::string& tableName,
+			const std::vector<std::string>& columns,
+			ConflictResolution conflict,
+			const BulkInsertOptions& options);
+
+		~BulkInsert();
+
+		// Disable copy, enable move constructor only (no move assignment due to reference member)
+		BulkInsert(const BulkInsert&) = delete;
+		BulkInsert& operator=(const BulkInsert&) = delete;
+		BulkInsert(BulkInsert&& other) noexcept;
+		BulkInsert& operator=(BulkInsert&&) = delete;
+
+		// Buffer one row (positional, in getColumns() order); writes a statement when full
+		BulkInsert& Add(std::span<const ColumnValue> row);
+		BulkInsert& Add(const std::unordered_map<std::string, ColumnValue>& row);
+
+		// Write any buffered rows now
+		void Flush();
+
+		// Flush, commit, rebuild deferred indexes and restore pragmas
+		// Returns total number of rows inserted
+		int64_t Finalize();
+
+		int64_t getInsertCount() const { return insertCount_; }
+		size_t getRowsPerStatement() const { return rowsPerStatement_; }
+		const std::vector<std::string>& getColumns() const { return columns_; }
+
+		// CREATE INDEX statements a failed Finalize could not rebuild
+		const std::vector<std::string>& getUnrebuiltIndexSql() const { return deferredIndexSql_; }
+
+	private:
+		Analyzer& analyzer_;
+		std::string tableName_;
+		std::vector<std::string> columns_;
+		ConflictResolution conflict_;
+		BulkInsertOptions options_;
+
+		size_t rowsPerStatement_ = 1;
+		sqlite3_stmt* fullStmt_ = nullptr;     // Statement for a full buffer of rows
+		std::vector<ColumnValue> pending_;      // Buffered rows, flattened row-major
+		size_t pendingRows_ = 0;
+
+		bool inTransaction_ = false;
+		int64_t insertCount_ = 0;
+		int64_t rowsSinceCommit_ = 0;
+
+		// Settings to restore when the load ends
+		bool pragmasChanged_ = false;
+		int64_t previousSynchronous_ = 2;
+		int64_t previousCacheSize_ = -2000;
+		std::vector<std::string> deferredIndexSql_;
+
+		std::string buildSql(size_t rowCount) const;
+		void writePending();
+		void beginLoad();
+		void endLoad();
+		void cleanup();
+	}; // end of class BulkInsert
+
 	// ============================================================================
 	// InsertBuilder - Fluent API for INSERT operations
 	// ============================================================================
@@ -85,6 +187,10 @@ namespace sqlite_flux
 		// Set values to insert (map-based - self-documenting)
 		InsertBuilder& Values(const std::unordered_map<std::string, ColumnValue>& values);
 
+		// Insert size zero bytes into column_ (zeroblob), to be filled in
+		// afterwards through Analyzer::openBlob on the returned rowid
+		InsertBuilder& ZeroBlob(const std::string& column_, int64_t size);
+
 		// Conflict resolution strategies
 		InsertBuilder& OrIgnore();   // INSERT OR IGNORE
 		InsertBuilder& OrReplace();  // INSERT OR REPLACE
@@ -93,27 +199,40 @@ namespace sqlite_flux
 		// Returns 0 if OR IGNORE skipped the insert
 		int64_t Execute();
 
+		// Queue the insert on a WriteBatcher instead of running it on this builder's
+		// connection; the result carries the new rowid (0 if OR IGNORE skipped it)
+		std::future<ExecuteResult> Submit(WriteBatcher& batcher);
+
 		// Prepare for batch operations
 		// Returns PreparedInsert object for high-performance batching
 		PreparedInsert Prepare();
 
-		// Generate SQL statement (for debugging/logging)
+		// Prepare for positional batch inserts into an explicit column list
+		PreparedInsert Prepare(const std::vector<std::string>& columns);
+
+		// Prepare a bulk load that packs many rows into each INSERT statement
+		BulkInsert PrepareBulk(const std::vector<std::string>& columns,
+			const BulkInsertOptions& options = {});
+
+		// Generate SQL statement (for debugging/logging) - values appear as ? placeholders
 		std::string buildSql() const;
 
+		// Values bound to the placeholders of buildSql(), in order
+		std::vector<ColumnValue> buildParams() const;
+
 	private:
 		Analyzer& analyzer_;
 		std::string tableName_;
-		TableSchema schema_;
+		std::shared_ptr<const TableDescriptor> table_;  // Shared with every builder on this table
 
 		std::unordered_map<std::string, ColumnValue> values_;
+		std::vector<std::pair<std::string, int64_t>> zeroBlobs_;  // Bound as zeroblob(?) after values_
 		ConflictResolution conflictResolution_ = ConflictResolution::None;
 
 		// Validation helpers
 		void validateColumn(const std::string& column_) const;
 		void validateColumnType(const std::string& column_, const ColumnValue& value_) const;
 		void validateAllColumns() const;
-		std::string getSqliteType(const std::string& column_) const;
-		bool isTypeCompatible(const std::string& sqliteType, const ColumnValue& value_) const;
 
 		// SQL generation helper
 		std::string getConflictClause() const;
@@ -0,0 +1,259 @@
+// include/Metrics.h
+#pragma once
+
+#include "ColumnValue.h"
+#include "ConnectionOptions.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// Metric events - What the instrumented hot paths report
+	// ============================================================================
+
+	// One statement run by Analyzer::query/queryScalar/queryTable/queryArena/execute/
+	// executeDml/executePrepared, or one Cursor from Analyzer::stream (reported when
+	// it is finalized). sql and params are only valid during the callback.
+	struct StatementMetrics
+	{
+		std::string_view sql;
+		std::span<const ColumnValue> params;
+		std::chrono::nanoseconds prepare{ 0 };  // 0 when the statement cache had it
+		std::chrono::nanoseconds step{ 0 };     // Inside sqlite3_step
+		std::chrono::nanoseconds decode{ 0 };   // Turning columns into Rows
+		int64_t rows = 0;                       // Rows returned
+		int busyRetries = 0;                    // Times the busy handler waited for a lock
+		bool statementCacheHit = false;
+		bool usedStatementCache = true;         // False for cursors and sqlite3_exec scripts
+		bool success = true;
+
+		std::chrono::nanoseconds total() const { return prepare + step + decode; }
+	}; // end of struct StatementMetrics
+
+	// One ConnectionPool acquisition
+	struct PoolAcquireMetrics
+	{
+		std::chrono::nanoseconds wait{ 0 };  // 0 unless the caller had to block
+		bool writer = false;                 // Writer lane (split mode)
+		size_t inUse = 0;                    // Leased connections, this one included
+		size_t open = 0;                     // Open connections
+	}; // end of struct PoolAcquireMetrics
+
+	// One Analyzer::checkpoint (including the pool's background checkpointer)
+	struct CheckpointMetrics
+	{
+		CheckpointMode mode = CheckpointMode::Passive;
+		std::chrono::nanoseconds duration{ 0 };
+		int logFrames = 0;           // Frames in the WAL
+		int checkpointedFrames = 0;  // Frames copied into the database so far
+		int busyRetries = 0;         // Times it waited on readers or writers
+		bool success = true;         // False if it hit SQLITE_BUSY or failed
+	}; // end of struct CheckpointMetrics
+
+	// One ThreadPool task
+	struct TaskMetrics
+	{
+		std::chrono::nanoseconds queued{ 0 };  // Submission to start
+		std::chrono::nanoseconds run{ 0 };
+		size_t queueDepth = 0;                 // Tasks still queued when it started
+	}; // end of struct TaskMetrics
+
+	// ============================================================================
+	// MetricsSink - Receives metric events
+	// ============================================================================
+	//
+	// Attach through ConnectionOptions::metrics, PoolOptions::metrics (every pooled
+	// connection plus the pool itself) or ThreadPoolOptions::metrics. With none
+	// attached (the default) the hot paths skip all timing, so there is nothing
+	// to pay for. Callbacks run inline on the instrumented thread, possibly on
+	// many threads at once: keep them short and thread-safe. Override only what
+	// you need; the defaults do nothing.
+
+	class MetricsSink
+	{
+	public:
+		virtual ~MetricsSink() = default;
+
+		virtual void onStatement(const StatementMetrics& /*statement*/) {}
+
+		// Schema snapshot lookups: refreshed is true when it had to be rebuilt
+		virtual void onSchemaLookup(bool /*refreshed*/) {}
+
+		virtual void onPoolAcquire(const PoolAcquireMetrics& /*acquire*/) {}
+		virtual void onTask(const TaskMetrics& /*task*/) {}
+		virtual void onCheckpoint(const CheckpointMetrics& /*checkpoint*/) {}
+	}; // end of class MetricsSink
+
+	// ============================================================================
+	// Histogram - Lock-free log-linear histogram of non-negative values
+	// ============================================================================
+	//
+	// Exact below 16, then four buckets per power of two (within 12.5% of the
+	// real value). record() is a handful of relaxed atomic adds.
+
+	class Histogram
+	{
+	public:
+		static constexpr size_t BucketCount = 256;
+
+		void record(uint64_t value);
+		void record(std::chrono::nanoseconds duration)
+		{
+			record(static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0)));
+		} // end of record
+
+		uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+		uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+		uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+		// Upper bound of the bucket holding the p-th quantile (p in [0, 1])
+		uint64_t percentile(double p) const;
+
+		void reset();
+
+		static size_t bucketOf(uint64_t value);
+		static uint64_t bucketUpperBound(size_t bucket);
+
+	private:
+		std::array<std::atomic<uint64_t>, BucketCount> buckets_{};
+		std::atomic<uint64_t> count_{ 0 };
+		std::atomic<uint64_t> sum_{ 0 };
+		std::atomic<uint64_t> max_{ 0 };
+	}; // end of class Histogram
+
+	struct HistogramSummary
+	{
+		uint64_t count = 0;
+		double mean = 0;
+		uint64_t p50 = 0;
+		uint64_t p90 = 0;
+		uint64_t p99 = 0;
+		uint64_t max = 0;
+	}; // end of struct HistogramSummary
+
+	HistogramSummary summarize(const Histogram& histogram);
+
+	// A statement that ran for at least the slow-query threshold (owns its copies)
+	struct SlowQuery
+	{
+		std::string sql;
+		std::vector<ColumnValue> params;
+		std::chrono::nanoseconds duration{ 0 };
+		int64_t rows = 0;
+	}; // end of struct SlowQuery
+
+	// Durations in nanoseconds; counters since construction (or reset())
+	struct MetricsSnapshot
+	{
+		uint64_t statements = 0;
+		uint64_t failedStatements = 0;
+		uint64_t rows = 0;
+		uint64_t busyRetries = 0;
+		uint64_t statementCacheHits = 0;
+		uint64_t statementCacheMisses = 0;
+		uint64_t schemaLookups = 0;
+		uint64_t schemaRefreshes = 0;
+		uint64_t slowQueries = 0;
+		HistogramSummary statementTime;
+		HistogramSummary prepareTime;
+		HistogramSummary stepTime;
+		HistogramSummary decodeTime;
+		HistogramSummary rowsPerStatement;
+
+		uint64_t poolAcquisitions = 0;
+		uint64_t poolWaits = 0;  // Acquisitions that blocked
+		size_t poolInUse = 0;    // As of the last acquisition
+		size_t poolOpen = 0;
+		HistogramSummary poolWaitTime;
+
+		uint64_t tasks = 0;
+		size_t queueDepth = 0;   // As of the last task start
+		size_t maxQueueDepth = 0;
+		HistogramSummary taskQueueTime;
+		HistogramSummary taskRunTime;
+
+		uint64_t checkpoints = 0;
+		uint64_t failedCheckpoints = 0;
+		uint64_t checkpointedFrames = 0;
+		int walFrames = 0;       // Frames in the WAL at the last checkpoint
+		HistogramSummary checkpointTime;
+	}; // end of struct MetricsSnapshot
+
+	// ============================================================================
+	// MetricsRegistry - Built-in MetricsSink backed by lock-free histograms
+	// ============================================================================
+
+	class MetricsRegistry : public MetricsSink
+	{
+	public:
+		using SlowQueryHook = std::function<void(const SlowQuery&)>;
+
+		MetricsRegistry() = default;
+
+		// Call hook for every statement taking at least threshold. Set it before
+		// the registry is attached; the hook runs on the statement's thread.
+		void setSlowQueryHook(std::chrono::nanoseconds threshold, SlowQueryHook hook);
+
+		void onStatement(const StatementMetrics& statement) override;
+		void onSchemaLookup(bool refreshed) override;
+		void onPoolAcquire(const PoolAcquireMetrics& acquire) override;
+		void onTask(const TaskMetrics& task) override;
+		void onCheckpoint(const CheckpointMetrics& checkpoint) override;
+
+		MetricsSnapshot snapshot() const;
+		void reset();
+
+		const Histogram& statementTime() const { return statementTime_; }
+		const Histogram& poolWaitTime() const { return poolWaitTime_; }
+		const Histogram& taskQueueTime() const { return taskQueueTime_; }
+
+	private:
+		std::atomic<uint64_t> statements_{ 0 };
+		std::atomic<uint64_t> failedStatements_{ 0 };
+		std::atomic<uint64_t> rows_{ 0 };
+		std::atomic<uint64_t> busyRetries_{ 0 };
+		std::atomic<uint64_t> statementCacheHits_{ 0 };
+		std::atomic<uint64_t> statementCacheMisses_{ 0 };
+		std::atomic<uint64_t> schemaLookups_{ 0 };
+		std::atomic<uint64_t> schemaRefreshes_{ 0 };
+		std::atomic<uint64_t> slowQueries_{ 0 };
+		Histogram statementTime_;
+		Histogram prepareTime_;
+		Histogram stepTime_;
+		Histogram decodeTime_;
+		Histogram rowsPerStatement_;
+
+		std::atomic<uint64_t> poolAcquisitions_{ 0 };
+		std::atomic<uint64_t> poolWaits_{ 0 };
+		std::atomic<size_t> poolInUse_{ 0 };
+		std::atomic<size_t> poolOpen_{ 0 };
+		Histogram poolWaitTime_;
+
+		std::atomic<uint64_t> tasks_{ 0 };
+		std::atomic<size_t> queueDepth_{ 0 };
+		std::atomic<size_t> maxQueueDepth_{ 0 };
+		Histogram taskQueueTime_;
+		Histogram taskRunTime_;
+
+		std::atomic<uint64_t> checkpoints_{ 0 };
+		std::atomic<uint64_t> failedCheckpoints_{ 0 };
+		std::atomic<uint64_t> checkpointedFrames_{ 0 };
+		std::atomic<int> walFrames_{ 0 };
+		Histogram checkpointTime_;
+
+		std::chrono::nanoseconds slowThreshold_{ 0 };
+		SlowQueryHook slowQueryHook_;
+	}; // end of class MetricsRegistry
+
+} // namespace sqlite_flux
@@ -0,0 +1,106 @@
+// include/ParallelScan.h
+#pragma once
+
+#include "ConnectionPool.h"
+#include "AsyncExecutor.h"
+#include "QueryBuilder.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sqlite_flux
+{
+
+	struct ParallelScanOptions
+	{
+		// Key ranges scanned at once (0 = one per worker of the ThreadPool, plus the caller)
+		size_t partitions = 0;
+
+		// Key the table is split on: rowid or the table's INTEGER PRIMARY KEY (the
+		// only columns guaranteed to hold integers); empty picks the latter if any
+		std::string keyColumn;
+
+		// Start every partition's read transaction on the same database version
+		bool pinSnapshot = true;
+
+		// How long to wait for each connection after the first; partitions that
+		// cannot get one are folded into the ones that did
+		std::chrono::milliseconds acquireTimeout{ 50 };
+	}; // end of struct ParallelScanOptions
+
+	// One key range, inclusive at both ends
+	struct ScanPartition
+	{
+		size_t index = 0;
+		int64_t firstKey = 0;
+		int64_t lastKey = 0;
+	}; // end of struct ScanPartition
+
+	// ============================================================================
+	// ParallelScan - One filtered table scan split across pooled connections
+	// ============================================================================
+	//
+	// Splits the table's integer key range [min, max] into equal-width ranges and
+	// runs the same query on each with its own pooled read connection, the caller
+	// taking one range and the ThreadPool the rest:
+	//
+	//   auto rows = ParallelScan(pool, threads, "events")
+	//       .Columns({ "id", "kind", "payload" })
+	//       .Filter("kind", std::string("click"))
+	//       .Execute();
+	//
+	// With pinSnapshot, the partitions are the connections of one ReadSession,
+	// so all of them see the same committed version even as writers carry on.
+	// Keys are rowids, so every row falls in exactly one range; sparse keys only
+	// make the ranges uneven.
+	//
+	// Not thread-safe: use one ParallelScan per scan. Do not run it on a worker of
+	// the same ThreadPool; it waits for the partitions it hands to that pool.
+
+	class ParallelScan
+	{
+	public:
+		// Called once per partition, concurrently, on the thread that scans it
+		using PartitionCallback = std::function<void(const ScanPartition&, Cursor&)>;
+
+		ParallelScan(ConnectionPool& pool, ThreadPool& threads, std::string tableName,
+			const ParallelScanOptions& options = {});
+
+		// Selected columns (default *)
+		ParallelScan& Columns(std::vector<std::string> columns);
+
+		// Filters shared by every partition (ANDed, like QueryBuilder::Filter)
+		ParallelScan& Filter(const std::string& column_, const ColumnValue& value_, CompareOp op_ = CompareOp::Equal);
+
+		// Every matching row, in key order; throws the first partition's error
+		ResultSet Execute();
+
+		// Stream each partition to fn instead of collecting rows
+		void Stream(const PartitionCallback& fn);
+
+		// SQL run by every partition; the last two ? are its key range
+		std::string buildSql() const;
+
+		// Partitions the last run was split into
+		const std::vector<ScanPartition>& partitions() const { return partitions_; }
+
+	private:
+		size_t partitionTarget() const;
+		void planPartitions(Analyzer& conn, size_t count);
+
+		ConnectionPool& pool_;
+		ThreadPool& threads_;
+		std::string tableName_;
+		ParallelScanOptions options_;
+		std::shared_ptr<const TableDescriptor> table_;
+		std::string keyColumn_;
+
+		std::vector<std::string> selectedColumns_;
+		std::vector<FilterCondition> filters_;
+		std::vector<ScanPartition> partitions_;
+	}; // end of class ParallelScan
+
+} // namespace sqlite_flux
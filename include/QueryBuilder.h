@@ -1,11 +1,16 @@
 #pragma once
 
 #include "Analyzer.h"
+#include "Cursor.h"
+#include "RowMapping.h"
 #include "TableTypes.h"
 #include "ColumnValue.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
 
 namespace sqlite_flux
 {
@@ -26,6 +31,24 @@ namespace sqlite_flux
         In
     };
 
+    // SQL spelling of an operator; constexpr so fixed query shapes can use it
+    // at compile time (see FixedQuery.h)
+    constexpr std::string_view compareOpSql(CompareOp op_)
+    {
+        switch (op_)
+        {
+        case CompareOp::Equal:              return "=";
+        case CompareOp::NotEqual:           return "!=";
+        case CompareOp::LessThan:           return "<";
+        case CompareOp::LessThanOrEqual:    return "<=";
+        case CompareOp::GreaterThan:        return ">";
+        case CompareOp::GreaterThanOrEqual: return ">=";
+        case CompareOp::Like:               return "LIKE";
+        case CompareOp::In:                 return "IN";
+        default:                            return "=";
+        }
+    }
+
     // ============================================================================
     // FilterCondition - Represents a single WHERE condition
     // ============================================================================
@@ -38,6 +61,7 @@ namespace sqlite_flux
 
         FilterCondition(const std::string& col, const ColumnValue& val, CompareOp operation = CompareOp::Equal);
 
+        // SQL fragment with a ? placeholder; value_ is bound separately
         std::string toSql() const;
     };
 
@@ -65,35 +89,68 @@ namespace sqlite_flux
         QueryBuilder& Limit(int limit);
         QueryBuilder& Offset(int offset);
 
+        // Keyset pagination: rows strictly after lastValue in OrderBy() order, so
+        // a deep page costs an index seek instead of skipping `offset` rows.
+        // Orders by column (ascending) unless OrderBy() already named it; pass the
+        // last row's value of the previous page. column should be unique (e.g.
+        // the primary key), otherwise rows tied with lastValue are skipped.
+        QueryBuilder& After(const std::string& column_, const ColumnValue& lastValue);
+
         // Execution methods
         ResultSet Execute();
         std::optional<Row> ExecuteFirst();
 
+        // Execute into positional storage (no per-row hash map)
+        ResultTable ExecuteTable();
+
+        // Execute into positional storage backed by one arena (see Analyzer::queryArena)
+        ArenaResultTable ExecuteArena();
+
+        // Stream rows lazily (constant memory); throws if the query fails to prepare
+        Cursor Stream();
+
+        // First column of the first row, read straight off the statement;
+        // nullopt if there is no row or the value is not a T
         template<typename T>
         std::optional<T> ExecuteScalar();
 
+        // Decode rows straight into T using RowMapping<T> (see RowMapping.h).
+        // Selects exactly the mapped columns, in mapping order, so each member is
+        // read from a column index fixed at compile time; Columns() is ignored.
+        template<typename T>
+        std::vector<T> ExecuteAs();
+
+        // Rows matching the filters (including After()); ignores ordering and paging
         int64_t Count();
+
+        // SELECT EXISTS(...): stops at the first matching row
         bool Any();
 
-        // SQL generation (for debugging)
+        // SQL generation (for debugging) - values appear as ? placeholders
         std::string buildSql() const;
 
+        // Values bound to the placeholders of buildSql(), in order
+        std::vector<ColumnValue> buildParams() const;
+
     private:
         Analyzer& analyzer_;
         std::string tableName_;
-        TableSchema schema_;
+        std::shared_ptr<const TableDescriptor> table_;  // Shared with every builder on this table
         std::vector<std::string> selectedColumns_;
         std::vector<FilterCondition> filters_;
         std::string orderByColumn_;
         bool orderAscending_ = true;
         int limitValue_ = -1;
         int offsetValue_ = -1;
+        std::string afterColumn_;
+        ColumnValue afterValue_;
+
+        // " FROM table WHERE ..." shared by every query shape
+        void appendFromWhere(std::ostringstream& sql) const;
 
         // Validation helpers
         void validateColumn(const std::string& column_) const;
         void validateColumnType(const std::string& column_, const ColumnValue& value_) const;
-        std::string getSqliteType(const std::string& column_) const;
-        bool isTypeCompatible(const std::string& sqliteType, const ColumnValue& value_) const;
     };
 
     // ============================================================================
@@ -151,17 +208,13 @@ namespace sqlite_flux
     template<typename T>
     std::optional<T> QueryBuilder::ExecuteScalar()
     {
-        auto results = Execute();
-
-        if (results.empty() || results[0].empty())
+        auto value = analyzer_.queryScalar(buildSql(), buildParams());
+        if (!value)
         {
             return std::nullopt;
         }
 
-        const auto& firstRow = results[0];
-        const auto& firstColumn = firstRow.begin()->second;
-
-        if (auto* val = std::get_if<T>(&firstColumn))
+        if (auto* val = std::get_if<T>(&*value))
         {
             return *val;
         }
@@ -169,4 +222,21 @@ namespace sqlite_flux
         return std::nullopt;
     }
 
+    template<typename T>
+    std::vector<T> QueryBuilder::ExecuteAs()
+    {
+        std::vector<std::string> columns = mappedColumns<T>();
+        for (const auto& col : columns)
+        {
+            validateColumn(col);
+        }
+
+        // Swap the mapped columns in just for SQL generation
+        std::swap(selectedColumns_, columns);
+        std::string sql = buildSql();
+        std::swap(selectedColumns_, columns);
+
+        return detail::readAllPositional<T>(analyzer_, sql, buildParams());
+    }
+
 } // namespace sqlite_flux
\ No newline at end of file
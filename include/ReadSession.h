@@ -0,0 +1,157 @@
+// include/ReadSession.h
+#pragma once
+
+#include "ConnectionPool.h"
+#include "AsyncExecutor.h"
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sqlite_flux
+{
+
+	struct ReadSessionOptions
+	{
+		// Pooled read connections pinned together (at least one)
+		size_t connections = 1;
+
+		// How long to wait for each connection after the first; a busy pool
+		// gives a narrower session rather than blocking
+		std::chrono::milliseconds acquireTimeout{ 50 };
+
+		// Start every connection on the same database version. Off, each one
+		// reads whatever was committed last when its transaction started.
+		bool pinSnapshot = true;
+	}; // end of struct ReadSessionOptions
+
+	// ============================================================================
+	// ReadSession - Pooled read connections held at one committed version
+	// ============================================================================
+	//
+	// Each connection sits in a deferred read transaction for the session's
+	// lifetime, so every query through the session, on any of its connections,
+	// sees the same snapshot however many writes commit meanwhile:
+	//
+	//   ReadSession session(pool, { .connections = 3 });
+	//   auto totals = session.submit(threads, [](Analyzer& db) { return db.query(totalsSql); });
+	//   auto recent = session.submit(threads, [](Analyzer& db) { return db.query(recentSql); });
+	//   ResultSet users = QueryBuilder(*session.lease(), "users").Execute();
+	//
+	// With pinSnapshot and more than one connection, the first connection's
+	// snapshot is opened on the others (sqlite3_snapshot_open) when built with
+	// SQLITE_ENABLE_SNAPSHOT. Otherwise, or if that fails (not in WAL mode),
+	// the session holds BEGIN IMMEDIATE on the pool's writer while the
+	// transactions start, so writers wait for that handshake only.
+	//
+	// A long session keeps the checkpointer from recycling the WAL behind it;
+	// keep sessions to a request. Leases and submit() are thread-safe.
+	// operator[] hands out a connection without leasing it: do not mix the two
+	// (ParallelScan uses operator[] with one thread per connection).
+
+	class ReadSession
+	{
+	public:
+		// One of the session's connections, exclusive to its holder
+		class Lease
+		{
+		public:
+			Lease(ReadSession* session, size_t index);
+			~Lease();
+
+			// Disable copy, enable move
+			Lease(const Lease&) = delete;
+			Lease& operator=(const Lease&) = delete;
+			Lease(Lease&& other) noexcept;
+			Lease& operator=(Lease&& other) noexcept;
+
+			Analyzer* operator->() { return &(*session_)[index_]; }
+			Analyzer& operator*() { return (*session_)[index_]; }
+
+		private:
+			void release();
+
+			ReadSession* session_;
+			size_t index_;
+		}; // end of class Lease
+
+		// Throws if no read transaction can be started
+		explicit ReadSession(ConnectionPool& pool, const ReadSessionOptions& options = {});
+
+		// Waits for leases and submitted tasks, then ends the read transactions
+		~ReadSession();
+
+		// Disable copy and move
+		ReadSession(const ReadSession&) = delete;
+		ReadSession& operator=(const ReadSession&) = delete;
+		ReadSession(ReadSession&&) = delete;
+		ReadSession& operator=(ReadSession&&) = delete;
+
+		// Connections actually held (may be fewer than requested)
+		size_t width() const { return conns_.size(); }
+
+		// True if the connections were pinned through sqlite3_snapshot_open
+		// rather than by holding the write lock
+		bool usesSharedSnapshot() const { return sharedSnapshot_; }
+
+		// Unleased access; the caller keeps each connection to one thread at a time
+		Analyzer& operator[](size_t index) { return *conns_[index]; }
+
+		// Blocks until one of the connections is free
+		Lease lease();
+
+		// Run fn(Analyzer&) on threads against a leased connection. Tasks beyond
+		// width() queue for a lease, so do not wait on one while holding a Lease.
+		template<typename F>
+		auto submit(ThreadPool& threads, F fn) -> std::future<std::invoke_result_t<F&, Analyzer&>>;
+
+	private:
+		// Counts a submitted task until its closure is destroyed, so a task the
+		// ThreadPool drops without running still lets the session close
+		class PendingTask
+		{
+		public:
+			explicit PendingTask(ReadSession* session) : session_(session) { session_->beginTask(); }
+			PendingTask(PendingTask&& other) noexcept : session_(std::exchange(other.session_, nullptr)) {}
+			PendingTask(const PendingTask&) = delete;
+			PendingTask& operator=(const PendingTask&) = delete;
+			PendingTask& operator=(PendingTask&&) = delete;
+			~PendingTask() { if (session_) session_->endTask(); }
+
+		private:
+			ReadSession* session_;
+		}; // end of class PendingTask
+
+		void acquireConnections();
+		void begin();
+		bool startRead(Analyzer& conn, std::string& error);
+		void endReads(size_t count);
+		void beginTask();
+		void endTask();
+		void release(size_t index);
+
+		ConnectionPool& pool_;
+		ReadSessionOptions options_;
+		std::vector<ConnectionPool::Connection> conns_;
+		bool sharedSnapshot_ = false;
+
+		std::mutex mutex_;
+		std::condition_variable cv_;
+		std::vector<size_t> free_;  // Indices of unleased connections
+		size_t pendingTasks_ = 0;
+	}; // end of class ReadSession
+
+	template<typename F>
+	auto ReadSession::submit(ThreadPool& threads, F fn) -> std::future<std::invoke_result_t<F&, Analyzer&>>
+	{
+		PendingTask pending(this);
+		return threads.enqueue([this, pending = std::move(pending), fn = std::move(fn)]() mutable {
+			Lease conn = lease();
+			return fn(*conn);
+			});
+	} // end of submit
+
+} // namespace sqlite_flux
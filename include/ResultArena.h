@@ -0,0 +1,98 @@
+// include/ResultArena.h
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace sqlite_flux
+{
+
+	struct ResultArenaOptions
+	{
+		// Block each arena starts with
+		size_t initialBytes = 16 * 1024;
+
+		// An arena that overflowed its block grows it on reset() to the size it
+		// needed, up to this; bigger results spill to the heap every time
+		size_t maxRetainedBytes = 1024 * 1024;
+
+		// Idle arenas a ResultArenaPool keeps for reuse
+		size_t maxIdleArenas = 4;
+	}; // end of struct ResultArenaOptions
+
+	// ============================================================================
+	// ResultArena - Monotonic memory for one result at a time
+	// ============================================================================
+	//
+	// Allocations are carved out of one retained block (overflow comes from the
+	// heap in growing chunks) and individual frees are no-ops; reset() drops
+	// everything at once. Not thread-safe: one result fills it at a time.
+
+	class ResultArena : public std::pmr::memory_resource
+	{
+	public:
+		explicit ResultArena(size_t initialBytes = ResultArenaOptions{}.initialBytes,
+			size_t maxRetainedBytes = ResultArenaOptions{}.maxRetainedBytes);
+
+		ResultArena(const ResultArena&) = delete;
+		ResultArena& operator=(const ResultArena&) = delete;
+
+		// Free everything allocated since the last reset
+		void reset();
+
+		// Bytes handed out since the last reset
+		size_t bytesAllocated() const { return allocated_; }
+
+		// Size of the retained block
+		size_t retainedBytes() const { return capacity_; }
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void* /*p*/, size_t /*bytes*/, size_t /*alignment*/) override {}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		std::unique_ptr<std::byte[]> block_;
+		size_t capacity_;
+		size_t maxRetained_;
+		size_t allocated_ = 0;
+		std::optional<std::pmr::monotonic_buffer_resource> resource_;
+	}; // end of class ResultArena
+
+	// ============================================================================
+	// ResultArenaPool - Recycles arenas between results
+	// ============================================================================
+	//
+	// acquire() hands out an idle arena (or a new one); when the last owner of
+	// the returned pointer lets go, the arena is reset and goes back to the pool,
+	// from whichever thread that happens on. Each Analyzer keeps its own pool,
+	// so threads on different pooled connections never share its lock.
+
+	class ResultArenaPool
+	{
+	public:
+		explicit ResultArenaPool(const ResultArenaOptions& options = {});
+
+		std::shared_ptr<ResultArena> acquire();
+
+		// Arenas waiting for reuse
+		size_t idle() const;
+
+		const ResultArenaOptions& getOptions() const { return state_->options; }
+
+	private:
+		// Outlives the pool while results still hold its arenas
+		struct State
+		{
+			ResultArenaOptions options;
+			mutable std::mutex mutex;
+			std::vector<std::unique_ptr<ResultArena>> idle;
+		}; // end of struct State
+
+		std::shared_ptr<State> state_;
+	}; // end of class ResultArenaPool
+
+} // namespace sqlite_flux
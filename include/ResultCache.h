@@ -0,0 +1,124 @@
+// include/ResultCache.h
+#pragma once
+
+#include "TableTypes.h"
+#include "ColumnValue.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace sqlite_flux
+{
+
+	struct ResultCacheOptions
+	{
+		// Upper bound on the estimated size of all cached results
+		size_t maxBytes = 16 * 1024 * 1024;
+
+		// Results estimated larger than this are never cached (0 = maxBytes / 4)
+		size_t maxEntryBytes = 0;
+	}; // end of struct ResultCacheOptions
+
+	struct ResultCacheStats
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t insertions = 0;
+		uint64_t evictions = 0;      // Dropped to stay under maxBytes
+		uint64_t invalidations = 0;  // Dropped because a table they read changed
+		uint64_t rejected = 0;       // Not stored: too large, or a table changed mid-query
+		size_t bytes = 0;
+		size_t entries = 0;
+	}; // end of struct ResultCacheStats
+
+	// ============================================================================
+	// ResultCache - Byte-bounded LRU of query results, invalidated per table
+	// ============================================================================
+	//
+	// Attach one to an Analyzer (or to every connection of a pool through
+	// PoolOptions::resultCache) and Analyzer::query() - hence QueryBuilder::Execute()
+	// - answers repeated read-only statements from memory. Entries are keyed by
+	// whitespace-normalized SQL plus the bound values and remember the tables the
+	// statement read; any write to one of those tables through a connection that
+	// shares the cache drops them. Writes from other processes, or from
+	// connections without the cache, are not seen.
+	//
+	// Thread-safe; one mutex guards the whole cache.
+
+	class ResultCache
+	{
+	public:
+		explicit ResultCache(const ResultCacheOptions& options = {});
+
+		ResultCache(const ResultCache&) = delete;
+		ResultCache& operator=(const ResultCache&) = delete;
+
+		// Cache key for sql with params bound
+		static std::string makeKey(std::string_view sql, std::span<const ColumnValue> params);
+
+		// Cached results for key (marked most recently used), or null
+		std::shared_ptr<const ResultSet> lookup(const std::string& key);
+
+		// Take before running the query a result will be stored for
+		uint64_t epoch() const;
+
+		// Store results read from tables. Dropped if any of them was invalidated
+		// since startEpoch, so a write racing with the query cannot be masked.
+		void insert(std::string key, ResultSet results, const std::vector<std::string>& tables,
+			uint64_t startEpoch);
+
+		// Drop every entry that read tableName
+		void invalidateTable(const std::string& tableName);
+
+		// Drop everything (e.g. after DDL)
+		void clear();
+
+		ResultCacheStats getStats() const;
+		const ResultCacheOptions& getOptions() const { return options_; }
+
+		// Estimated heap footprint of results
+		static size_t estimateBytes(const ResultSet& results);
+
+	private:
+		struct Entry
+		{
+			std::string key;
+			std::shared_ptr<const ResultSet> results;
+			std::vector<std::string> tables;
+			size_t bytes = 0;
+		}; // end of struct Entry
+
+		using EntryList = std::list<Entry>;
+
+		void erase(EntryList::iterator it);  // Requires mutex_
+
+		ResultCacheOptions options_;
+
+		mutable std::mutex mutex_;
+		EntryList lru_;  // Front is the most recently used
+		std::unordered_map<std::string_view, EntryList::iterator> index_;
+		std::unordered_map<std::string, std::unordered_set<Entry*>> byTable_;
+
+		// Epoch of each table's last invalidation; clear() counts for every table
+		uint64_t epoch_ = 0;
+		uint64_t clearedAt_ = 0;
+		std::unordered_map<std::string, uint64_t> invalidatedAt_;
+
+		size_t bytes_ = 0;
+		uint64_t hits_ = 0;
+		uint64_t misses_ = 0;
+		uint64_t insertions_ = 0;
+		uint64_t evictions_ = 0;
+		uint64_t invalidations_ = 0;
+		uint64_t rejected_ = 0;
+	}; // end of class ResultCache
+
+} // namespace sqlite_flux
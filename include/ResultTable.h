@@ -0,0 +1,158 @@
+// include/ResultTable.h
+#pragma once
+
+#include "TableTypes.h"
+#include "ColumnValue.h"
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iterator>
+#include <cstddef>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// ResultHeader - Column names shared by every row of a ResultTable
+	// ============================================================================
+
+	struct ResultHeader
+	{
+		std::vector<std::string> names;
+		std::unordered_map<std::string, size_t> index;  // name -> position
+
+		explicit ResultHeader(std::vector<std::string> columnNames);
+
+		std::optional<size_t> find(const std::string& name) const;
+	}; // end of struct ResultHeader
+
+	// ============================================================================
+	// ResultTable - Positional result storage (one flat cell vector, row-major)
+	// ============================================================================
+
+	class ResultTable
+	{
+	public:
+		// Lightweight view of one row; valid while the table is alive
+		class RowRef
+		{
+		public:
+			RowRef(const ResultTable* table, size_t row) : table_(table), row_(row) {}
+
+			// Positional access (no bounds check)
+			const ColumnValue& operator[](size_t col) const { return table_->cell(row_, col); }
+
+			// Name access (throws std::out_of_range for unknown columns)
+			const ColumnValue& operator[](const std::string& column_) const { return table_->at(row_, column_); }
+
+			// Type-safe extraction, std::nullopt on NULL/type mismatch
+			template<typename T>
+			std::optional<T> get(size_t col) const;
+
+			template<typename T>
+			std::optional<T> get(const std::string& column_) const;
+
+			size_t size() const { return table_->columnCount(); }
+			size_t index() const { return row_; }
+
+			// Materialize as a name-keyed Row (compatibility)
+			Row toRow() const;
+
+		private:
+			const ResultTable* table_;
+			size_t row_;
+		}; // end of class RowRef
+
+		class const_iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = RowRef;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = RowRef;
+
+			const_iterator() = default;
+			const_iterator(const ResultTable* table, size_t row) : table_(table), row_(row) {}
+
+			RowRef operator*() const { return RowRef(table_, row_); }
+			const_iterator& operator++() { ++row_; return *this; }
+			const_iterator operator++(int) { auto copy = *this; ++row_; return copy; }
+			bool operator==(const const_iterator& other) const { return row_ == other.row_; }
+			bool operator!=(const const_iterator& other) const { return row_ != other.row_; }
+
+		private:
+			const ResultTable* table_ = nullptr;
+			size_t row_ = 0;
+		}; // end of class const_iterator
+
+		ResultTable() = default;
+		ResultTable(std::shared_ptr<const ResultHeader> header, std::vector<ColumnValue> cells);
+
+		// Shape
+		size_t size() const { return rowCount(); }
+		size_t rowCount() const;
+		size_t columnCount() const { return header_ ? header_->names.size() : 0; }
+		bool empty() const { return cells_.empty(); }
+
+		// Column metadata
+		const std::vector<std::string>& columnNames() const;
+		std::optional<size_t> columnIndex(const std::string& column_) const;
+		const std::shared_ptr<const ResultHeader>& header() const { return header_; }
+
+		// Cell access
+		const ColumnValue& cell(size_t row, size_t col) const { return cells_[row * columnCount() + col]; }
+		const ColumnValue& at(size_t row, size_t col) const;                    // bounds-checked
+		const ColumnValue& at(size_t row, const std::string& column_) const;    // bounds-checked
+
+		RowRef operator[](size_t row) const { return RowRef(this, row); }
+
+		const_iterator begin() const { return const_iterator(this, 0); }
+		const_iterator end() const { return const_iterator(this, rowCount()); }
+
+		// Raw row-major storage
+		const std::vector<ColumnValue>& cells() const { return cells_; }
+
+		// Compatibility adapter to the map-based ResultSet
+		ResultSet toResultSet() const;
+
+	private:
+		std::shared_ptr<const ResultHeader> header_;
+		std::vector<ColumnValue> cells_;
+	}; // end of class ResultTable
+
+	// ============================================================================
+	// Template implementations
+	// ============================================================================
+
+	template<typename T>
+	std::optional<T> ResultTable::RowRef::get(size_t col) const
+	{
+		if (auto* val = std::get_if<T>(&(*this)[col]))
+		{
+			return *val;
+		} // end of if
+		return std::nullopt;
+	} // end of get
+
+	template<typename T>
+	std::optional<T> ResultTable::RowRef::get(const std::string& column_) const
+	{
+		auto col = table_->columnIndex(column_);
+		if (!col)
+		{
+			return std::nullopt;
+		} // end of if
+		return get<T>(*col);
+	} // end of get
+
+	// getValue() overload so code written against Row works with RowRef
+	template<typename T>
+	std::optional<T> getValue(const ResultTable::RowRef& row, const std::string& key)
+	{
+		return row.get<T>(key);
+	} // end of getValue
+
+} // namespace sqlite_flux
\ No newline at end of file
@@ -0,0 +1,200 @@
+// include/RowMapping.h
+#pragma once
+
+#include "Cursor.h"
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// RowMapping - Declare once how a struct maps onto result columns
+	// ============================================================================
+	//
+	// Specialize RowMapping<T> with a static constexpr tuple of column() bindings:
+	//
+	//   struct User { int64_t id; std::string name; std::optional<double> score; };
+	//
+	//   template<> struct sqlite_flux::RowMapping<User>
+	//   {
+	//       static constexpr auto columns = std::make_tuple(
+	//           sqlite_flux::column("id", &User::id),
+	//           sqlite_flux::column("name", &User::name),
+	//           sqlite_flux::column("score", &User::score));
+	//   };
+	//
+	// Rows are then decoded straight from the statement into T, with no Row map
+	// and no ColumnValue in between (see QueryBuilder::ExecuteAs and readAll).
+	// Supported members: integral types and bool, floating point, std::string,
+	// std::vector<uint8_t>, ColumnValue and std::optional of any of these (NULL
+	// becomes nullopt; for the others NULL reads as 0 / empty). Values are
+	// converted the way sqlite3_column_* converts them.
+
+	template<typename T>
+	struct RowMapping;
+
+	template<typename T, typename M>
+	struct ColumnBinding
+	{
+		const char* name;
+		M T::* member;
+	}; // end of struct ColumnBinding
+
+	template<typename T, typename M>
+	constexpr ColumnBinding<T, M> column(const char* name, M T::* member)
+	{
+		return { name, member };
+	} // end of column
+
+	namespace detail
+	{
+
+		template<typename T>
+		struct IsOptional : std::false_type {};
+
+		template<typename U>
+		struct IsOptional<std::optional<U>> : std::true_type {};
+
+		template<typename>
+		inline constexpr bool UnsupportedMember = false;
+
+		template<typename T>
+		inline constexpr size_t MappedColumnCount =
+			std::tuple_size_v<std::remove_cvref_t<decltype(RowMapping<T>::columns)>>;
+
+		template<typename M>
+		void readField(const RowView& row, size_t col, M& out)
+		{
+			if constexpr (IsOptional<M>::value)
+			{
+				if (row.isNull(col))
+				{
+					out.reset();
+				} // end of if
+				else
+				{
+					readField(row, col, out.emplace());
+				} // end of else
+			} // end of if constexpr
+			else if constexpr (std::is_same_v<M, bool>)
+			{
+				out = row.getInt64(col) != 0;
+			} // end of else if constexpr
+			else if constexpr (std::is_integral_v<M>)
+			{
+				out = static_cast<M>(row.getInt64(col));
+			} // end of else if constexpr
+			else if constexpr (std::is_floating_point_v<M>)
+			{
+				out = static_cast<M>(row.getDouble(col));
+			} // end of else if constexpr
+			else if constexpr (std::is_same_v<M, std::string>)
+			{
+				std::string_view text = row.text(col);
+				out.assign(text.data(), text.size());
+			} // end of else if constexpr
+			else if constexpr (std::is_same_v<M, std::vector<uint8_t>>)
+			{
+				std::span<const uint8_t> blob = row.blob(col);
+				out.assign(blob.begin(), blob.end());
+			} // end of else if constexpr
+			else if constexpr (std::is_same_v<M, ColumnValue>)
+			{
+				out = row.value(col);
+			} // end of else if constexpr
+			else
+			{
+				static_assert(UnsupportedMember<M>, "RowMapping member type has no column decoder");
+			} // end of else
+		} // end of readField
+
+		// Binding I reads result column I (the SELECT list was generated from the mapping)
+		template<typename T, size_t... I>
+		void readPositional(const RowView& row, T& out, std::index_sequence<I...>)
+		{
+			(readField(row, I, out.*(std::get<I>(RowMapping<T>::columns).member)), ...);
+		} // end of readPositional
+
+		// Binding I reads result column index[I], resolved once per statement
+		template<typename T, size_t... I>
+		void readIndexed(const RowView& row, const std::array<size_t, sizeof...(I)>& index, T& out,
+			std::index_sequence<I...>)
+		{
+			(readField(row, index[I], out.*(std::get<I>(RowMapping<T>::columns).member)), ...);
+		} // end of readIndexed
+
+		// Runs sql on a cached statement of analyzer (sql selects the mapped columns in order)
+		template<typename T>
+		std::vector<T> readAllPositional(const Analyzer& analyzer, std::string_view sql,
+			std::span<const ColumnValue> params)
+		{
+			constexpr auto bindings = std::make_index_sequence<MappedColumnCount<T>>{};
+
+			std::vector<T> result;
+			bool ok = analyzer.forEachRow(sql, params, [&result, bindings](const RowView& row) {
+				readPositional(row, result.emplace_back(), bindings);
+				}, MappedColumnCount<T>);
+
+			if (!ok)
+			{
+				throw std::runtime_error("Query failed: " + analyzer.getLastError());
+			} // end of if
+
+			return result;
+		} // end of readAllPositional
+
+	} // namespace detail
+
+	// Column names of RowMapping<T>, in binding order
+	template<typename T>
+	std::vector<std::string> mappedColumns()
+	{
+		std::vector<std::string> names;
+		names.reserve(detail::MappedColumnCount<T>);
+		std::apply([&names](const auto&... binding) { (names.emplace_back(binding.name), ...); },
+			RowMapping<T>::columns);
+		return names;
+	} // end of mappedColumns
+
+	// Decode every remaining row of cursor into T. Mapped columns are looked up by
+	// name once, so the SELECT list may be in any order and contain extra columns;
+	// throws std::runtime_error if a mapped column is missing or the step fails.
+	template<typename T>
+	std::vector<T> readAll(Cursor& cursor)
+	{
+		constexpr size_t count = detail::MappedColumnCount<T>;
+
+		std::array<size_t, count> index{};
+		std::vector<std::string> names = mappedColumns<T>();
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto col = cursor.columnIndex(names[i]);
+			if (!col)
+			{
+				throw std::runtime_error("Mapped column '" + names[i] + "' is not in the result");
+			} // end of if
+			index[i] = *col;
+		} // end of for
+
+		std::vector<T> result;
+		while (cursor.next())
+		{
+			detail::readIndexed(cursor.view(), index, result.emplace_back(), std::make_index_sequence<count>{});
+		} // end of while
+
+		if (cursor.hasError())
+		{
+			throw std::runtime_error("Query failed: " + cursor.getLastError());
+		} // end of if
+
+		return result;
+	} // end of readAll
+
+} // namespace sqlite_flux
@@ -0,0 +1,69 @@
+// include/RowView.h
+#pragma once
+
+#include "ColumnValue.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// Forward declaration to avoid including sqlite3.h in header
+struct sqlite3_stmt;
+
+namespace sqlite_flux
+{
+
+	// Storage class of a column in the current row
+	enum class ValueType
+	{
+		Null,
+		Integer,
+		Real,
+		Text,
+		Blob
+	}; // end of enum class ValueType
+
+	// ============================================================================
+	// RowView - Non-owning access to the current row of a live statement
+	// ============================================================================
+	//
+	// Handed out by Cursor::view() and Analyzer::forEachRow. text() and blob()
+	// point straight into SQLite's buffers: nothing is copied or allocated, and
+	// the views are only valid until the statement steps again (or is
+	// finalized). Reading a column as a different type converts it the way
+	// sqlite3_column_text/blob do, which invalidates earlier views of that column.
+	// Out-of-range columns read as NULL.
+
+	class RowView
+	{
+	public:
+		RowView() = default;
+
+		size_t size() const { return columnCount_; }
+		std::string_view columnName(size_t col) const;  // Empty when out of range
+
+		ValueType type(size_t col) const;
+		bool isNull(size_t col) const { return type(col) == ValueType::Null; }
+
+		int64_t getInt64(size_t col) const;
+		double getDouble(size_t col) const;
+		std::string_view text(size_t col) const;
+		std::span<const uint8_t> blob(size_t col) const;
+
+		// Owning copy, for the columns that have to outlive the row
+		ColumnValue value(size_t col) const;
+
+	private:
+		friend class Cursor;
+		friend class Analyzer;
+
+		RowView(sqlite3_stmt* stmt, size_t columnCount)
+			: stmt_(stmt), columnCount_(columnCount) {}
+
+		bool inRange(size_t col) const { return stmt_ && col < columnCount_; }
+
+		sqlite3_stmt* stmt_ = nullptr;
+		size_t columnCount_ = 0;
+	}; // end of class RowView
+
+} // namespace sqlite_flux
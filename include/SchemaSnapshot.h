@@ -0,0 +1,97 @@
+// include/SchemaSnapshot.h
+#pragma once
+
+#include "TableTypes.h"
+#include "TableDescriptor.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// SchemaSnapshot - Immutable view of every table's columns
+	// ============================================================================
+
+	struct SchemaSnapshot
+	{
+		// PRAGMA schema_version the tables were read at
+		int64_t schemaVersion = -1;
+		std::unordered_map<std::string, TableDescriptor> tables;
+
+		// Tables and views, keyed by their declared name
+		const TableDescriptor* find(const std::string& tableName) const
+		{
+			auto it = tables.find(tableName);
+			if (it != tables.end()) return &it->second;
+
+			// SQLite names are case-insensitive (ASCII); the exact spelling is the common case
+			auto sameName = [&tableName](const std::string& name) {
+				return name.size() == tableName.size() &&
+					std::equal(name.begin(), name.end(), tableName.begin(), [](char a, char b) {
+						return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+					});
+			};
+			for (const auto& [name, table] : tables)
+			{
+				if (sameName(name)) return &table;
+			} // end of for
+			return nullptr;
+		} // end of find
+	}; // end of struct SchemaSnapshot
+
+	// ============================================================================
+	// SharedSchema - The current SchemaSnapshot of one database file
+	// ============================================================================
+	//
+	// Shared by all connections to the file (a ConnectionPool hands one to each of
+	// its connections). Readers take the current snapshot with one atomic load and
+	// keep it alive for as long as they hold the shared_ptr. Before using it, each
+	// lookup reads PRAGMA schema_version on its own connection (under that
+	// connection's lock), so DDL from any connection or process is noticed. The
+	// connection that sees it move past the snapshot rebuilds and publishes it;
+	// the others pick the new one up on their next lookup.
+
+	class SharedSchema
+	{
+	public:
+		std::shared_ptr<const SchemaSnapshot> current() const
+		{
+			return snapshot_.load(std::memory_order_acquire);
+		} // end of current
+
+		// Ignored if a newer snapshot is already published (a connection inside an
+		// old read transaction can still see an older schema_version)
+		void publish(std::shared_ptr<const SchemaSnapshot> snapshot)
+		{
+			auto previous = snapshot_.load(std::memory_order_acquire);
+			if (previous && previous->schemaVersion > snapshot->schemaVersion) return;
+
+			snapshot_.store(std::move(snapshot), std::memory_order_release);
+			refreshes_.fetch_add(1, std::memory_order_relaxed);
+		} // end of publish
+
+		void invalidate()
+		{
+			snapshot_.store(nullptr, std::memory_order_release);
+		} // end of invalidate
+
+		// Held while rebuilding, so one DDL costs one rebuild rather than one per connection
+		std::mutex& refreshMutex() { return refreshMutex_; }
+
+		// Snapshots published so far
+		uint64_t refreshes() const { return refreshes_.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<std::shared_ptr<const SchemaSnapshot>> snapshot_;
+		std::mutex refreshMutex_;
+		std::atomic<uint64_t> refreshes_{ 0 };
+	}; // end of class SharedSchema
+
+} // namespace sqlite_flux
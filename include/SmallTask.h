@@ -0,0 +1,132 @@
+// include/SmallTask.h
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// SmallTask - Move-only void() callable with small-buffer storage
+	// ============================================================================
+	// Replaces std::function<void()> on the ThreadPool hot path: callables up to
+	// InlineSize bytes (a coroutine handle, a packaged_task, a few captured
+	// pointers) live inline, so submitting work does not allocate. Larger ones
+	// fall back to the heap. Unlike std::function, move-only callables are fine.
+
+	class SmallTask
+	{
+	public:
+		static constexpr size_t InlineSize = 48;
+
+		SmallTask() noexcept = default;
+
+		template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, SmallTask>>>
+		SmallTask(F&& f)
+		{
+			using Fn = std::decay_t<F>;
+			static_assert(std::is_invocable_v<Fn&>, "SmallTask requires a callable taking no arguments");
+
+			if constexpr (fitsInline<Fn>())
+			{
+				new (&storage_) Fn(std::forward<F>(f));
+				ops_ = &inlineOps<Fn>;
+			} // end of if constexpr
+			else
+			{
+				*reinterpret_cast<Fn**>(&storage_) = new Fn(std::forward<F>(f));
+				ops_ = &heapOps<Fn>;
+			} // end of else
+		} // end of constructor
+
+		SmallTask(SmallTask&& other) noexcept
+		{
+			moveFrom(other);
+		} // end of move constructor
+
+		SmallTask& operator=(SmallTask&& other) noexcept
+		{
+			if (this != &other)
+			{
+				reset();
+				moveFrom(other);
+			} // end of if
+			return *this;
+		} // end of move assignment
+
+		SmallTask(const SmallTask&) = delete;
+		SmallTask& operator=(const SmallTask&) = delete;
+
+		~SmallTask()
+		{
+			reset();
+		} // end of destructor
+
+		void operator()()
+		{
+			ops_->invoke(&storage_);
+		} // end of operator()
+
+		explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+	private:
+		struct Ops
+		{
+			void (*invoke)(void* storage);
+			void (*move)(void* dst, void* src) noexcept;  // Leaves src destroyed
+			void (*destroy)(void* storage) noexcept;
+		}; // end of struct Ops
+
+		template<typename Fn>
+		static constexpr bool fitsInline()
+		{
+			return sizeof(Fn) <= InlineSize
+				&& alignof(Fn) <= alignof(std::max_align_t)
+				&& std::is_nothrow_move_constructible_v<Fn>;
+		} // end of fitsInline
+
+		template<typename Fn>
+		static constexpr Ops inlineOps = {
+			[](void* storage) { (*std::launder(static_cast<Fn*>(storage)))(); },
+			[](void* dst, void* src) noexcept {
+				Fn* from = std::launder(static_cast<Fn*>(src));
+				new (dst) Fn(std::move(*from));
+				from->~Fn();
+			},
+			[](void* storage) noexcept { std::launder(static_cast<Fn*>(storage))->~Fn(); }
+		};
+
+		template<typename Fn>
+		static constexpr Ops heapOps = {
+			[](void* storage) { (**static_cast<Fn**>(storage))(); },
+			[](void* dst, void* src) noexcept { *static_cast<Fn**>(dst) = *static_cast<Fn**>(src); },
+			[](void* storage) noexcept { delete *static_cast<Fn**>(storage); }
+		};
+
+		void moveFrom(SmallTask& other) noexcept
+		{
+			if (other.ops_)
+			{
+				other.ops_->move(&storage_, &other.storage_);
+				ops_ = other.ops_;
+				other.ops_ = nullptr;
+			} // end of if
+		} // end of moveFrom
+
+		void reset() noexcept
+		{
+			if (ops_)
+			{
+				ops_->destroy(&storage_);
+				ops_ = nullptr;
+			} // end of if
+		} // end of reset
+
+		alignas(std::max_align_t) unsigned char storage_[InlineSize];
+		const Ops* ops_ = nullptr;
+	}; // end of class SmallTask
+
+} // namespace sqlite_flux
\ No newline at end of file
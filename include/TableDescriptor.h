@@ -0,0 +1,65 @@
+// include/TableDescriptor.h
+#pragma once
+
+#include "TableTypes.h"
+#include "ColumnValue.h"
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sqlite_flux
+{
+
+	// Type family a declared column type maps to (the builders' validation rules:
+	// INT; CHAR/CLOB/TEXT; BLOB; REAL/FLOA/DOUB; anything else is NUMERIC)
+	enum class ColumnAffinity
+	{
+		Integer,
+		Text,
+		Blob,
+		Real,
+		Numeric
+	}; // end of enum class ColumnAffinity
+
+	ColumnAffinity affinityOf(const std::string& declaredType);
+
+	// NULL is accepted by every affinity; NUMERIC takes integers and reals
+	bool acceptsValue(ColumnAffinity affinity, const ColumnValue& value_);
+
+	// ============================================================================
+	// TableDescriptor - One table's columns, indexed for validation
+	// ============================================================================
+	//
+	// Built once per table per SchemaSnapshot and shared (never copied) by every
+	// builder on that table: name lookups are one hash probe and type checks
+	// compare a precomputed affinity instead of re-parsing the declared type.
+
+	class TableDescriptor
+	{
+	public:
+		TableDescriptor(std::string name, TableSchema columns);
+
+		const std::string& name() const { return name_; }
+		const TableSchema& columns() const { return columns_; }
+		size_t size() const { return columns_.size(); }
+		bool empty() const { return columns_.empty(); }
+
+		std::optional<size_t> indexOf(const std::string& column_) const;
+		const ColumnInfo& column(size_t index) const { return columns_[index]; }
+		ColumnAffinity affinity(size_t index) const { return affinities_[index]; }
+
+		// Index of column_, or std::runtime_error naming the table
+		size_t require(const std::string& column_) const;
+
+		// require(), plus std::runtime_error if value_ does not fit the column's type
+		void validateValue(const std::string& column_, const ColumnValue& value_) const;
+
+	private:
+		std::string name_;
+		TableSchema columns_;
+		std::vector<ColumnAffinity> affinities_;
+		std::unordered_map<std::string, size_t> index_;
+	}; // end of class TableDescriptor
+
+} // namespace sqlite_flux
@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <vector>
 #include <string>
+#include <cstdint>
 
 namespace sqlite_flux 
 {
@@ -26,4 +27,15 @@ namespace sqlite_flux
 
 	using TableSchema = std::vector<ColumnInfo>;
 
+	// Outcome of a single DML statement, captured under the connection lock
+	struct ExecuteResult
+	{
+		bool success = false;
+		int64_t changes = 0;          // Rows changed by this statement
+		int64_t lastInsertRowid = 0;  // Connection's last insert rowid after this statement
+		std::string error;            // Error message when !success
+
+		explicit operator bool() const { return success; }
+	};
+
 } // namespace sqlite_flux
\ No newline at end of file
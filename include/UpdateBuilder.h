@@ -5,20 +5,25 @@
 #include "TableTypes.h"
 #include "ColumnValue.h"
 #include "QueryBuilder.h"  // For FilterCondition and CompareOp
+#include "FilterShapeCache.h"
 #include <string>
 #include <vector>
+#include <future>
 #include <unordered_map>
 #include <memory>
 
-// Forward declaration
-struct sqlite3_stmt;
-
 namespace sqlite_flux
 {
 
+	class WriteBatcher;  // Defined in WriteBatcher.h
+
 	// ============================================================================
 	// PreparedUpdate - High-performance batch update operations
 	// ============================================================================
+	//
+	// The SET list is fixed at construction; each WHERE shape (filter columns
+	// and operators) is prepared the first time it is seen and rebound for
+	// every later item with the same shape.
 
 	class PreparedUpdate
 	{
@@ -48,15 +53,24 @@ namespace sqlite_flux
 		// Get number of rows updated in current batch
 		int64_t getUpdateCount() const { return updateCount_; }
 
+		// Distinct WHERE shapes prepared so far
+		size_t getStatementCount() const { return statements_.size(); }
+
 	private:
 		Analyzer& analyzer_;
 		std::string tableName_;
-		std::unordered_map<std::string, ColumnValue> updates_;
+		std::string setSql_;                      // "UPDATE t SET a = ?, b = ?"
+		std::vector<ColumnValue> params_;         // SET values, then the current item's WHERE values
+		size_t setCount_ = 0;
 		std::vector<FilterCondition> currentFilters_;
+		FilterShapeCache statements_;
 		bool inTransaction_ = false;
 		int64_t updateCount_ = 0;
+		int64_t changesSinceCommit_ = 0;  // Rolled back if the next commit fails
+		int64_t operationCount_ = 0;
 		int64_t batchSize_ = 1000;  // Auto-commit every N operations
 
+		sqlite3_stmt* statementForCurrentShape();
 		void cleanup();
 	}; // end of class PreparedUpdate
 
@@ -83,17 +97,23 @@ namespace sqlite_flux
 		// Execute update and return number of rows affected
 		int64_t Execute();
 
+		// Queue the update on a WriteBatcher; the result carries the affected count
+		std::future<ExecuteResult> Submit(WriteBatcher& batcher);
+
 		// Prepare for batch operations
 		// Returns PreparedUpdate object for high-performance batching
 		PreparedUpdate Prepare();
 
-		// Generate SQL statement (for debugging/logging)
+		// Generate SQL statement (for debugging/logging) - values appear as ? placeholders
 		std::string buildSql() const;
 
+		// Values bound to the placeholders of buildSql(), in order
+		std::vector<ColumnValue> buildParams() const;
+
 	private:
 		Analyzer& analyzer_;
 		std::string tableName_;
-		TableSchema schema_;
+		std::shared_ptr<const TableDescriptor> table_;  // Shared with every builder on this table
 
 		std::unordered_map<std::string, ColumnValue> updates_;
 		std::vector<FilterCondition> filters_;
@@ -102,8 +122,6 @@ namespace sqlite_flux
 		// Validation helpers
 		void validateColumn(const std::string& column_) const;
 		void validateColumnType(const std::string& column_, const ColumnValue& value_) const;
-		std::string getSqliteType(const std::string& column_) const;
-		bool isTypeCompatible(const std::string& sqliteType, const ColumnValue& value_) const;
 		void validateSafeExecution() const;
 	}; // end of class UpdateBuilder
 
@@ -0,0 +1,117 @@
+// include/WriteBatcher.h
+#pragma once
+
+#include "ConnectionPool.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// WriteBatcherOptions - When a WriteBatcher flushes
+	// ============================================================================
+
+	struct WriteBatcherOptions
+	{
+		// Flush once this many writes are queued...
+		size_t maxBatchRows = 256;
+
+		// ...or once the oldest queued write has waited this long. 0 flushes as
+		// soon as the writer is free (plain group commit: whatever queued up while
+		// the previous batch was being written goes into the next one).
+		std::chrono::microseconds maxDelay{ 1000 };
+	}; // end of struct WriteBatcherOptions
+
+	// Counters since construction
+	struct WriteBatcherStats
+	{
+		uint64_t submitted = 0;
+		uint64_t batches = 0;       // Transactions committed (or attempted)
+		uint64_t failed = 0;        // Writes completed with an error
+		size_t largestBatch = 0;
+		size_t pending = 0;         // Queued, not yet picked up by the flusher
+	}; // end of struct WriteBatcherStats
+
+	// ============================================================================
+	// WriteBatcher - Coalesce small writes into shared transactions
+	// ============================================================================
+	// Accepts single DML statements from any thread and runs them on the pool's
+	// writer connection (acquireWrite()), many per transaction, so a burst of
+	// single-row writes pays for one WAL sync instead of one each.
+	//
+	// Every write runs inside its own SAVEPOINT: a failing statement is rolled
+	// back on its own and only its caller sees the error; the rest of the batch
+	// still commits. If SQLite aborts the whole transaction (disk full, I/O
+	// error) or COMMIT fails, every write of that transaction fails.
+	//
+	// Results are the statement's own changes and last insert rowid
+	// (lastInsertRowid is 0 when the statement changed nothing). Completion
+	// callbacks run on the flusher thread and must not block on the batcher.
+
+	class WriteBatcher
+	{
+	public:
+		using Completion = std::function<void(ExecuteResult)>;
+
+		explicit WriteBatcher(ConnectionPool& pool, const WriteBatcherOptions& options = {});
+
+		// Writes already queued are flushed before the flusher thread exits
+		~WriteBatcher();
+
+		// Disable copy and move
+		WriteBatcher(const WriteBatcher&) = delete;
+		WriteBatcher& operator=(const WriteBatcher&) = delete;
+		WriteBatcher(WriteBatcher&&) = delete;
+		WriteBatcher& operator=(WriteBatcher&&) = delete;
+
+		// Queue one DML statement; throws std::runtime_error once shutting down
+		std::future<ExecuteResult> submit(std::string sql, std::vector<ColumnValue> params = {});
+
+		// Callback flavour: done receives the result on the flusher thread
+		void submit(std::string sql, std::vector<ColumnValue> params, Completion done);
+
+		// Flush now and block until every write submitted before the call completed
+		void flush();
+
+		WriteBatcherStats getStats() const;
+		const WriteBatcherOptions& getOptions() const { return options_; }
+
+	private:
+		struct PendingWrite
+		{
+			std::string sql;
+			std::vector<ColumnValue> params;
+			Completion done;
+			std::chrono::steady_clock::time_point queuedAt;
+		}; // end of struct PendingWrite
+
+		void flusherLoop();
+		void writeBatch(const std::vector<PendingWrite>& batch, std::vector<ExecuteResult>& results);
+
+		ConnectionPool& pool_;
+		WriteBatcherOptions options_;
+
+		mutable std::mutex mutex_;
+		std::condition_variable queueCv_;  // Flusher waits for work
+		std::condition_variable doneCv_;   // flush() waits for completions
+		std::deque<PendingWrite> queue_;
+		uint64_t submitted_ = 0;
+		uint64_t completed_ = 0;
+		uint64_t flushUpTo_ = 0;            // flush() requests: ignore maxDelay up to here
+		uint64_t batches_ = 0;
+		uint64_t failed_ = 0;
+		size_t largestBatch_ = 0;
+		bool stopping_ = false;
+
+		std::thread flusher_;
+	}; // end of class WriteBatcher
+
+} // namespace sqlite_flux
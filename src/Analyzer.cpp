@@ -1,68 +1,853 @@
 ﻿// src/Analyzer.cpp
 #include "Analyzer.h"
+#include "Cursor.h"
 #include "ValueVisitor.h"
+#include "StatementHelpers.h"
+#include "ResultCache.h"
+#include "Metrics.h"
 #include <sqlite3.h>
 #include <iostream>
-#include <shared_mutex>
 #include <mutex>
 #include <atomic>
+#include <list>
+#include <string_view>
+#include <cctype>
+#include <algorithm>
+#include <chrono>
+#include <utility>
 
 namespace sqlite_flux
 {
 
+	namespace
+	{
+		// Last error per thread, tagged with the Analyzer that raised it so one
+		// connection's error never shows up on another
+		struct ThreadLastError
+		{
+			uint64_t owner = 0;
+			std::string message;
+		}; // end of struct ThreadLastError
+
+		thread_local ThreadLastError tlsLastError;
+		std::atomic<uint64_t> nextAnalyzerId{ 1 };
+
+		// Functions whose result differs between two runs of the same statement
+		bool isVolatileFunction(const char* name)
+		{
+			static constexpr const char* volatileFunctions[] = {
+				"random", "randomblob", "changes", "total_changes", "last_insert_rowid",
+				"date", "time", "datetime", "julianday", "unixepoch", "strftime", "timediff",
+				"current_date", "current_time", "current_timestamp"
+			};
+
+			for (const char* candidate : volatileFunctions)
+			{
+				if (sqlite3_stricmp(name, candidate) == 0) return true;
+			} // end of for
+			return false;
+		} // end of isVolatileFunction
+
+		// Tables whose rows describe the schema or connection state rather than data:
+		// the schema table (as the authorizer names it) and eponymous pragma_* tables
+		bool isSchemaTable(const char* name)
+		{
+			return sqlite3_stricmp(name, "sqlite_master") == 0 || sqlite3_stricmp(name, "sqlite_temp_master") == 0 ||
+				sqlite3_strnicmp(name, "pragma_", 7) == 0;
+		} // end of isSchemaTable
+
+		// Splits elapsed time between the phases of a statement; does nothing
+		// (reads no clock) unless metrics are attached
+		class PhaseClock
+		{
+		public:
+			using Clock = std::chrono::steady_clock;
+
+			explicit PhaseClock(bool enabled)
+				: enabled_(enabled)
+			{
+				if (enabled_) mark_ = Clock::now();
+			} // end of PhaseClock constructor
+
+			// Start counting from now, dropping anything not charged yet
+			void restart()
+			{
+				if (enabled_) mark_ = Clock::now();
+			} // end of restart
+
+			// Add the time since the last charge to phase
+			void charge(std::chrono::nanoseconds& phase)
+			{
+				if (!enabled_) return;
+				const auto now = Clock::now();
+				phase += now - mark_;
+				mark_ = now;
+			} // end of charge
+
+		private:
+			bool enabled_;
+			Clock::time_point mark_;
+		}; // end of class PhaseClock
+	} // namespace
+
 	// Pimpl idiom implementation with thread-safety
 	struct Analyzer::Impl
 	{
 		sqlite3* db = nullptr;
-		mutable std::string lastError;
+		const uint64_t id_ = nextAnalyzerId.fetch_add(1, std::memory_order_relaxed);
+		ConnectionOptions options_;
 
 		// Thread-safety primitives
 		mutable std::mutex dbMutex_;              // Protects database operations
-		mutable std::shared_mutex schemaMutex_;   // Protects schema cache (read-write)
+		bool useMutex_ = true;                    // false for exclusiveUse connections
+		std::atomic<bool> open_{ false };         // Lock-free isOpen()
 
-		// Schema cache (protected by schemaMutex_)
-		std::unordered_map<std::string, TableSchema> schemaCache;
-		std::atomic<bool> isCacheInitialized{ false };  // Lock-free flag
+		// Schema cache, possibly shared with other connections to the same file
+		std::shared_ptr<SharedSchema> sharedSchema_ = std::make_shared<SharedSchema>();
 		std::atomic<bool> walModeEnabled{ false };      // WAL mode status
 
+		// Prepared statement cache (protected by dbMutex_)
+		// Front of the list is the most recently used statement
+		//
+		// While a ResultCache is attached, the authorizer also records at prepare
+		// time which tables a statement reads and whether its result can be cached
+		struct StatementFootprint
+		{
+			std::vector<std::string> tables;
+			bool cacheable = true;
+			bool changesSchema = false;  // DDL: cached results may describe the old schema
+		}; // end of struct StatementFootprint
+
+		struct CachedStatement
+		{
+			std::string sql;
+			sqlite3_stmt* stmt;
+			StatementFootprint footprint;
+		}; // end of struct CachedStatement
+
+		std::list<CachedStatement> stmtLru_;
+		std::unordered_map<std::string_view, std::list<CachedStatement>::iterator> stmtIndex_;
+		size_t stmtCapacity_ = Analyzer::DefaultStatementCacheCapacity;
+		uint64_t stmtHits_ = 0;
+		uint64_t stmtMisses_ = 0;
+		uint64_t stmtEvictions_ = 0;
+
+		// A statement borrowed from the cache (or prepared uncached) for one call
+		// Caller must hold dbMutex_ for the lifetime of the lease
+		struct StatementLease
+		{
+			sqlite3_stmt* stmt = nullptr;
+			bool cached = false;
+			const StatementFootprint* footprint = nullptr;
+			std::chrono::nanoseconds prepareTime{ 0 };  // Only measured with metrics attached
+			bool cacheHit = false;
+		}; // end of struct StatementLease
+
+		// Query result cache (the pointer is only changed under dbMutex_)
+		std::shared_ptr<ResultCache> resultCache_;
+		StatementFootprint preparing_;                  // Filled by the authorizer
+		std::vector<std::string> pendingInvalidations_;  // Written tables, re-invalidated once committed
+		bool pendingClear_ = false;
+
+		// Metrics sink from options_ (null: nothing is timed) and the busy
+		// handler's retries for the statement in flight (requires dbMutex_)
+		MetricsSink* metrics_ = nullptr;
+		int busyRetries_ = 0;
+
+		// Arenas for queryArena(), recycled as their results are dropped
+		ResultArenaPool arenas_;
+
 		~Impl()
 		{
+			closeDatabase();
+		} // end of destructor
+
+		// Connection lock; empty (unlocked) when the caller guarantees exclusive use
+		std::unique_lock<std::mutex> lockDb() const
+		{
+			if (!useMutex_)
+			{
+				return std::unique_lock<std::mutex>(dbMutex_, std::defer_lock);
+			} // end of if
+			return std::unique_lock<std::mutex>(dbMutex_);
+		} // end of lockDb
+
+		void setLastError(std::string message) const
+		{
+			tlsLastError.owner = id_;
+			tlsLastError.message = std::move(message);
+		} // end of setLastError
+
+		std::string getLastError() const
+		{
+			return tlsLastError.owner == id_ ? tlsLastError.message : std::string();
+		} // end of getLastError
+
+		void closeDatabase()
+		{
+			finalizeCachedStatements();
+
+			open_.store(false, std::memory_order_release);
+
 			if (db)
 			{
-				sqlite3_close(db);
+				// close_v2 defers the close until caller-owned statements are finalized
+				sqlite3_close_v2(db);
+				db = nullptr;
 			} // end of if
-		} // end of destructor
+		} // end of closeDatabase
 
-		ColumnValue getColumnValue(sqlite3_stmt* stmt, int col)
+		void finalizeCachedStatements()
+		{
+			for (auto& entry : stmtLru_)
+			{
+				sqlite3_finalize(entry.stmt);
+			} // end of for
+			stmtIndex_.clear();
+			stmtLru_.clear();
+		} // end of finalizeCachedStatements
+
+		void evictToCapacity()
+		{
+			while (stmtLru_.size() > stmtCapacity_)
+			{
+				auto& victim = stmtLru_.back();
+				stmtIndex_.erase(victim.sql);
+				sqlite3_finalize(victim.stmt);
+				stmtLru_.pop_back();
+				++stmtEvictions_;
+			} // end of while
+		} // end of evictToCapacity
+
+		static bool hasTrailingSql(const char* tail, const char* end)
+		{
+			if (!tail) return false;
+
+			for (; tail < end && *tail; ++tail)
+			{
+				if (!std::isspace(static_cast<unsigned char>(*tail)) && *tail != ';')
+				{
+					return true;
+				} // end of if
+			} // end of for
+
+			return false;
+		} // end of hasTrailingSql
+
+		// Look up or prepare a statement for sql (requires dbMutex_)
+		// Multi-statement SQL is never cached; hasTail reports it to the caller
+		StatementLease acquireStatement(std::string_view sql, bool* hasTail = nullptr)
+		{
+			StatementLease lease;
+			if (hasTail) *hasTail = false;
+			busyRetries_ = 0;
+
+			auto it = stmtIndex_.find(sql);
+			if (it != stmtIndex_.end())
+			{
+				++stmtHits_;
+				stmtLru_.splice(stmtLru_.begin(), stmtLru_, it->second);
+				lease.stmt = it->second->stmt;
+				lease.cached = true;
+				lease.cacheHit = true;
+				lease.footprint = &it->second->footprint;
+				noteSchemaChange(*lease.footprint);
+				return lease;
+			} // end of if
+
+			++stmtMisses_;
+			preparing_ = StatementFootprint{};
+
+			const char* tail = nullptr;
+			unsigned int flags = stmtCapacity_ > 0 ? SQLITE_PREPARE_PERSISTENT : 0;
+			PhaseClock clock(metrics_ != nullptr);
+			int rc = sqlite3_prepare_v3(db, sql.data(), static_cast<int>(sql.size()),
+				flags, &lease.stmt, &tail);
+			clock.charge(lease.prepareTime);
+
+			if (rc != SQLITE_OK)
+			{
+				setLastError(sqlite3_errmsg(db));
+				sqlite3_finalize(lease.stmt);
+				lease.stmt = nullptr;
+				return lease;
+			} // end of if
+
+			bool trailing = hasTrailingSql(tail, sql.data() + sql.size());
+			if (hasTail) *hasTail = trailing;
+
+			// Empty statements (comments only) prepare to nullptr and are not cached
+			if (!lease.stmt || trailing || stmtCapacity_ == 0)
+			{
+				lease.footprint = &preparing_;
+				return lease;
+			} // end of if
+
+			stmtLru_.push_front(CachedStatement{ std::string(sql), lease.stmt, std::move(preparing_) });
+			stmtIndex_.emplace(stmtLru_.front().sql, stmtLru_.begin());
+			lease.cached = true;
+			lease.footprint = &stmtLru_.front().footprint;
+			evictToCapacity();
+
+			return lease;
+		} // end of acquireStatement
+
+		// Return a leased statement: cached ones are reset for reuse, others finalized
+		static void releaseStatement(StatementLease& lease)
+		{
+			if (!lease.stmt) return;
+
+			if (lease.cached)
+			{
+				sqlite3_reset(lease.stmt);
+				sqlite3_clear_bindings(lease.stmt);
+			} // end of if
+			else
+			{
+				sqlite3_finalize(lease.stmt);
+			} // end of else
+
+			lease.stmt = nullptr;
+		} // end of releaseStatement
+
+		// Bind params to ?1..?N, recording any error (requires dbMutex_)
+		bool bindParameters(sqlite3_stmt* stmt, std::span<const ColumnValue> params)
+		{
+			if (params.empty()) return true;
+
+			if (static_cast<int>(params.size()) != sqlite3_bind_parameter_count(stmt))
+			{
+				setLastError("Parameter count mismatch: statement expects " +
+					std::to_string(sqlite3_bind_parameter_count(stmt)) + ", got " +
+					std::to_string(params.size()));
+				return false;
+			} // end of if
+
+			if (detail::bindParameters(stmt, params) != SQLITE_OK)
+			{
+				setLastError(sqlite3_errmsg(db));
+				return false;
+			} // end of if
+
+			return true;
+		} // end of bindParameters
+
+		// Run a statement to completion (requires dbMutex_)
+		bool stepToCompletion(sqlite3_stmt* stmt, StatementMetrics& statement)
+		{
+			PhaseClock clock(metrics_ != nullptr);
+			int rc;
+			while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+			{
+			} // end of while
+			clock.charge(statement.step);
+
+			if (rc != SQLITE_DONE)
+			{
+				setLastError(sqlite3_errmsg(db));
+				return false;
+			} // end of if
+
+			flushInvalidations();
+			return true;
+		} // end of stepToCompletion
+
+		// Hand a finished statement to the metrics sink, if any (requires dbMutex_)
+		void reportStatement(std::string_view sql, std::span<const ColumnValue> params,
+			const StatementLease& lease, StatementMetrics& statement)
+		{
+			if (!metrics_) return;
+
+			statement.sql = sql;
+			statement.params = params;
+			statement.prepare = lease.prepareTime;
+			statement.statementCacheHit = lease.cacheHit;
+			statement.busyRetries = std::exchange(busyRetries_, 0);
+			metrics_->onStatement(statement);
+		} // end of reportStatement
+
+		// One statement in flight, from lease to report (requires dbMutex_ throughout)
+		struct StatementRun
+		{
+			StatementRun(bool timed, std::string_view sql, std::span<const ColumnValue> params)
+				: sql(sql), params(params), clock(timed)
+			{
+			} // end of StatementRun constructor
+
+			std::string_view sql;
+			std::span<const ColumnValue> params;
+			StatementLease lease;
+			StatementMetrics statement;
+			PhaseClock clock;
+			int rc = SQLITE_ERROR;  // Last step result
+		}; // end of struct StatementRun
+
+		// The statement between Analyzer::beginRows and endRows
+		std::optional<StatementRun> reading_;
+
+		// Lease and bind run.sql; false, with nothing left to end, if either fails
+		bool beginRun(StatementRun& run)
+		{
+			run.lease = acquireStatement(run.sql);
+			if (!run.lease.stmt) return false;
+
+			if (!bindParameters(run.lease.stmt, run.params))
+			{
+				releaseStatement(run.lease);
+				return false;
+			} // end of if
+
+			run.clock.restart();  // Preparing is timed by acquireStatement
+			return true;
+		} // end of beginRun
+
+		// Step once (time since the last step counts as decoding); false at the
+		// end of the result or on error, which run.rc tells apart
+		bool stepRun(StatementRun& run)
+		{
+			run.clock.charge(run.statement.decode);
+			run.rc = sqlite3_step(run.lease.stmt);
+			run.clock.charge(run.statement.step);
+
+			if (run.rc == SQLITE_ROW)
+			{
+				++run.statement.rows;
+				return true;
+			} // end of if
+
+			if (run.rc != SQLITE_DONE)
+			{
+				setLastError(sqlite3_errmsg(db));
+			} // end of if
+			return false;
+		} // end of stepRun
+
+		// Report the run, hand the statement back and apply invalidations; true
+		// unless a step failed
+		bool endRun(StatementRun& run)
+		{
+			run.clock.charge(run.statement.decode);
+			run.statement.success = run.rc == SQLITE_ROW || run.rc == SQLITE_DONE;
+			reportStatement(run.sql, run.params, run.lease, run.statement);
+			releaseStatement(run.lease);
+			flushInvalidations();
+			return run.statement.success;
+		} // end of endRun
+
+		// Every query path: lease, bind, then sink.row(stmt) decodes each row
+		// until the result ends or it returns false. The optional sink.begin(stmt)
+		// runs before the first step and sink.done(lease, rc) while the statement
+		// is still leased. False if it could not be prepared, bound or stepped.
+		template<typename Sink>
+		bool runStatement(std::string_view sql, std::span<const ColumnValue> params, Sink& sink)
+		{
+			StatementRun run(metrics_ != nullptr, sql, params);
+			if (!beginRun(run)) return false;
+
+			try
+			{
+				if constexpr (requires { sink.begin(run.lease.stmt); }) sink.begin(run.lease.stmt);
+				while (stepRun(run) && sink.row(run.lease.stmt))
+				{
+				} // end of while
+				if constexpr (requires { sink.done(run.lease, run.rc); }) sink.done(run.lease, run.rc);
+			} // end of try
+			catch (...)
+			{
+				releaseStatement(run.lease);  // Reset for its next user
+				throw;
+			} // end of catch
+
+			return endRun(run);
+		} // end of runStatement
+
+		// Column names of stmt, resolved once instead of per cell
+		static std::vector<std::string> columnNames(sqlite3_stmt* stmt)
+		{
+			int columnCount = sqlite3_column_count(stmt);
+			std::vector<std::string> names;
+			names.reserve(columnCount);
+			for (int i = 0; i < columnCount; ++i)
+			{
+				names.emplace_back(sqlite3_column_name(stmt, i));
+			} // end of for
+			return names;
+		} // end of columnNames
+
+		// Busy handler installed while metrics are attached: the same back-off as
+		// sqlite3_busy_timeout, but counting the retries
+		static int onBusy(void* context, int count)
+		{
+			static constexpr int delays[] = { 1, 2, 5, 10, 15, 20, 25, 25, 25, 50, 50, 100 };
+			static constexpr int totals[] = { 0, 1, 3, 8, 18, 33, 53, 78, 103, 128, 178, 228 };
+			constexpr int steps = static_cast<int>(std::size(delays));
+
+			auto* self = static_cast<Impl*>(context);
+			const int timeout = self->options_.busyTimeoutMs;
+
+			int delay = count < steps ? delays[count] : delays[steps - 1];
+			const int prior = count < steps ? totals[count] : totals[steps - 1] + delay * (count - (steps - 1));
+			if (prior + delay > timeout)
+			{
+				delay = timeout - prior;
+				if (delay <= 0) return 0;  // Give up: the statement fails with SQLITE_BUSY
+			} // end of if
+
+			++self->busyRetries_;
+			sqlite3_sleep(delay);
+			return 1;
+		} // end of onBusy
+
+		// busy_timeout, or the counting handler while metrics are attached (requires dbMutex_)
+		void installBusyHandler()
+		{
+			if (!db) return;
+
+			if (metrics_)
+			{
+				sqlite3_busy_handler(db, &Impl::onBusy, this);
+			} // end of if
+			else
+			{
+				sqlite3_busy_timeout(db, options_.busyTimeoutMs);
+			} // end of else
+		} // end of installBusyHandler
+
+		// Run one tuning PRAGMA, recording its error (requires dbMutex_)
+		bool pragma(const std::string& statement)
+		{
+			char* errMsg = nullptr;
+			if (sqlite3_exec(db, statement.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK)
+			{
+				setLastError(errMsg ? errMsg : "Failed: " + statement);
+				sqlite3_free(errMsg);
+				return false;
+			} // end of if
+			return true;
+		} // end of pragma
+
+		// journal_mode=WAL plus the synchronous level that goes with it (requires dbMutex_)
+		bool switchToWal()
 		{
-			int type = sqlite3_column_type(stmt, col);
+			if (!pragma("PRAGMA journal_mode=WAL")) return false;
+
+			walModeEnabled.store(true, std::memory_order_release);
+			applySynchronous(options_.synchronous.value_or(Synchronous::Normal));
+			return true;
+		} // end of switchToWal
+
+		void applySynchronous(Synchronous level)
+		{
+			static constexpr const char* levels[] = { "OFF", "NORMAL", "FULL", "EXTRA" };
+			pragma(std::string("PRAGMA synchronous=") + levels[static_cast<int>(level)]);
+		} // end of applySynchronous
+
+		// Apply options_ to a freshly opened connection (requires dbMutex_)
+		// Best effort, as before: a setting SQLite rejects leaves its default
+		void applyTuning()
+		{
+			// The page size must be set before WAL creates the first frames
+			if (options_.pageSize)
+			{
+				pragma("PRAGMA page_size=" + std::to_string(*options_.pageSize));
+			} // end of if
+
+			// A read-only connection cannot switch modes; it still benefits if a writer did
+			if (!options_.enableWAL || !switchToWal())
+			{
+				if (options_.synchronous) applySynchronous(*options_.synchronous);
+			} // end of if
+
+			if (options_.cacheSizeKiB)
+			{
+				// Negative cache_size is a budget in KiB
+				pragma("PRAGMA cache_size=-" + std::to_string(*options_.cacheSizeKiB));
+			} // end of if
+
+			if (options_.mmapSizeBytes)
+			{
+				pragma("PRAGMA mmap_size=" + std::to_string(*options_.mmapSizeBytes));
+			} // end of if
+
+			if (options_.walAutoCheckpointPages)
+			{
+				pragma("PRAGMA wal_autocheckpoint=" + std::to_string(*options_.walAutoCheckpointPages));
+			} // end of if
 
-			switch (type)
+			if (options_.tempStore != TempStore::Default)
 			{
-			case SQLITE_INTEGER:
-				return sqlite3_column_int64(stmt, col);
-			case SQLITE_FLOAT:
-				return sqlite3_column_double(stmt, col);
-			case SQLITE_TEXT:
-				return std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, col)));
-			case SQLITE_BLOB:
+				pragma(options_.tempStore == TempStore::Memory ? "PRAGMA temp_store=MEMORY" : "PRAGMA temp_store=FILE");
+			} // end of if
+		} // end of applyTuning
+
+		// Authorizer installed while a result cache is attached
+		static int authorize(void* context, int action, const char* arg1, const char* arg2,
+			const char* /*database*/, const char* /*trigger*/)
+		{
+			auto* self = static_cast<Impl*>(context);
+			StatementFootprint& footprint = self->preparing_;
+
+			switch (action)
 			{
-				const void* blob = sqlite3_column_blob(stmt, col);
-				int size = sqlite3_column_bytes(stmt, col);
-				const uint8_t* data = static_cast<const uint8_t*>(blob);
-				return std::vector<uint8_t>(data, data + size);
-			} // end of case SQLITE_BLOB
-			case SQLITE_NULL:
+			case SQLITE_READ:
+				// arg1 is the table, arg2 the column
+				if (arg1 && isSchemaTable(arg1)) footprint.cacheable = false;
+				if (arg1 && std::find(footprint.tables.begin(), footprint.tables.end(), arg1) == footprint.tables.end())
+				{
+					footprint.tables.emplace_back(arg1);
+				} // end of if
+				break;
+			case SQLITE_FUNCTION:
+				// arg2 is the function name
+				if (arg2 && isVolatileFunction(arg2)) footprint.cacheable = false;
+				break;
+			case SQLITE_PRAGMA:
+			case SQLITE_TRANSACTION:
+			case SQLITE_SAVEPOINT:
+			case SQLITE_ATTACH:
+			case SQLITE_DETACH:
+				// Read-only by sqlite3_stmt_readonly, but running them is the point
+				footprint.cacheable = false;
+				break;
+			case SQLITE_CREATE_INDEX:
+			case SQLITE_CREATE_TABLE:
+			case SQLITE_CREATE_TEMP_INDEX:
+			case SQLITE_CREATE_TEMP_TABLE:
+			case SQLITE_CREATE_TEMP_TRIGGER:
+			case SQLITE_CREATE_TEMP_VIEW:
+			case SQLITE_CREATE_TRIGGER:
+			case SQLITE_CREATE_VIEW:
+			case SQLITE_CREATE_VTABLE:
+			case SQLITE_DROP_INDEX:
+			case SQLITE_DROP_TABLE:
+			case SQLITE_DROP_TEMP_INDEX:
+			case SQLITE_DROP_TEMP_TABLE:
+			case SQLITE_DROP_TEMP_TRIGGER:
+			case SQLITE_DROP_TEMP_VIEW:
+			case SQLITE_DROP_TRIGGER:
+			case SQLITE_DROP_VIEW:
+			case SQLITE_DROP_VTABLE:
+			case SQLITE_ALTER_TABLE:
+				// Every schema_version bump: views, triggers and indexes change what
+				// (and which rows) a cached statement would return
+				footprint.changesSchema = true;
+				footprint.cacheable = false;
+				self->pendingClear_ = true;
+				break;
 			default:
-				return std::monostate{};
+				break;
 			} // end of switch
+
+			return SQLITE_OK;
+		} // end of authorize
+
+		// Update hook installed while a result cache is attached (one call per row)
+		static void onRowChanged(void* context, int /*operation*/, const char* /*database*/,
+			const char* table, sqlite3_int64 /*rowid*/)
+		{
+			auto* self = static_cast<Impl*>(context);
+			self->noteWrite(table);
+		} // end of onRowChanged
+
+		// Invalidate now, so readers on other connections stop being served the old
+		// rows, and again once committed, in case one re-cached them from a snapshot
+		// taken before the commit (requires dbMutex_)
+		void noteWrite(const char* table)
+		{
+			if (!resultCache_) return;
+			if (std::find(pendingInvalidations_.begin(), pendingInvalidations_.end(), table) != pendingInvalidations_.end())
+			{
+				return;  // Already dropped by an earlier row of this transaction
+			} // end of if
+
+			pendingInvalidations_.emplace_back(table);
+			resultCache_->invalidateTable(pendingInvalidations_.back());
+		} // end of noteWrite
+
+		// A cached DDL statement runs again without re-preparing
+		void noteSchemaChange(const StatementFootprint& footprint)
+		{
+			if (footprint.changesSchema && resultCache_) pendingClear_ = true;
+		} // end of noteSchemaChange
+
+		// Apply pending invalidations once outside a transaction (requires dbMutex_)
+		void flushInvalidations()
+		{
+			if (pendingInvalidations_.empty() && !pendingClear_) return;
+			if (!db || sqlite3_get_autocommit(db) == 0) return;
+
+			if (resultCache_)
+			{
+				if (pendingClear_)
+				{
+					resultCache_->clear();
+				} // end of if
+				else
+				{
+					for (const std::string& table : pendingInvalidations_)
+					{
+						resultCache_->invalidateTable(table);
+					} // end of for
+				} // end of else
+			} // end of if
+
+			pendingInvalidations_.clear();
+			pendingClear_ = false;
+		} // end of flushInvalidations
+
+		// The result cache, if reads on this connection may use it now (requires dbMutex_)
+		// Inside a transaction this connection may see its own uncommitted writes
+		ResultCache* usableResultCache()
+		{
+			if (!resultCache_ || sqlite3_get_autocommit(db) == 0) return nullptr;
+
+			flushInvalidations();
+			return resultCache_.get();
+		} // end of usableResultCache
+
+		// Only statements that cannot write (no RETURNING, PRAGMA, ...) and have a stable result
+		static bool isCacheable(const StatementLease& lease)
+		{
+			return sqlite3_stmt_readonly(lease.stmt) && lease.footprint->cacheable;
+		} // end of isCacheable
+
+		// Install or remove the cache hooks to match resultCache_ (requires dbMutex_)
+		void installCacheHooks()
+		{
+			if (!db) return;
+
+			if (resultCache_)
+			{
+				sqlite3_set_authorizer(db, &Impl::authorize, this);
+				sqlite3_update_hook(db, &Impl::onRowChanged, this);
+			} // end of if
+			else
+			{
+				sqlite3_set_authorizer(db, nullptr, nullptr);
+				sqlite3_update_hook(db, nullptr, nullptr);
+			} // end of else
+		} // end of installCacheHooks
+
+		ColumnValue getColumnValue(sqlite3_stmt* stmt, int col)
+		{
+			return detail::readColumnValue(stmt, col);
 		} // end of getColumnValue
+
+		// PRAGMA schema_version, or -1 if it cannot be read (requires dbMutex_)
+		int64_t readSchemaVersion()
+		{
+			int64_t version = -1;
+			auto lease = acquireStatement("PRAGMA schema_version");
+			if (lease.stmt && sqlite3_step(lease.stmt) == SQLITE_ROW)
+			{
+				version = sqlite3_column_int64(lease.stmt, 0);
+			} // end of if
+			releaseStatement(lease);
+			return version;
+		} // end of readSchemaVersion
+
+		// Read every table's columns (requires dbMutex_)
+		std::shared_ptr<const SchemaSnapshot> loadSchema()
+		{
+			auto snapshot = std::make_shared<SchemaSnapshot>();
+
+			// Version first: a DDL racing with the reads below then only costs
+			// one extra refresh, never a stale snapshot labelled as current
+			snapshot->schemaVersion = readSchemaVersion();
+
+			// Tables and views: QueryBuilder reads from both
+			std::vector<std::string> tables;
+			const char* query = "SELECT name FROM sqlite_master "
+				"WHERE type IN ('table', 'view') AND name NOT LIKE 'sqlite_%'";
+
+			sqlite3_stmt* stmt;
+			if (sqlite3_prepare_v2(db, query, -1, &stmt, nullptr) == SQLITE_OK)
+			{
+				while (sqlite3_step(stmt) == SQLITE_ROW)
+				{
+					tables.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+				} // end of while
+				sqlite3_finalize(stmt);
+			} // end of if
+
+			// Read each one's columns
+			for (const auto& tableName : tables)
+			{
+				TableSchema schema;
+				std::string quoted;
+				for (char c : tableName) quoted += (c == '"') ? std::string("\"\"") : std::string(1, c);
+				std::string schemaQuery = "PRAGMA table_info(\"" + quoted + "\")";
+
+				if (sqlite3_prepare_v2(db, schemaQuery.c_str(), -1, &stmt, nullptr) == SQLITE_OK)
+				{
+					while (sqlite3_step(stmt) == SQLITE_ROW)
+					{
+						ColumnInfo info;
+						info.name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+						info.type = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+						info.notNull = sqlite3_column_int(stmt, 3) != 0;
+						info.primaryKey = sqlite3_column_int(stmt, 5) != 0;
+						schema.push_back(info);
+					} // end of while
+					sqlite3_finalize(stmt);
+				} // end of if
+
+				snapshot->tables.emplace(tableName, TableDescriptor(tableName, std::move(schema)));
+			} // end of for
+
+			return snapshot;
+		} // end of loadSchema
+
+		// Current snapshot, rebuilt first if schema_version moved since it was taken
+		std::shared_ptr<const SchemaSnapshot> currentSchema()
+		{
+			auto snapshot = sharedSchema_->current();
+
+			int64_t version;
+			{
+				auto lock = lockDb();
+				if (!db) return snapshot;
+				version = readSchemaVersion();
+			} // end of lock scope
+
+			if (snapshot && snapshot->schemaVersion == version)
+			{
+				if (metrics_) metrics_->onSchemaLookup(false);
+				return snapshot;
+			} // end of if
+
+			std::lock_guard refresh(sharedSchema_->refreshMutex());
+
+			// Another connection may have rebuilt it while we waited
+			snapshot = sharedSchema_->current();
+			if (snapshot && snapshot->schemaVersion == version)
+			{
+				if (metrics_) metrics_->onSchemaLookup(false);
+				return snapshot;
+			} // end of if
+
+			std::shared_ptr<const SchemaSnapshot> fresh;
+			{
+				auto lock = lockDb();
+				if (!db) return snapshot;
+				fresh = loadSchema();
+			} // end of lock scope
+
+			sharedSchema_->publish(fresh);
+			if (metrics_) metrics_->onSchemaLookup(true);
+			return fresh;
+		} // end of currentSchema
 	}; // end of struct Impl
 
 	Analyzer::Analyzer(const std::string& dbPath)
+		: Analyzer(dbPath, ConnectionOptions{})
+	{
+	} // end of Analyzer constructor
+
+	Analyzer::Analyzer(const std::string& dbPath, const ConnectionOptions& options)
 		: pImpl_(std::make_unique<Impl>())
 	{
-		open(dbPath);
+		open(dbPath, options);
 	} // end of Analyzer constructor
 
 	Analyzer::~Analyzer() = default;
@@ -71,93 +856,171 @@ namespace sqlite_flux
 	Analyzer& Analyzer::operator=(Analyzer&&) noexcept = default;
 
 	bool Analyzer::open(const std::string& dbPath)
+	{
+		return open(dbPath, pImpl_->options_);
+	} // end of open
+
+	bool Analyzer::open(const std::string& dbPath, const ConnectionOptions& options)
 	{
 		close();
 
-		std::lock_guard lock(pImpl_->dbMutex_);  // Thread-safe
+		pImpl_->options_ = options;
+		pImpl_->metrics_ = options.metrics.get();
+		pImpl_->arenas_ = ResultArenaPool(options.resultArenas);
+		pImpl_->sharedSchema_->invalidate();  // Possibly a different file now
+		pImpl_->useMutex_ = !options.exclusiveUse;
+
+		auto lock = pImpl_->lockDb();  // Thread-safe
 
-		int rc = sqlite3_open(dbPath.c_str(), &pImpl_->db);
+		int flags = options.readOnly
+			? SQLITE_OPEN_READONLY
+			: (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+		flags |= options.openFlags;
+		if (options.exclusiveUse)
+		{
+			flags |= SQLITE_OPEN_NOMUTEX;
+		} // end of if
+
+		int rc = sqlite3_open_v2(dbPath.c_str(), &pImpl_->db, flags, nullptr);
 		if (rc != SQLITE_OK)
 		{
-			pImpl_->lastError = sqlite3_errmsg(pImpl_->db);
-			sqlite3_close(pImpl_->db);
+			pImpl_->setLastError(sqlite3_errmsg(pImpl_->db));
+			sqlite3_close_v2(pImpl_->db);
 			pImpl_->db = nullptr;
 			return false;
 		} // end of if
 
-		// Enable WAL mode directly (we already hold the mutex)
-		if (pImpl_->db)
-		{
-			char* errMsg = nullptr;
-			rc = sqlite3_exec(pImpl_->db, "PRAGMA journal_mode=WAL", nullptr, nullptr, &errMsg);
-
-			if (rc == SQLITE_OK)
-			{
-				sqlite3_exec(pImpl_->db, "PRAGMA synchronous=NORMAL", nullptr, nullptr, nullptr);
-				sqlite3_exec(pImpl_->db, "PRAGMA busy_timeout=5000", nullptr, nullptr, nullptr);
-				pImpl_->walModeEnabled.store(true, std::memory_order_release);
-			} // end of if
-			else
-			{
-				sqlite3_free(errMsg);
-			} // end of else
-		} // end of if
+		pImpl_->installBusyHandler();
+		pImpl_->installCacheHooks();
+		pImpl_->applyTuning();  // We already hold the mutex
 
+		pImpl_->open_.store(true, std::memory_order_release);
 		return true;
 	} // end of open
 
 	void Analyzer::close()
 	{
-		std::lock_guard lock(pImpl_->dbMutex_);  // Thread-safe
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		pImpl_->closeDatabase();
+	} // end of close
+
+	bool Analyzer::isOpen() const
+	{
+		return pImpl_->open_.load(std::memory_order_acquire);
+	} // end of isOpen
+
+	const ConnectionOptions& Analyzer::getOptions() const
+	{
+		return pImpl_->options_;
+	} // end of getOptions
+
+	bool Analyzer::enableWALMode()
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db) return false;
+
+		// Same settings open() applies with enableWAL; the busy handler is already set
+		return pImpl_->switchToWal();
+	} // end of enableWALMode
+
+	bool Analyzer::isWALMode() const
+	{
+		return pImpl_->walModeEnabled.load(std::memory_order_acquire);
+	} // end of isWALMode
+
+	CheckpointResult Analyzer::checkpoint(CheckpointMode mode)
+	{
+		static constexpr int modes[] = { SQLITE_CHECKPOINT_PASSIVE, SQLITE_CHECKPOINT_FULL,
+			SQLITE_CHECKPOINT_RESTART, SQLITE_CHECKPOINT_TRUNCATE };
+
+		auto lock = pImpl_->lockDb();  // Thread-safe
 
-		if (pImpl_->db)
+		CheckpointResult result;
+		if (!pImpl_->db)
 		{
-			sqlite3_close(pImpl_->db);
-			pImpl_->db = nullptr;
+			result.error = "Database is not open";
+			return result;
 		} // end of if
-	} // end of close
 
-	bool Analyzer::isOpen() const
-	{
-		std::lock_guard lock(pImpl_->dbMutex_);  // Thread-safe
-		return pImpl_->db != nullptr;
-	} // end of isOpen
+		PhaseClock clock(pImpl_->metrics_ != nullptr);
+		pImpl_->busyRetries_ = 0;
 
-	bool Analyzer::enableWALMode()
-	{
-		std::lock_guard lock(pImpl_->dbMutex_);  // Thread-safe
+		int rc = sqlite3_wal_checkpoint_v2(pImpl_->db, nullptr, modes[static_cast<int>(mode)],
+			&result.logFrames, &result.checkpointedFrames);
+		result.success = rc == SQLITE_OK;
+		result.busy = rc == SQLITE_BUSY;
+		if (!result.success)
+		{
+			result.error = sqlite3_errmsg(pImpl_->db);
+			pImpl_->setLastError(result.error);
+		} // end of if
 
-		if (!pImpl_->db) return false;
+		if (pImpl_->metrics_)
+		{
+			CheckpointMetrics checkpoint;
+			clock.charge(checkpoint.duration);
+			checkpoint.mode = mode;
+			checkpoint.logFrames = result.logFrames;
+			checkpoint.checkpointedFrames = result.checkpointedFrames;
+			checkpoint.busyRetries = std::exchange(pImpl_->busyRetries_, 0);
+			checkpoint.success = result.success;
+			pImpl_->metrics_->onCheckpoint(checkpoint);
+		} // end of if
 
-		// Enable WAL mode for better concurrency
-		char* errMsg = nullptr;
-		int rc = sqlite3_exec(pImpl_->db, "PRAGMA journal_mode=WAL", nullptr, nullptr, &errMsg);
+		return result;
+	} // end of checkpoint
 
-		if (rc != SQLITE_OK)
+	bool Analyzer::shareReadSnapshot(Analyzer& other) const
+	{
+#ifdef SQLITE_ENABLE_SNAPSHOT
+		sqlite3_snapshot* snapshot = nullptr;
 		{
-			pImpl_->lastError = errMsg ? errMsg : "Failed to enable WAL mode";
-			sqlite3_free(errMsg);
-			return false;
-		} // end of if
+			auto lock = pImpl_->lockDb();  // Thread-safe
 
-		// Set synchronous to NORMAL for better performance
-		sqlite3_exec(pImpl_->db, "PRAGMA synchronous=NORMAL", nullptr, nullptr, nullptr);
+			if (!pImpl_->db)
+			{
+				pImpl_->setLastError("Database is not open");
+				return false;
+			} // end of if
 
-		// Set busy timeout to 5 seconds
-		sqlite3_exec(pImpl_->db, "PRAGMA busy_timeout=5000", nullptr, nullptr, nullptr);
+			if (sqlite3_snapshot_get(pImpl_->db, "main", &snapshot) != SQLITE_OK)
+			{
+				pImpl_->setLastError(sqlite3_errmsg(pImpl_->db));
+				return false;
+			} // end of if
+		} // end of lock scope
 
-		pImpl_->walModeEnabled.store(true, std::memory_order_release);
-		return true;
-	} // end of enableWALMode
+		// snapshot_open wants a transaction that has not read anything yet
+		bool ok = other.execute("BEGIN");
+		if (ok)
+		{
+			auto lock = other.pImpl_->lockDb();
+			if (sqlite3_snapshot_open(other.pImpl_->db, "main", snapshot) != SQLITE_OK)
+			{
+				other.pImpl_->setLastError(sqlite3_errmsg(other.pImpl_->db));
+				ok = false;
+			} // end of if
+		} // end of if
+		sqlite3_snapshot_free(snapshot);
 
-	bool Analyzer::isWALMode() const
-	{
-		return pImpl_->walModeEnabled.load(std::memory_order_acquire);
-	} // end of isWALMode
+		if (!ok)
+		{
+			pImpl_->setLastError("Failed to open shared snapshot: " + other.getLastError());
+			if (other.isInTransaction()) other.rollback();
+		} // end of if
+		return ok;
+#else
+		(void)other;
+		pImpl_->setLastError("Shared snapshots need SQLITE_ENABLE_SNAPSHOT");
+		return false;
+#endif
+	} // end of shareReadSnapshot
 
 	std::vector<std::string> Analyzer::getTableNames() const
 	{
-		std::lock_guard lock(pImpl_->dbMutex_);  // Thread-safe
+		auto lock = pImpl_->lockDb();  // Thread-safe
 
 		std::vector<std::string> tables;
 		if (!pImpl_->db) return tables;
@@ -180,7 +1043,7 @@ namespace sqlite_flux
 
 	std::vector<std::string> Analyzer::getColumnNames(const std::string& tableName) const
 	{
-		std::lock_guard lock(pImpl_->dbMutex_);  // Thread-safe
+		auto lock = pImpl_->lockDb();  // Thread-safe
 
 		std::vector<std::string> columns;
 		if (!pImpl_->db) return columns;
@@ -202,85 +1065,350 @@ namespace sqlite_flux
 
 	TableSchema Analyzer::getTableSchema(const std::string& tableName) const
 	{
-		// First check (optimistic read)
-		if (pImpl_->isCacheInitialized.load(std::memory_order_acquire))
+		auto snapshot = pImpl_->currentSchema();
+		if (!snapshot) return TableSchema();
+
+		const TableDescriptor* table = snapshot->find(tableName);
+		return table ? table->columns() : TableSchema();
+	} // end of getTableSchema
+
+	ResultSet Analyzer::query(const std::string& sql) const
+	{
+		return query(sql, {});
+	} // end of query
+
+	ResultSet Analyzer::query(const std::string& sql, const std::vector<ColumnValue>& params) const
+	{
+		return queryImpl(sql, params);
+	} // end of query
+
+	ResultSet Analyzer::queryImpl(std::string_view sql, std::span<const ColumnValue> params) const
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe: serialize all DB operations
+
+		if (!pImpl_->db) return {};
+
+		ResultCache* cache = pImpl_->usableResultCache();
+		std::string cacheKey;
+		uint64_t cacheEpoch = 0;
+		if (cache)
 		{
-			// Try to read from cache with shared lock (concurrent reads allowed)
-			std::shared_lock lock(pImpl_->schemaMutex_);
-			auto it = pImpl_->schemaCache.find(tableName);
-			if (it != pImpl_->schemaCache.end())
+			cacheKey = ResultCache::makeKey(sql, params);
+			if (auto hit = cache->lookup(cacheKey))
 			{
-				return it->second;
+				return *hit;
 			} // end of if
+			cacheEpoch = cache->epoch();
 		} // end of if
 
-		// Not in cache, fetch from database with exclusive lock
-		std::unique_lock cacheLock(pImpl_->schemaMutex_);  // Exclusive for write
-		// ✅ DOUBLE-CHECK: Another thread might have populated it
-		auto it = pImpl_->schemaCache.find(tableName);
-		if (it != pImpl_->schemaCache.end())
+		struct RowsSink
 		{
-			return it->second;  // Found it now!
-		}
-		std::lock_guard dbLock(pImpl_->dbMutex_);          // Serialize DB access
+			Impl& impl;
+			ResultCache* cache;
+			std::string& cacheKey;
+			uint64_t cacheEpoch;
+			std::vector<std::string> columnNames;
+			ResultSet results;
 
-		TableSchema schema;
-		if (!pImpl_->db) return schema;
+			void begin(sqlite3_stmt* stmt) { columnNames = Impl::columnNames(stmt); }
 
-		std::string query = "PRAGMA table_info(" + tableName + ")";
+			bool row(sqlite3_stmt* stmt)
+			{
+				Row& row = results.emplace_back();
+				row.reserve(columnNames.size());
+				for (size_t i = 0; i < columnNames.size(); ++i)
+				{
+					row[columnNames[i]] = impl.getColumnValue(stmt, static_cast<int>(i));
+				} // end of for
+				return true;
+			} // end of row
 
-		sqlite3_stmt* stmt;
-		if (sqlite3_prepare_v2(pImpl_->db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK)
+			void done(const Impl::StatementLease& lease, int rc)
+			{
+				if (cache && rc == SQLITE_DONE && Impl::isCacheable(lease))
+				{
+					cache->insert(std::move(cacheKey), results, lease.footprint->tables, cacheEpoch);
+				} // end of if
+			} // end of done
+		}; // end of struct RowsSink
+
+		RowsSink sink{ *pImpl_, cache, cacheKey, cacheEpoch, {}, {} };
+		pImpl_->runStatement(sql, params, sink);
+		return std::move(sink.results);
+	} // end of queryImpl
+
+	std::optional<ColumnValue> Analyzer::queryScalar(const std::string& sql, const std::vector<ColumnValue>& params) const
+	{
+		return queryScalarImpl(sql, params);
+	} // end of queryScalar
+
+	std::optional<ColumnValue> Analyzer::queryScalarImpl(std::string_view sql, std::span<const ColumnValue> params) const
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db) return std::nullopt;
+
+		ResultCache* cache = pImpl_->usableResultCache();
+		std::string cacheKey;
+		uint64_t cacheEpoch = 0;
+		if (cache)
 		{
-			while (sqlite3_step(stmt) == SQLITE_ROW)
+			// Leading NUL keeps one-cell entries apart from query()'s full results
+			cacheKey = '\0' + ResultCache::makeKey(sql, params);
+			if (auto hit = cache->lookup(cacheKey))
 			{
-				ColumnInfo info;
-				info.name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-				info.type = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-				info.notNull = sqlite3_column_int(stmt, 3) != 0;
-				info.primaryKey = sqlite3_column_int(stmt, 5) != 0;
-				schema.push_back(info);
-			} // end of while
+				if (hit->empty() || hit->front().empty()) return std::nullopt;
+				return hit->front().begin()->second;
+			} // end of if
+			cacheEpoch = cache->epoch();
+		} // end of if
+
+		struct ScalarSink
+		{
+			Impl& impl;
+			ResultCache* cache;
+			std::string& cacheKey;
+			uint64_t cacheEpoch;
+			std::optional<ColumnValue> value;
+
+			// The first row is all it needs
+			bool row(sqlite3_stmt* stmt)
+			{
+				if (sqlite3_column_count(stmt) > 0) value = impl.getColumnValue(stmt, 0);
+				return false;
+			} // end of row
+
+			// Cached as a one-cell result
+			void done(const Impl::StatementLease& lease, int rc)
+			{
+				if (!cache || (rc != SQLITE_ROW && rc != SQLITE_DONE) || !Impl::isCacheable(lease)) return;
+
+				ResultSet results;
+				if (value)
+				{
+					results.emplace_back().emplace(sqlite3_column_name(lease.stmt, 0), *value);
+				} // end of if
+				cache->insert(std::move(cacheKey), std::move(results), lease.footprint->tables, cacheEpoch);
+			} // end of done
+		}; // end of struct ScalarSink
+
+		ScalarSink sink{ *pImpl_, cache, cacheKey, cacheEpoch, std::nullopt };
+		pImpl_->runStatement(sql, params, sink);
+		return std::move(sink.value);
+	} // end of queryScalarImpl
+
+	ResultTable Analyzer::queryTable(const std::string& sql, const std::vector<ColumnValue>& params) const
+	{
+		return queryTableImpl(sql, params);
+	} // end of queryTable
+
+	ResultTable Analyzer::queryTableImpl(std::string_view sql, std::span<const ColumnValue> params) const
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db) return {};
+
+		struct TableSink
+		{
+			Impl& impl;
+			std::optional<std::vector<std::string>> columnNames;  // Set once the statement ran
+			std::vector<ColumnValue> cells;
+
+			void begin(sqlite3_stmt* stmt) { columnNames = Impl::columnNames(stmt); }
+
+			bool row(sqlite3_stmt* stmt)
+			{
+				for (size_t i = 0; i < columnNames->size(); ++i)
+				{
+					cells.push_back(impl.getColumnValue(stmt, static_cast<int>(i)));
+				} // end of for
+				return true;
+			} // end of row
+		}; // end of struct TableSink
+
+		TableSink sink{ *pImpl_, std::nullopt, {} };
+		pImpl_->runStatement(sql, params, sink);
+		if (!sink.columnNames) return {};
+
+		return ResultTable(std::make_shared<const ResultHeader>(std::move(*sink.columnNames)), std::move(sink.cells));
+	} // end of queryTableImpl
+
+	ArenaResultTable Analyzer::queryArena(const std::string& sql, const std::vector<ColumnValue>& params) const
+	{
+		return queryArenaImpl(sql, params);
+	} // end of queryArena
+
+	ArenaResultTable Analyzer::queryArenaImpl(std::string_view sql, std::span<const ColumnValue> params) const
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db) return {};
+
+		struct ArenaSink
+		{
+			Impl& impl;
+			std::optional<ArenaResultTable::Builder> table;  // Set once the statement ran
+			int columnCount = 0;
+
+			void begin(sqlite3_stmt* stmt)
+			{
+				columnCount = sqlite3_column_count(stmt);
+				table.emplace(std::make_shared<const ResultHeader>(Impl::columnNames(stmt)), impl.arenas_.acquire());
+			} // end of begin
+
+			bool row(sqlite3_stmt* stmt)
+			{
+				for (int i = 0; i < columnCount; ++i)
+				{
+					switch (sqlite3_column_type(stmt, i))
+					{
+					case SQLITE_INTEGER:
+						table->append(static_cast<int64_t>(sqlite3_column_int64(stmt, i)));
+						break;
+					case SQLITE_FLOAT:
+						table->append(sqlite3_column_double(stmt, i));
+						break;
+					case SQLITE_TEXT:
+					{
+						// Pointer before size, as for readColumnValue
+						const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
+						table->appendText(text, static_cast<size_t>(sqlite3_column_bytes(stmt, i)));
+						break;
+					} // end of case SQLITE_TEXT
+					case SQLITE_BLOB:
+					{
+						const void* data = sqlite3_column_blob(stmt, i);
+						table->appendBlob(data, static_cast<size_t>(sqlite3_column_bytes(stmt, i)));
+						break;
+					} // end of case SQLITE_BLOB
+					default:
+						table->appendNull();
+						break;
+					} // end of switch
+				} // end of for
+				return true;
+			} // end of row
+		}; // end of struct ArenaSink
+
+		ArenaSink sink{ *pImpl_, std::nullopt };
+		pImpl_->runStatement(sql, params, sink);
+		if (!sink.table) return {};
+
+		return std::move(*sink.table).finish();
+	} // end of queryArenaImpl
+
+	Cursor Analyzer::stream(const std::string& sql, const std::vector<ColumnValue>& params) const
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db) return Cursor();
+
+		// Cursors get their own statement: a cached one could be reused mid-scan
+		PhaseClock clock(pImpl_->metrics_ != nullptr);
+		std::chrono::nanoseconds prepareTime{ 0 };
+		sqlite3_stmt* stmt = nullptr;
+		if (sqlite3_prepare_v2(pImpl_->db, sql.c_str(), static_cast<int>(sql.size() + 1), &stmt, nullptr) != SQLITE_OK)
+		{
+			pImpl_->setLastError(sqlite3_errmsg(pImpl_->db));
 			sqlite3_finalize(stmt);
+			return Cursor();
 		} // end of if
 
-		// Cache it for next time
-		pImpl_->schemaCache[tableName] = schema;
+		// The cursor outlives params, so bound values are copied
+		if (detail::bindParameters(stmt, params, true) != SQLITE_OK)
+		{
+			pImpl_->setLastError(sqlite3_errmsg(pImpl_->db));
+			sqlite3_finalize(stmt);
+			return Cursor();
+		} // end of if
 
-		return schema;
-	} // end of getTableSchema
+		clock.charge(prepareTime);
 
-	ResultSet Analyzer::query(const std::string& sql) const
+		Cursor cursor(stmt, pImpl_->useMutex_ ? &pImpl_->dbMutex_ : nullptr);
+		if (pImpl_->metrics_)
+		{
+			// Reported when the cursor is finalized, under the lock; bound values
+			// were copied and are not kept, so no params are reported
+			Impl* impl = pImpl_.get();
+			cursor.reportTo([impl, prepareTime](StatementMetrics& statement) {
+				Impl::StatementLease lease;
+				lease.prepareTime = prepareTime;
+				statement.usedStatementCache = false;
+				impl->reportStatement(statement.sql, {}, lease, statement);
+				});
+		} // end of if
+		return cursor;
+	} // end of stream
+
+	bool Analyzer::beginRows(std::string_view sql, std::span<const ColumnValue> params, size_t minColumns,
+		std::unique_lock<std::mutex>& lock, RowView& row) const
 	{
-		std::lock_guard lock(pImpl_->dbMutex_);  // Thread-safe: serialize all DB operations
+		lock = pImpl_->lockDb();  // Thread-safe; held until endRows()
 
-		ResultSet results;
-		if (!pImpl_->db) return results;
+		if (!pImpl_->db) return false;
 
-		sqlite3_stmt* stmt;
+		Impl::StatementRun& run = pImpl_->reading_.emplace(pImpl_->metrics_ != nullptr, sql, params);
+		if (!pImpl_->beginRun(run))
+		{
+			pImpl_->reading_.reset();
+			return false;
+		} // end of if
 
-		if (sqlite3_prepare_v2(pImpl_->db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+		const size_t columnCount = static_cast<size_t>(sqlite3_column_count(run.lease.stmt));
+		if (columnCount < minColumns)
 		{
-			pImpl_->lastError = sqlite3_errmsg(pImpl_->db);  // ✅ Clean
-			return results;
+			pImpl_->setLastError("Query returns " + std::to_string(columnCount) + " columns, expected at least " +
+				std::to_string(minColumns));
+			Impl::releaseStatement(run.lease);
+			pImpl_->reading_.reset();
+			return false;
 		} // end of if
 
-		int columnCount = sqlite3_column_count(stmt);
+		row = RowView(run.lease.stmt, columnCount);
+		return true;
+	} // end of beginRows
+
+	bool Analyzer::nextRow() const
+	{
+		return pImpl_->stepRun(*pImpl_->reading_);
+	} // end of nextRow
+
+	bool Analyzer::endRows() const
+	{
+		bool ok = pImpl_->endRun(*pImpl_->reading_);
+		pImpl_->reading_.reset();
+		return ok;
+	} // end of endRows
+
+	Blob Analyzer::openBlob(const std::string& tableName, const std::string& column_, int64_t rowid,
+		BlobMode mode) const
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db) return Blob();
 
-		while (sqlite3_step(stmt) == SQLITE_ROW)
+		sqlite3_blob* blob = nullptr;
+		int rc = sqlite3_blob_open(pImpl_->db, "main", tableName.c_str(), column_.c_str(), rowid,
+			mode == BlobMode::ReadWrite ? 1 : 0, &blob);
+		if (rc != SQLITE_OK)
 		{
-			Row row;
-			for (int i = 0; i < columnCount; ++i)
-			{
-				std::string columnName = sqlite3_column_name(stmt, i);
-				row[columnName] = pImpl_->getColumnValue(stmt, i);
-			} // end of for
-			results.push_back(std::move(row));
-		} // end of while
+			pImpl_->setLastError(sqlite3_errmsg(pImpl_->db));
+			sqlite3_blob_close(blob);  // Null on failure; close is a no-op then
+			return Blob();
+		} // end of if
 
-		sqlite3_finalize(stmt);
-		return results;
-	} // end of query
+		Blob result(pImpl_->db, blob, pImpl_->useMutex_ ? &pImpl_->dbMutex_ : nullptr);
+		if (mode == BlobMode::ReadWrite)
+		{
+			// Called with the lock held, as the update hook would be
+			Impl* impl = pImpl_.get();
+			result.notifyWrites([impl, tableName] {
+				impl->noteWrite(tableName.c_str());
+				impl->flushInvalidations();
+				});
+		} // end of if
+		return result;
+	} // end of openBlob
 
 	ResultSet Analyzer::selectAll(const std::string& tableName) const
 	{
@@ -294,16 +1422,41 @@ namespace sqlite_flux
 
 	bool Analyzer::execute(const std::string& sql)
 	{
-		std::lock_guard lock(pImpl_->dbMutex_);  // Thread-safe
+		auto lock = pImpl_->lockDb();  // Thread-safe
 
 		if (!pImpl_->db) return false;
 
+		bool hasTail = false;
+		auto lease = pImpl_->acquireStatement(sql, &hasTail);
+
+		StatementMetrics statement;
+		if (lease.stmt && !hasTail)
+		{
+			bool ok = pImpl_->stepToCompletion(lease.stmt, statement);
+			statement.success = ok;
+			pImpl_->reportStatement(sql, {}, lease, statement);
+			Impl::releaseStatement(lease);
+			return ok;
+		} // end of if
+
+		Impl::releaseStatement(lease);
+
+		// Multi-statement scripts (and prepare failures) go through sqlite3_exec,
+		// reported as one statement outside the statement cache, with its prepare
+		// time included in step
+		statement.usedStatementCache = false;
 		char* errMsg = nullptr;
+		PhaseClock clock(pImpl_->metrics_ != nullptr);
 		int rc = sqlite3_exec(pImpl_->db, sql.c_str(), nullptr, nullptr, &errMsg);
+		clock.charge(statement.step);
+		pImpl_->flushInvalidations();
+
+		statement.success = rc == SQLITE_OK;
+		pImpl_->reportStatement(sql, {}, Impl::StatementLease{}, statement);
 
 		if (rc != SQLITE_OK)
 		{
-			pImpl_->lastError = errMsg ? errMsg : "Unknown error";
+			pImpl_->setLastError(errMsg ? errMsg : "Unknown error");
 			sqlite3_free(errMsg);
 			return false;
 		} // end of if
@@ -311,6 +1464,91 @@ namespace sqlite_flux
 		return true;
 	} // end of execute
 
+	bool Analyzer::execute(const std::string& sql, const std::vector<ColumnValue>& params)
+	{
+		if (params.empty())
+		{
+			return execute(sql);
+		} // end of if
+
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db) return false;
+
+		bool hasTail = false;
+		auto lease = pImpl_->acquireStatement(sql, &hasTail);
+		if (!lease.stmt)
+		{
+			return false;
+		} // end of if
+
+		bool ok = false;
+		StatementMetrics statement;
+		if (hasTail)
+		{
+			pImpl_->setLastError("Parameter binding requires a single SQL statement");
+		} // end of if
+		else if (pImpl_->bindParameters(lease.stmt, params))
+		{
+			ok = pImpl_->stepToCompletion(lease.stmt, statement);
+			statement.success = ok;
+			pImpl_->reportStatement(sql, params, lease, statement);
+		} // end of else if
+
+		Impl::releaseStatement(lease);
+		return ok;
+	} // end of execute
+
+	ExecuteResult Analyzer::executeDml(const std::string& sql, const std::vector<ColumnValue>& params)
+	{
+		return executeDmlImpl(sql, params);
+	} // end of executeDml
+
+	ExecuteResult Analyzer::executeDmlImpl(std::string_view sql, std::span<const ColumnValue> params)
+	{
+		ExecuteResult result;
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db)
+		{
+			result.error = "Database is not open";
+			return result;
+		} // end of if
+
+		bool hasTail = false;
+		auto lease = pImpl_->acquireStatement(sql, &hasTail);
+		if (!lease.stmt)
+		{
+			result.error = pImpl_->getLastError();
+			return result;
+		} // end of if
+
+		StatementMetrics statement;
+		if (hasTail)
+		{
+			pImpl_->setLastError("executeDml requires a single SQL statement");
+		} // end of if
+		else if (pImpl_->bindParameters(lease.stmt, params))
+		{
+			result.success = pImpl_->stepToCompletion(lease.stmt, statement);
+			statement.success = result.success;
+			pImpl_->reportStatement(sql, params, lease, statement);
+		} // end of else if
+
+		if (result.success)
+		{
+			result.changes = sqlite3_changes64(pImpl_->db);
+			result.lastInsertRowid = sqlite3_last_insert_rowid(pImpl_->db);
+		} // end of if
+		else
+		{
+			result.error = pImpl_->getLastError();
+		} // end of else
+
+		Impl::releaseStatement(lease);
+		return result;
+	} // end of executeDmlImpl
+
 	bool Analyzer::beginTransaction()
 	{
 		return execute("BEGIN TRANSACTION");
@@ -326,102 +1564,222 @@ namespace sqlite_flux
 		return execute("ROLLBACK");
 	} // end of rollback
 
+	bool Analyzer::isInTransaction() const
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db) return false;
+		return sqlite3_get_autocommit(pImpl_->db) == 0;
+	} // end of isInTransaction
+
 	std::string Analyzer::getLastError() const
 	{
-		std::lock_guard lock(pImpl_->dbMutex_);  // Thread-safe
-		return pImpl_->lastError;
+		return pImpl_->getLastError();
 	} // end of getLastError
 
 	std::optional<int64_t> Analyzer::getRowCount(const std::string& tableName) const
 	{
-		auto result = query("SELECT COUNT(*) as count FROM " + tableName);
-		if (result.empty()) return std::nullopt;
+		auto count = queryScalar("SELECT COUNT(*) FROM " + tableName);
+		if (!count) return std::nullopt;
 
-		return getValue<int64_t>(result[0], "count");
+		auto* value = std::get_if<int64_t>(&*count);
+		if (!value) return std::nullopt;
+		return *value;
 	} // end of getRowCount
 
 	void Analyzer::cacheAllSchemas()
 	{
-		// Quick check if already done
-		if (pImpl_->isCacheInitialized.load(std::memory_order_acquire))
-		{
-			return;  // ✅ Already cached
-		}
+		pImpl_->currentSchema();
+	} // end of cacheAllSchemas
 
-		std::unique_lock lock(pImpl_->schemaMutex_);  // Exclusive lock for write
-		// ✅ Double-check after acquiring lock
-		if (pImpl_->isCacheInitialized.load(std::memory_order_acquire))
-		{
-			return;
-		}
-		std::lock_guard dbLock(pImpl_->dbMutex_);     // Serialize DB access
+	bool Analyzer::isSchemaCached() const
+	{
+		return pImpl_->sharedSchema_->current() != nullptr;
+	} // end of isSchemaCached
 
-		if (!pImpl_->db) return;
+	void Analyzer::clearSchemaCache()
+	{
+		pImpl_->sharedSchema_->invalidate();
+	} // end of clearSchemaCache
 
-		// Get all table names
-		std::vector<std::string> tables;
-		const char* query = "SELECT name FROM sqlite_master "
-			"WHERE type='table' AND name NOT LIKE 'sqlite_%'";
+	std::optional<TableSchema> Analyzer::getCachedSchema(const std::string& tableName) const
+	{
+		auto snapshot = pImpl_->sharedSchema_->current();
+		if (!snapshot) return std::nullopt;
 
-		sqlite3_stmt* stmt;
-		if (sqlite3_prepare_v2(pImpl_->db, query, -1, &stmt, nullptr) == SQLITE_OK)
+		const TableDescriptor* table = snapshot->find(tableName);
+		if (!table) return std::nullopt;
+		return table->columns();
+	} // end of getCachedSchema
+
+	std::shared_ptr<const SchemaSnapshot> Analyzer::getSchemaSnapshot() const
+	{
+		return pImpl_->currentSchema();
+	} // end of getSchemaSnapshot
+
+	std::shared_ptr<const TableDescriptor> Analyzer::getTableDescriptor(const std::string& tableName) const
+	{
+		auto snapshot = pImpl_->currentSchema();
+		if (!snapshot) return nullptr;
+
+		const TableDescriptor* table = snapshot->find(tableName);
+		if (!table) return nullptr;
+		return std::shared_ptr<const TableDescriptor>(std::move(snapshot), table);
+	} // end of getTableDescriptor
+
+	void Analyzer::shareSchema(std::shared_ptr<SharedSchema> schema)
+	{
+		pImpl_->sharedSchema_ = std::move(schema);
+	} // end of shareSchema
+
+	std::shared_ptr<SharedSchema> Analyzer::getSharedSchema() const
+	{
+		return pImpl_->sharedSchema_;
+	} // end of getSharedSchema
+
+	void Analyzer::setStatementCacheCapacity(size_t capacity)
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		pImpl_->stmtCapacity_ = capacity;
+		pImpl_->evictToCapacity();
+	} // end of setStatementCacheCapacity
+
+	size_t Analyzer::getStatementCacheCapacity() const
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+		return pImpl_->stmtCapacity_;
+	} // end of getStatementCacheCapacity
+
+	StatementCacheStats Analyzer::getStatementCacheStats() const
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		StatementCacheStats stats;
+		stats.hits = pImpl_->stmtHits_;
+		stats.misses = pImpl_->stmtMisses_;
+		stats.evictions = pImpl_->stmtEvictions_;
+		stats.size = pImpl_->stmtLru_.size();
+		stats.capacity = pImpl_->stmtCapacity_;
+		return stats;
+	} // end of getStatementCacheStats
+
+	void Analyzer::clearStatementCache()
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+		pImpl_->finalizeCachedStatements();
+	} // end of clearStatementCache
+
+	bool Analyzer::warmStatementCache(const std::vector<std::string>& sqls)
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db) return false;
+
+		bool allPrepared = true;
+		for (const auto& sql : sqls)
 		{
-			while (sqlite3_step(stmt) == SQLITE_ROW)
+			auto lease = pImpl_->acquireStatement(sql);
+			if (!lease.stmt)
 			{
-				tables.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
-			} // end of while
+				allPrepared = false;
+			} // end of if
+			Impl::releaseStatement(lease);
+		} // end of for
+
+		return allPrepared;
+	} // end of warmStatementCache
+
+	sqlite3_stmt* Analyzer::prepareStatement(const std::string& sql)
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db) return nullptr;
+
+		sqlite3_stmt* stmt = nullptr;
+		if (sqlite3_prepare_v3(pImpl_->db, sql.c_str(), static_cast<int>(sql.size() + 1),
+			SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK)
+		{
+			pImpl_->setLastError(sqlite3_errmsg(pImpl_->db));
 			sqlite3_finalize(stmt);
+			return nullptr;
 		} // end of if
 
-		// Cache each table's schema
-		for (const auto& tableName : tables)
+		return stmt;
+	} // end of prepareStatement
+
+	ExecuteResult Analyzer::executePrepared(sqlite3_stmt* stmt, std::span<const ColumnValue> params)
+	{
+		ExecuteResult result;
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db || !stmt)
 		{
-			TableSchema schema;
-			std::string schemaQuery = "PRAGMA table_info(" + tableName + ")";
+			result.error = "Database is not open or statement is null";
+			return result;
+		} // end of if
 
-			if (sqlite3_prepare_v2(pImpl_->db, schemaQuery.c_str(), -1, &stmt, nullptr) == SQLITE_OK)
-			{
-				while (sqlite3_step(stmt) == SQLITE_ROW)
-				{
-					ColumnInfo info;
-					info.name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-					info.type = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-					info.notNull = sqlite3_column_int(stmt, 3) != 0;
-					info.primaryKey = sqlite3_column_int(stmt, 5) != 0;
-					schema.push_back(info);
-				} // end of while
-				sqlite3_finalize(stmt);
-			} // end of if
+		pImpl_->busyRetries_ = 0;
+		StatementMetrics statement;
+		if (pImpl_->bindParameters(stmt, params))
+		{
+			result.success = pImpl_->stepToCompletion(stmt, statement);
+			statement.success = result.success;
 
-			pImpl_->schemaCache[tableName] = schema;
-		} // end of for
+			// Prepared by the caller: always a statement-cache hit, no prepare time
+			Impl::StatementLease lease;
+			lease.cacheHit = true;
+			if (pImpl_->metrics_) pImpl_->reportStatement(sqlite3_sql(stmt), params, lease, statement);
+		} // end of if
 
-		pImpl_->isCacheInitialized.store(true, std::memory_order_release);
-	} // end of cacheAllSchemas
+		if (result.success)
+		{
+			result.changes = sqlite3_changes64(pImpl_->db);
+			result.lastInsertRowid = sqlite3_last_insert_rowid(pImpl_->db);
+		} // end of if
+		else
+		{
+			result.error = pImpl_->getLastError();
+		} // end of else
 
-	bool Analyzer::isSchemaCached() const
+		sqlite3_reset(stmt);
+		sqlite3_clear_bindings(stmt);
+		return result;
+	} // end of executePrepared
+
+	void Analyzer::setResultCache(std::shared_ptr<ResultCache> cache)
 	{
-		return pImpl_->isCacheInitialized.load(std::memory_order_acquire);
-	} // end of isSchemaCached
+		auto lock = pImpl_->lockDb();  // Thread-safe
 
-	void Analyzer::clearSchemaCache()
+		pImpl_->resultCache_ = std::move(cache);
+		pImpl_->pendingInvalidations_.clear();
+		pImpl_->pendingClear_ = false;
+		pImpl_->installCacheHooks();
+
+		// Statements prepared without the authorizer have no footprint
+		pImpl_->finalizeCachedStatements();
+	} // end of setResultCache
+
+	std::shared_ptr<ResultCache> Analyzer::getResultCache() const
 	{
-		std::unique_lock lock(pImpl_->schemaMutex_);  // Exclusive lock
-		pImpl_->schemaCache.clear();
-		pImpl_->isCacheInitialized.store(false, std::memory_order_release);
-	} // end of clearSchemaCache
+		auto lock = pImpl_->lockDb();  // Thread-safe
+		return pImpl_->resultCache_;
+	} // end of getResultCache
 
-	std::optional<TableSchema> Analyzer::getCachedSchema(const std::string& tableName) const
+	void Analyzer::invalidateResultCache(const std::string& tableName)
 	{
-		std::shared_lock lock(pImpl_->schemaMutex_);  // Shared lock (concurrent reads)
+		auto lock = pImpl_->lockDb();  // Thread-safe
 
-		auto it = pImpl_->schemaCache.find(tableName);
-		if (it != pImpl_->schemaCache.end())
-		{
-			return it->second;
-		} // end of if
+		pImpl_->noteWrite(tableName.c_str());
+		pImpl_->flushInvalidations();
+	} // end of invalidateResultCache
 
-		return std::nullopt;
-	} // end of getCachedSchema
+	int Analyzer::getVariableLimit() const
+	{
+		auto lock = pImpl_->lockDb();  // Thread-safe
+
+		if (!pImpl_->db) return 0;
+		return sqlite3_limit(pImpl_->db, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+	} // end of getVariableLimit
 
 } // namespace sqlite_flux
\ No newline at end of file
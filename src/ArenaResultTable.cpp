@@ -0,0 +1,179 @@
+// src/ArenaResultTable.cpp
+#include "ArenaResultTable.h"
+#include "ValueVisitor.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace sqlite_flux
+{
+
+	ColumnValue toColumnValue(const ArenaValue& value_)
+	{
+		return std::visit(overloaded{
+			[](std::monostate) -> ColumnValue { return std::monostate{}; },
+			[](int64_t v) -> ColumnValue { return v; },
+			[](double v) -> ColumnValue { return v; },
+			[](std::string_view v) -> ColumnValue { return std::string(v); },
+			[](std::span<const uint8_t> v) -> ColumnValue { return std::vector<uint8_t>(v.begin(), v.end()); }
+			}, value_);
+	} // end of toColumnValue
+
+	// ============================================================================
+	// Builder implementation
+	// ============================================================================
+
+	ArenaResultTable::Builder::Builder(std::shared_ptr<const ResultHeader> header, std::shared_ptr<ResultArena> arena)
+		: header_(std::move(header)), arena_(std::move(arena)), cells_(arena_.get())
+	{
+	} // end of Builder constructor
+
+	void ArenaResultTable::Builder::appendNull()
+	{
+		cells_.emplace_back(std::monostate{});
+	} // end of appendNull
+
+	void ArenaResultTable::Builder::append(int64_t value_)
+	{
+		cells_.emplace_back(value_);
+	} // end of append
+
+	void ArenaResultTable::Builder::append(double value_)
+	{
+		cells_.emplace_back(value_);
+	} // end of append
+
+	void ArenaResultTable::Builder::appendText(const char* data, size_t size)
+	{
+		if (size == 0)
+		{
+			cells_.emplace_back(std::string_view());
+			return;
+		} // end of if
+
+		char* copy = static_cast<char*>(arena_->allocate(size, alignof(char)));
+		std::memcpy(copy, data, size);
+		cells_.emplace_back(std::string_view(copy, size));
+	} // end of appendText
+
+	void ArenaResultTable::Builder::appendBlob(const void* data, size_t size)
+	{
+		if (size == 0)
+		{
+			cells_.emplace_back(std::span<const uint8_t>());
+			return;
+		} // end of if
+
+		auto* copy = static_cast<uint8_t*>(arena_->allocate(size, alignof(uint8_t)));
+		std::memcpy(copy, data, size);
+		cells_.emplace_back(std::span<const uint8_t>(copy, size));
+	} // end of appendBlob
+
+	ArenaResultTable ArenaResultTable::Builder::finish() &&
+	{
+		if (header_ && !header_->names.empty() && cells_.size() % header_->names.size() != 0)
+		{
+			throw std::logic_error("ArenaResultTable cell count is not a multiple of the column count");
+		} // end of if
+
+		// The cells vector moves with its allocator, so it stays in the arena
+		auto storage = std::make_shared<Storage>(Storage{ std::move(arena_), std::move(cells_) });
+
+		ArenaResultTable table;
+		table.header_ = std::move(header_);
+		table.storage_ = std::move(storage);
+		return table;
+	} // end of finish
+
+	// ============================================================================
+	// ArenaResultTable implementation
+	// ============================================================================
+
+	size_t ArenaResultTable::rowCount() const
+	{
+		size_t columns = columnCount();
+		return columns == 0 || !storage_ ? 0 : storage_->cells.size() / columns;
+	} // end of rowCount
+
+	const std::vector<std::string>& ArenaResultTable::columnNames() const
+	{
+		static const std::vector<std::string> noColumns;
+		return header_ ? header_->names : noColumns;
+	} // end of columnNames
+
+	std::optional<size_t> ArenaResultTable::columnIndex(const std::string& column_) const
+	{
+		if (!header_)
+		{
+			return std::nullopt;
+		} // end of if
+		return header_->find(column_);
+	} // end of columnIndex
+
+	const ArenaValue& ArenaResultTable::at(size_t row, size_t col) const
+	{
+		if (row >= rowCount() || col >= columnCount())
+		{
+			throw std::out_of_range("ArenaResultTable cell (" + std::to_string(row) + ", " +
+				std::to_string(col) + ") out of range");
+		} // end of if
+		return cell(row, col);
+	} // end of at
+
+	const ArenaValue& ArenaResultTable::at(size_t row, const std::string& column_) const
+	{
+		auto col = columnIndex(column_);
+		if (!col)
+		{
+			throw std::out_of_range("Column '" + column_ + "' not in result");
+		} // end of if
+		return at(row, *col);
+	} // end of at
+
+	size_t ArenaResultTable::arenaBytes() const
+	{
+		return storage_ && storage_->arena ? storage_->arena->bytesAllocated() : 0;
+	} // end of arenaBytes
+
+	ResultTable ArenaResultTable::toResultTable() const
+	{
+		std::vector<ColumnValue> cells;
+		if (storage_)
+		{
+			cells.reserve(storage_->cells.size());
+			for (const ArenaValue& value_ : storage_->cells)
+			{
+				cells.push_back(toColumnValue(value_));
+			} // end of for
+		} // end of if
+
+		return ResultTable(header_, std::move(cells));
+	} // end of toResultTable
+
+	ResultSet ArenaResultTable::toResultSet() const
+	{
+		ResultSet results;
+		results.reserve(rowCount());
+
+		for (auto row : *this)
+		{
+			results.push_back(row.toRow());
+		} // end of for
+
+		return results;
+	} // end of toResultSet
+
+	Row ArenaResultTable::RowRef::toRow() const
+	{
+		Row row;
+		const auto& names = table_->columnNames();
+		row.reserve(names.size());
+
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			row[names[i]] = toColumnValue((*this)[i]);
+		} // end of for
+
+		return row;
+	} // end of toRow
+
+} // namespace sqlite_flux
@@ -1,6 +1,19 @@
 // src/AsyncExecutor.cpp
 #include "AsyncExecutor.h"
+#include "ValueVisitor.h"
 #include <stdexcept>
+#include <algorithm>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
 
 namespace sqlite_flux
 {
@@ -9,23 +22,53 @@ namespace sqlite_flux
 	// ThreadPool implementation
 	// ============================================================================
 
+	namespace
+	{
+		// Set on worker threads so submissions from inside the pool stay local
+		thread_local const ThreadPool* tlsWorkerPool = nullptr;
+		thread_local size_t tlsWorkerIndex = 0;
+
+		ThreadPoolOptions optionsWithThreads(size_t numThreads)
+		{
+			ThreadPoolOptions options;
+			options.numThreads = numThreads;
+			return options;
+		} // end of optionsWithThreads
+	} // namespace
+
 	ThreadPool::ThreadPool(size_t numThreads)
+		: ThreadPool(optionsWithThreads(numThreads))
 	{
-		if (numThreads == 0)
+	} // end of ThreadPool constructor
+
+	ThreadPool::ThreadPool(const ThreadPoolOptions& options)
+		: options_(options)
+	{
+		if (options_.numThreads == 0)
 		{
 			throw std::invalid_argument("Thread pool size must be greater than 0");
 		} // end of if
 
-		for (size_t i = 0; i < numThreads; ++i)
+		queues_ = std::make_unique<WorkerQueue[]>(options_.numThreads);
+
+		for (size_t i = 0; i < options_.numThreads; ++i)
 		{
-			workers_.emplace_back([this] { workerThread(); });
+			workers_.emplace_back([this, i] { workerThread(i); });
 		} // end of for
 	} // end of ThreadPool constructor
 
 	ThreadPool::~ThreadPool()
 	{
 		stop_.store(true, std::memory_order_release);
-		condition_.notify_all();
+
+		// Wake sleepers and blocked submitters under their mutexes (no lost wakeups)
+		std::unique_lock sleepLock(sleepMutex_);
+		sleepCv_.notify_all();
+		sleepLock.unlock();
+
+		std::unique_lock spaceLock(spaceMutex_);
+		spaceCv_.notify_all();
+		spaceLock.unlock();
 
 		for (std::thread& worker : workers_)
 		{
@@ -36,149 +79,675 @@ namespace sqlite_flux
 		} // end of for
 	} // end of ThreadPool destructor
 
-	void ThreadPool::workerThread()
+	void ThreadPool::post(SmallTask job)
 	{
-		while (true)
+		if (tlsWorkerPool == this)
 		{
-			std::function<void()> task;
+			// Continuations from our own workers bypass the bound: blocking here
+			// could wait on the very worker that has to make room
+			pending_.fetch_add(1);
+		} // end of if
+		else if (!reserveSlot(options_.overflowPolicy == OverflowPolicy::Block))
+		{
+			throw ThreadPoolFullError();
+		} // end of else if
 
-			{
-				std::unique_lock lock(queueMutex_);
+		push(std::move(job));
+	} // end of post
 
-				condition_.wait(lock, [this] {
-					return stop_.load(std::memory_order_acquire) || !tasks_.empty();
-					});
+	bool ThreadPool::tryPost(SmallTask job)
+	{
+		if (tlsWorkerPool == this)
+		{
+			pending_.fetch_add(1);
+		} // end of if
+		else if (!reserveSlot(false))
+		{
+			return false;
+		} // end of else if
+
+		push(std::move(job));
+		return true;
+	} // end of tryPost
+
+	bool ThreadPool::reserveSlot(bool mayWait)
+	{
+		if (stop_.load(std::memory_order_acquire))
+		{
+			throw std::runtime_error("ThreadPool is stopped");
+		} // end of if
 
-				if (stop_.load(std::memory_order_acquire) && tasks_.empty())
+		const size_t capacity = options_.queueCapacity;
+		if (capacity == 0)
+		{
+			pending_.fetch_add(1);
+			return true;
+		} // end of if
+
+		for (;;)
+		{
+			size_t current = pending_.load();
+			while (current < capacity)
+			{
+				if (pending_.compare_exchange_weak(current, current + 1))
 				{
-					return;  // Exit thread
+					return true;
 				} // end of if
+			} // end of while
 
-				if (!tasks_.empty())
+			if (!mayWait)
+			{
+				return false;
+			} // end of if
+
+			// Backpressure: sleep until a worker takes something off the queue
+			std::unique_lock lock(spaceMutex_);
+			blockedSubmitters_.fetch_add(1);
+			spaceCv_.wait(lock, [this, capacity] {
+				return pending_.load() < capacity || stop_.load(std::memory_order_acquire);
+				});
+			blockedSubmitters_.fetch_sub(1);
+
+			if (stop_.load(std::memory_order_acquire))
+			{
+				throw std::runtime_error("ThreadPool is stopped");
+			} // end of if
+		} // end of for
+	} // end of reserveSlot
+
+	void ThreadPool::push(SmallTask job)
+	{
+		if (options_.metrics)
+		{
+			job = [this, inner = std::move(job), queuedAt = std::chrono::steady_clock::now()]() mutable {
+				const auto started = std::chrono::steady_clock::now();
+				TaskMetrics task;
+				task.queued = started - queuedAt;
+				task.queueDepth = pending_.load(std::memory_order_relaxed);
+
+				inner();
+
+				task.run = std::chrono::steady_clock::now() - started;
+				options_.metrics->onTask(task);
+				};
+		} // end of if
+
+		size_t index = tlsWorkerPool == this
+			? tlsWorkerIndex
+			: nextQueue_.fetch_add(1, std::memory_order_relaxed) % options_.numThreads;
+
+		{
+			std::lock_guard lock(queues_[index].mutex);
+			queues_[index].tasks.push_back(std::move(job));
+		} // end of lock scope
+
+		// Pairs with the sleeper raising sleeping_ before it re-checks pending_
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (sleeping_.load() > 0)
+		{
+			std::lock_guard lock(sleepMutex_);
+			sleepCv_.notify_one();
+		} // end of if
+	} // end of push
+
+	bool ThreadPool::tryTake(size_t self, SmallTask& out)
+	{
+		// Own deque first, newest task (its data is most likely still in cache)
+		{
+			std::lock_guard lock(queues_[self].mutex);
+			auto& own = queues_[self].tasks;
+			if (!own.empty())
+			{
+				out = std::move(own.back());
+				own.pop_back();
+				return true;
+			} // end of if
+		} // end of lock scope
+
+		// Then steal the oldest task from the other workers
+		const size_t count = options_.numThreads;
+		for (size_t k = 1; k < count; ++k)
+		{
+			WorkerQueue& victim = queues_[(self + k) % count];
+			std::unique_lock lock(victim.mutex, std::try_to_lock);
+			if (lock.owns_lock() && !victim.tasks.empty())
+			{
+				out = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				stolen_.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			} // end of if
+		} // end of for
+
+		return false;
+	} // end of tryTake
+
+	void ThreadPool::workerThread(size_t index)
+	{
+		tlsWorkerPool = this;
+		tlsWorkerIndex = index;
+
+		if (options_.pinToCores)
+		{
+			pinCurrentThread(index);
+		} // end of if
+
+		while (true)
+		{
+			SmallTask task;
+			if (tryTake(index, task))
+			{
+				pending_.fetch_sub(1);
+				if (blockedSubmitters_.load() > 0)
 				{
-					task = std::move(tasks_.front());
-					tasks_.pop();
+					std::lock_guard lock(spaceMutex_);
+					spaceCv_.notify_one();
 				} // end of if
-			} // end of lock scope
 
-			if (task)
-			{
 				task();
+				continue;
+			} // end of if
+
+			if (pending_.load() > 0)
+			{
+				// Reserved but not pushed yet, or a victim's lock was busy
+				std::this_thread::yield();
+				continue;
 			} // end of if
+
+			if (stop_.load(std::memory_order_acquire))
+			{
+				return;  // Exit thread once drained
+			} // end of if
+
+			std::unique_lock lock(sleepMutex_);
+			sleeping_.fetch_add(1);
+			sleepCv_.wait(lock, [this] {
+				return pending_.load() > 0 || stop_.load(std::memory_order_acquire);
+				});
+			sleeping_.fetch_sub(1);
 		} // end of while
 	} // end of workerThread
 
+	void ThreadPool::pinCurrentThread(size_t index)
+	{
+		unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+#if defined(__linux__)
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(index % cores, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+		cores = std::min(cores, 64u);  // One affinity mask covers a single processor group
+		SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << (index % cores));
+#else
+		(void)index;
+		(void)cores;  // No portable affinity API; workers stay unpinned
+#endif
+	} // end of pinCurrentThread
+
 	size_t ThreadPool::pendingTasks() const
 	{
-		std::lock_guard lock(queueMutex_);
-		return tasks_.size();
+		return pending_.load(std::memory_order_relaxed);
 	} // end of pendingTasks
 
 	// ============================================================================
 	// AsyncExecutor implementation
 	// ============================================================================
 
-	AsyncExecutor::AsyncExecutor(ConnectionPool& pool, size_t threadPoolSize)
-		: pool_(pool), threadPool_(threadPoolSize)
+	AsyncExecutor::AsyncExecutor(ConnectionPool& pool, size_t threadPoolSize, ResumeExecutor resumeExecutor)
+		: pool_(pool), resumeExecutor_(std::move(resumeExecutor)), threadPool_(threadPoolSize)
 	{
 	} // end of AsyncExecutor constructor
 
+	AsyncExecutor::AsyncExecutor(ConnectionPool& pool, const ThreadPoolOptions& threadPoolOptions,
+		ResumeExecutor resumeExecutor, const GroupCommitOptions& groupCommit)
+		: pool_(pool), resumeExecutor_(std::move(resumeExecutor)), threadPool_(threadPoolOptions)
+	{
+		if (groupCommit.enabled)
+		{
+			WriteBatcherOptions batcherOptions;
+			batcherOptions.maxBatchRows = groupCommit.maxBatch;
+			batcherOptions.maxDelay = groupCommit.maxDelay;
+			writeBatcher_ = std::make_unique<WriteBatcher>(pool_, batcherOptions);
+		} // end of if
+	} // end of AsyncExecutor constructor
+
 	AsyncExecutor::~AsyncExecutor() = default;
 
+	// Each lambda captures its arguments by value: the coroutine outlives the call
+
 	Task<ResultSet> AsyncExecutor::query(const std::string& sql)
 	{
-		auto future = threadPool_.enqueue([this, sql]() {
-			auto conn = pool_.acquire();
+		return run([this, sql]() {
+			auto conn = pool_.acquireRead();
 			return conn->query(sql);
 			});
-
-		co_return future.get();
 	} // end of query
 
 	Task<ResultSet> AsyncExecutor::selectAll(const std::string& tableName)
 	{
-		auto future = threadPool_.enqueue([this, tableName]() {
-			auto conn = pool_.acquire();
+		return run([this, tableName]() {
+			auto conn = pool_.acquireRead();
 			return conn->selectAll(tableName);
 			});
-
-		co_return future.get();
 	} // end of selectAll
 
 	Task<ResultSet> AsyncExecutor::selectWhere(const std::string& tableName, const std::string& whereClause)
 	{
-		auto future = threadPool_.enqueue([this, tableName, whereClause]() {
-			auto conn = pool_.acquire();
+		return run([this, tableName, whereClause]() {
+			auto conn = pool_.acquireRead();
 			return conn->selectWhere(tableName, whereClause);
 			});
-
-		co_return future.get();
 	} // end of selectWhere
 
 	Task<bool> AsyncExecutor::execute(const std::string& sql)
 	{
-		auto future = threadPool_.enqueue([this, sql]() {
-			auto conn = pool_.acquire();
+		return run([this, sql]() {
+			auto conn = pool_.acquireWrite();
 			return conn->execute(sql);
 			});
-
-		co_return future.get();
 	} // end of execute
 
+	Task<ExecuteResult> AsyncExecutor::write(const std::string& sql, std::vector<ColumnValue> params)
+	{
+		if (writeBatcher_)
+		{
+			return groupWrite(sql, std::move(params));
+		} // end of if
+
+		return run([this, sql, params = std::move(params)]() {
+			auto conn = pool_.acquireWrite();
+			return conn->executeDml(sql, params);
+			});
+	} // end of write
+
+	Task<AsyncTransaction> AsyncExecutor::transaction()
+	{
+		// Blocking a worker on the writer could take the worker the open
+		// transaction needs to commit, so queue for the slot suspended instead
+		struct SlotAwaiter
+		{
+			AsyncExecutor& executor;
+
+			bool await_ready() const noexcept { return false; }
+
+			bool await_suspend(std::coroutine_handle<> awaiting)
+			{
+				std::lock_guard lock(executor.transactionMutex_);
+				if (!executor.transactionOpen_)
+				{
+					executor.transactionOpen_ = true;
+					return false;  // Free: carry on without suspending
+				} // end of if
+
+				executor.transactionWaiters_.push_back(awaiting);
+				return true;
+			} // end of await_suspend
+
+			void await_resume() const noexcept {}
+		}; // end of struct SlotAwaiter
+
+		SlotAwaiter slot{ *this };
+		co_await slot;
+
+		try
+		{
+			co_return co_await run([this]() {
+				auto conn = pool_.acquireWrite();
+
+				// IMMEDIATE takes the write lock now, so later statements cannot hit
+				// SQLITE_BUSY halfway through the transaction
+				if (!conn->execute("BEGIN IMMEDIATE"))
+				{
+					throw std::runtime_error("Failed to begin transaction: " + conn->getLastError());
+				} // end of if
+
+				return AsyncTransaction(*this, std::move(conn));
+				});
+		} // end of try
+		catch (...)
+		{
+			releaseTransactionSlot();
+			throw;
+		} // end of catch
+	} // end of transaction
+
 	Task<bool> AsyncExecutor::beginTransaction()
 	{
-		auto future = threadPool_.enqueue([this]() {
-			auto conn = pool_.acquire();
+		return run([this]() {
+			auto conn = pool_.acquireWrite();
 			return conn->beginTransaction();
 			});
-
-		co_return future.get();
 	} // end of beginTransaction
 
 	Task<bool> AsyncExecutor::commit()
 	{
-		auto future = threadPool_.enqueue([this]() {
-			auto conn = pool_.acquire();
+		return run([this]() {
+			auto conn = pool_.acquireWrite();
 			return conn->commit();
 			});
-
-		co_return future.get();
 	} // end of commit
 
 	Task<bool> AsyncExecutor::rollback()
 	{
-		auto future = threadPool_.enqueue([this]() {
-			auto conn = pool_.acquire();
+		return run([this]() {
+			auto conn = pool_.acquireWrite();
 			return conn->rollback();
 			});
-
-		co_return future.get();
 	} // end of rollback
 
 	Task<int64_t> AsyncExecutor::count(const std::string& tableName)
 	{
-		auto future = threadPool_.enqueue([this, tableName]() -> int64_t {
-			auto conn = pool_.acquire();
+		return run([this, tableName]() -> int64_t {
+			auto conn = pool_.acquireRead();
 			auto result = conn->getRowCount(tableName);
 			return result.value_or(0);
 			});
-
-		co_return future.get();
 	} // end of count
 
 	Task<bool> AsyncExecutor::exists(const std::string& tableName, const std::string& whereClause)
 	{
-		auto future = threadPool_.enqueue([this, tableName, whereClause]() -> bool {
-			auto conn = pool_.acquire();
-			QueryFactory factory(*conn);
-			return factory.FromTable(tableName)
-				.Filter(whereClause, int64_t(1))
-				.Any();
+		// whereClause is raw SQL, as in selectWhere
+		return run([this, tableName, whereClause]() -> bool {
+			auto conn = pool_.acquireRead();
+			auto result = conn->query("SELECT EXISTS(SELECT 1 FROM " + tableName +
+				" WHERE " + whereClause + ") AS found");
+			if (result.empty()) return false;
+			return getValue<int64_t>(result[0], "found").value_or(0) != 0;
 			});
-
-		co_return future.get();
 	} // end of exists
 
+	// ============================================================================
+	// Group commit
+	// ============================================================================
+
+	Task<ExecuteResult> AsyncExecutor::groupWrite(std::string sql, std::vector<ColumnValue> params)
+	{
+		struct SubmitAwaiter
+		{
+			AsyncExecutor& executor;
+			std::string& sql;
+			std::vector<ColumnValue>& params;
+			ExecuteResult result;
+
+			bool await_ready() const noexcept { return false; }
+
+			void await_suspend(std::coroutine_handle<> awaiting)
+			{
+				// The awaiter lives in the suspended frame until the completion resumes it
+				executor.writeBatcher_->submit(std::move(sql), std::move(params),
+					[this, awaiting](ExecuteResult written) {
+						result = std::move(written);
+						executor.resumeLater(awaiting);
+					});
+			} // end of await_suspend
+
+			ExecuteResult await_resume() { return std::move(result); }
+		}; // end of struct SubmitAwaiter
+
+		// Named, and owning nothing: GCC 12 mishandles owning aggregate temporaries in co_await
+		SubmitAwaiter awaiter{ *this, sql, params, {} };
+		co_return co_await awaiter;
+	} // end of groupWrite
+
+	void AsyncExecutor::resumeLater(std::coroutine_handle<> awaiting)
+	{
+		if (resumeExecutor_)
+		{
+			resumeExecutor_([awaiting] { awaiting.resume(); });
+			return;
+		} // end of if
+
+		try
+		{
+			threadPool_.post([awaiting] { awaiting.resume(); });
+		} // end of try
+		catch (const ThreadPoolFullError&)
+		{
+			// Never drop a continuation: finish it on the batcher's thread instead
+			awaiting.resume();
+		} // end of catch
+	} // end of resumeLater
+
+	void AsyncExecutor::releaseTransactionSlot()
+	{
+		std::coroutine_handle<> next;
+		{
+			std::lock_guard lock(transactionMutex_);
+			if (transactionWaiters_.empty())
+			{
+				transactionOpen_ = false;
+				return;
+			} // end of if
+
+			// The slot passes straight to the next caller
+			next = transactionWaiters_.front();
+			transactionWaiters_.pop_front();
+		} // end of lock scope
+
+		resumeLater(next);
+	} // end of releaseTransactionSlot
+
+	// ============================================================================
+	// AsyncTransaction implementation
+	// ============================================================================
+
+	struct AsyncTransaction::State
+	{
+		AsyncExecutor* executor;
+		std::optional<ConnectionPool::Connection> connection;  // Reset once finished
+
+		// The connection is exclusive-use: one operation on it at a time
+		std::mutex mutex;
+		std::deque<SmallTask> queued;
+		bool running = false;  // A worker is draining queued
+	}; // end of struct AsyncTransaction::State
+
+	AsyncTransaction::AsyncTransaction(AsyncExecutor& executor, ConnectionPool::Connection connection)
+		: state_(std::make_shared<State>()), active_(true)
+	{
+		state_->executor = &executor;
+		state_->connection.emplace(std::move(connection));
+	} // end of AsyncTransaction constructor
+
+	AsyncTransaction::~AsyncTransaction()
+	{
+		rollbackNow();
+	} // end of AsyncTransaction destructor
+
+	AsyncTransaction::AsyncTransaction(AsyncTransaction&& other) noexcept
+		: state_(std::move(other.state_)), active_(std::exchange(other.active_, false))
+	{
+	} // end of AsyncTransaction move constructor
+
+	AsyncTransaction& AsyncTransaction::operator=(AsyncTransaction&& other) noexcept
+	{
+		if (this != &other)
+		{
+			rollbackNow();
+			state_ = std::move(other.state_);
+			active_ = std::exchange(other.active_, false);
+		} // end of if
+		return *this;
+	} // end of AsyncTransaction move assignment
+
+	void AsyncTransaction::submit(const std::shared_ptr<State>& state, SmallTask op)
+	{
+		{
+			std::lock_guard lock(state->mutex);
+			state->queued.push_back(std::move(op));
+			if (state->running) return;  // The draining worker picks it up
+			state->running = true;
+		} // end of lock scope
+
+		try
+		{
+			state->executor->threadPool_.post([state] { drain(state); });
+		} // end of try
+		catch (...)
+		{
+			// Nothing was running, so op is the only one queued
+			std::lock_guard lock(state->mutex);
+			state->queued.clear();
+			state->running = false;
+			throw;
+		} // end of catch
+	} // end of submit
+
+	void AsyncTransaction::drain(const std::shared_ptr<State>& state)
+	{
+		for (;;)
+		{
+			SmallTask op;
+			{
+				std::lock_guard lock(state->mutex);
+				if (state->queued.empty())
+				{
+					state->running = false;
+					return;
+				} // end of if
+				op = std::move(state->queued.front());
+				state->queued.pop_front();
+			} // end of lock scope
+
+			op();
+		} // end of for
+	} // end of drain
+
+	template<typename F>
+	auto AsyncTransaction::onConnection(std::shared_ptr<State> state, F work) -> Task<std::invoke_result_t<F&, State&>>
+	{
+		using result_type = std::invoke_result_t<F&, State&>;
+
+		struct QueueAwaiter
+		{
+			std::shared_ptr<State>& state;
+			F& work;
+			std::optional<result_type>& result;
+			std::exception_ptr& error;
+
+			bool await_ready() const noexcept { return false; }
+
+			void await_suspend(std::coroutine_handle<> awaiting)
+			{
+				// The awaiter lives in the suspended frame until the op resumes it
+				submit(state, [this, awaiting] {
+					try
+					{
+						result.emplace(work(*state));
+					} // end of try
+					catch (...)
+					{
+						error = std::current_exception();
+					} // end of catch
+					state->executor->resumeLater(awaiting);
+					});
+			} // end of await_suspend
+
+			void await_resume() const noexcept {}
+		}; // end of struct QueueAwaiter
+
+		// Named, and owning nothing, as in groupWrite
+		std::optional<result_type> result;
+		std::exception_ptr error;
+		QueueAwaiter awaiter{ state, work, result, error };
+		co_await awaiter;
+
+		if (error)
+		{
+			std::rethrow_exception(error);
+		} // end of if
+
+		co_return std::move(*result);
+	} // end of onConnection
+
+	Task<ResultSet> AsyncTransaction::query(const std::string& sql, std::vector<ColumnValue> params)
+	{
+		if (!active_)
+		{
+			throw std::runtime_error("Transaction is no longer active");
+		} // end of if
+
+		return onConnection(state_, [sql, params = std::move(params)](State& state) {
+			return (*state.connection)->query(sql, params);
+			});
+	} // end of query
+
+	Task<ExecuteResult> AsyncTransaction::execute(const std::string& sql, std::vector<ColumnValue> params)
+	{
+		if (!active_)
+		{
+			throw std::runtime_error("Transaction is no longer active");
+		} // end of if
+
+		return onConnection(state_, [sql, params = std::move(params)](State& state) {
+			return (*state.connection)->executeDml(sql, params);
+			});
+	} // end of execute
+
+	Task<ExecuteResult> AsyncTransaction::commit()
+	{
+		return finish("COMMIT");
+	} // end of commit
+
+	Task<ExecuteResult> AsyncTransaction::rollback()
+	{
+		return finish("ROLLBACK");
+	} // end of rollback
+
+	Task<ExecuteResult> AsyncTransaction::finish(const char* sql)
+	{
+		if (!active_)
+		{
+			throw std::runtime_error("Transaction is no longer active");
+		} // end of if
+
+		// The handle lets go here; the queued operations keep the state alive,
+		// so moving or destroying the handle is safe
+		active_ = false;
+		return onConnection(std::move(state_), [sql](State& state) {
+			ExecuteResult result;
+			result.success = (*state.connection)->execute(sql);
+			if (!result.success)
+			{
+				result.error = (*state.connection)->getLastError();
+				(*state.connection)->rollback();  // Still open after a failed COMMIT
+			} // end of if
+
+			// Release the writer straight away rather than when the Task dies
+			state.connection.reset();
+			state.executor->releaseTransactionSlot();
+			return result;
+			});
+	} // end of finish
+
+	void AsyncTransaction::rollbackAndRelease(State& state) noexcept
+	{
+		if (!state.connection) return;
+
+		(*state.connection)->rollback();
+		state.connection.reset();
+		state.executor->releaseTransactionSlot();
+	} // end of rollbackAndRelease
+
+	void AsyncTransaction::rollbackNow() noexcept
+	{
+		std::shared_ptr<State> state = std::move(state_);
+		if (!std::exchange(active_, false) || !state) return;
+
+		// Behind any operation still running; the draining worker holds the state
+		try
+		{
+			submit(state, [raw = state.get()] { rollbackAndRelease(*raw); });
+		} // end of try
+		catch (...)
+		{
+			rollbackAndRelease(*state);  // Could not queue it, and nothing is running
+		} // end of catch
+	} // end of rollbackNow
+
 	size_t AsyncExecutor::availableConnections() const
 	{
 		return pool_.available();
@@ -0,0 +1,410 @@
+// src/BlobStream.cpp
+#include "BlobStream.h"
+#include <sqlite3.h>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// Blob implementation
+	// ============================================================================
+
+	Blob::Blob(sqlite3* db, sqlite3_blob* blob, std::mutex* dbMutex)
+		: db_(db), blob_(blob), dbMutex_(dbMutex)
+	{
+		if (blob_)
+		{
+			size_ = static_cast<size_t>(sqlite3_blob_bytes(blob_));
+		} // end of if
+	} // end of Blob constructor
+
+	Blob::~Blob()
+	{
+		close();
+	} // end of Blob destructor
+
+	Blob::Blob(Blob&& other) noexcept
+		: db_(std::exchange(other.db_, nullptr))
+		, blob_(std::exchange(other.blob_, nullptr))
+		, dbMutex_(std::exchange(other.dbMutex_, nullptr))
+		, onWrite_(std::exchange(other.onWrite_, nullptr))
+		, size_(std::exchange(other.size_, 0))
+		, position_(std::exchange(other.position_, 0))
+		, lastError_(std::move(other.lastError_))
+	{
+	} // end of Blob move constructor
+
+	Blob& Blob::operator=(Blob&& other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+			db_ = std::exchange(other.db_, nullptr);
+			blob_ = std::exchange(other.blob_, nullptr);
+			dbMutex_ = std::exchange(other.dbMutex_, nullptr);
+			onWrite_ = std::exchange(other.onWrite_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+			position_ = std::exchange(other.position_, 0);
+			lastError_ = std::move(other.lastError_);
+		} // end of if
+		return *this;
+	} // end of Blob move assignment
+
+	std::unique_lock<std::mutex> Blob::lockDb() const
+	{
+		return dbMutex_ ? std::unique_lock<std::mutex>(*dbMutex_) : std::unique_lock<std::mutex>();
+	} // end of lockDb
+
+	void Blob::notifyWrites(std::function<void()> onWrite)
+	{
+		onWrite_ = std::move(onWrite);
+	} // end of notifyWrites
+
+	// Requires the db lock: the message belongs to the connection
+	bool Blob::fail(int rc)
+	{
+		lastError_ = db_ ? sqlite3_errmsg(db_) : sqlite3_errstr(rc);
+		return false;
+	} // end of fail
+
+	size_t Blob::read(std::span<uint8_t> dst)
+	{
+		size_t count = std::min(dst.size(), size_ - std::min(position_, size_));
+		if (count == 0)
+		{
+			return 0;
+		} // end of if
+
+		if (!readAt(position_, dst.first(count)))
+		{
+			return 0;
+		} // end of if
+
+		position_ += count;
+		return count;
+	} // end of read
+
+	bool Blob::write(std::span<const uint8_t> src)
+	{
+		if (!writeAt(position_, src))
+		{
+			return false;
+		} // end of if
+
+		position_ += src.size();
+		return true;
+	} // end of write
+
+	bool Blob::readAt(size_t offset, std::span<uint8_t> dst)
+	{
+		if (!blob_)
+		{
+			lastError_ = "Blob is not open";
+			return false;
+		} // end of if
+
+		if (offset > size_ || dst.size() > size_ - offset)
+		{
+			lastError_ = "Blob read past the end (" + std::to_string(size_) + " bytes)";
+			return false;
+		} // end of if
+
+		if (dst.empty())
+		{
+			return true;
+		} // end of if
+
+		// Blob sizes are ints, so the checked range fits
+		auto lock = lockDb();  // The handle is shared with the Analyzer's other calls
+		int rc = sqlite3_blob_read(blob_, dst.data(), static_cast<int>(dst.size()), static_cast<int>(offset));
+		return rc == SQLITE_OK || fail(rc);
+	} // end of readAt
+
+	bool Blob::writeAt(size_t offset, std::span<const uint8_t> src)
+	{
+		if (!blob_)
+		{
+			lastError_ = "Blob is not open";
+			return false;
+		} // end of if
+
+		if (offset > size_ || src.size() > size_ - offset)
+		{
+			lastError_ = "Blob write past the end (" + std::to_string(size_) +
+				" bytes; preallocate with zeroblob)";
+			return false;
+		} // end of if
+
+		if (src.empty())
+		{
+			return true;
+		} // end of if
+
+		auto lock = lockDb();
+		int rc = sqlite3_blob_write(blob_, src.data(), static_cast<int>(src.size()), static_cast<int>(offset));
+		if (rc != SQLITE_OK)
+		{
+			return fail(rc);
+		} // end of if
+
+		if (onWrite_) onWrite_();
+		return true;
+	} // end of writeAt
+
+	bool Blob::seek(size_t offset)
+	{
+		if (offset > size_)
+		{
+			return false;
+		} // end of if
+
+		position_ = offset;
+		return true;
+	} // end of seek
+
+	bool Blob::reopen(int64_t rowid)
+	{
+		if (!blob_)
+		{
+			lastError_ = "Blob is not open";
+			return false;
+		} // end of if
+
+		auto lock = lockDb();
+		int rc = sqlite3_blob_reopen(blob_, rowid);
+		position_ = 0;
+		if (rc != SQLITE_OK)
+		{
+			size_ = 0;
+			return fail(rc);
+		} // end of if
+
+		size_ = static_cast<size_t>(sqlite3_blob_bytes(blob_));
+		return true;
+	} // end of reopen
+
+	void Blob::close()
+	{
+		if (blob_)
+		{
+			auto lock = lockDb();
+			sqlite3_blob_close(blob_);
+			blob_ = nullptr;
+		} // end of if
+
+		size_ = 0;
+		position_ = 0;
+	} // end of close
+
+	// ============================================================================
+	// BlobStreamBuf implementation
+	// ============================================================================
+	//
+	// At most one of the get and put areas is active. While reading, the Blob
+	// sits at the end of the get area; while writing, at its start.
+
+	BlobStreamBuf::BlobStreamBuf(Blob& blob, size_t bufferSize)
+		: blob_(blob), buffer_(std::max<size_t>(bufferSize, 1))
+	{
+	} // end of BlobStreamBuf constructor
+
+	BlobStreamBuf::~BlobStreamBuf()
+	{
+		flushPut();
+	} // end of BlobStreamBuf destructor
+
+	void BlobStreamBuf::dropReadAhead()
+	{
+		if (gptr())
+		{
+			blob_.seek(blob_.tell() - static_cast<size_t>(egptr() - gptr()));
+			setg(nullptr, nullptr, nullptr);
+		} // end of if
+	} // end of dropReadAhead
+
+	bool BlobStreamBuf::flushPut()
+	{
+		if (!pbase())
+		{
+			return true;
+		} // end of if
+
+		size_t pending = static_cast<size_t>(pptr() - pbase());
+		bool ok = blob_.write(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(pbase()), pending));
+		setp(nullptr, nullptr);
+		return ok;
+	} // end of flushPut
+
+	BlobStreamBuf::int_type BlobStreamBuf::underflow()
+	{
+		if (gptr() && gptr() < egptr())
+		{
+			return traits_type::to_int_type(*gptr());
+		} // end of if
+
+		if (!flushPut())
+		{
+			return traits_type::eof();
+		} // end of if
+
+		size_t count = blob_.read(std::span<uint8_t>(reinterpret_cast<uint8_t*>(buffer_.data()), buffer_.size()));
+		if (count == 0)
+		{
+			setg(nullptr, nullptr, nullptr);
+			return traits_type::eof();
+		} // end of if
+
+		setg(buffer_.data(), buffer_.data(), buffer_.data() + count);
+		return traits_type::to_int_type(*gptr());
+	} // end of underflow
+
+	BlobStreamBuf::int_type BlobStreamBuf::overflow(int_type ch)
+	{
+		dropReadAhead();
+		if (!flushPut())
+		{
+			return traits_type::eof();
+		} // end of if
+
+		// Never buffer more than still fits, so failures surface on the write that overran
+		size_t room = std::min(buffer_.size(), blob_.size() - std::min(blob_.tell(), blob_.size()));
+		if (traits_type::eq_int_type(ch, traits_type::eof()))
+		{
+			return traits_type::not_eof(ch);
+		} // end of if
+
+		if (room == 0)
+		{
+			return traits_type::eof();
+		} // end of if
+
+		setp(buffer_.data(), buffer_.data() + room);
+		*pptr() = traits_type::to_char_type(ch);
+		pbump(1);
+		return ch;
+	} // end of overflow
+
+	int BlobStreamBuf::sync()
+	{
+		return flushPut() ? 0 : -1;
+	} // end of sync
+
+	std::streamsize BlobStreamBuf::showmanyc()
+	{
+		size_t remaining = blob_.size() - std::min(blob_.tell(), blob_.size());
+		return remaining > 0 ? static_cast<std::streamsize>(remaining) : -1;
+	} // end of showmanyc
+
+	std::streamsize BlobStreamBuf::xsgetn(char* s, std::streamsize count)
+	{
+		std::streamsize done = 0;
+		while (done < count)
+		{
+			if (gptr() && gptr() < egptr())
+			{
+				std::streamsize chunk = std::min<std::streamsize>(egptr() - gptr(), count - done);
+				std::memcpy(s + done, gptr(), static_cast<size_t>(chunk));
+				gbump(static_cast<int>(chunk));
+				done += chunk;
+				continue;
+			} // end of if
+
+			// Buffer empty: read straight into the caller's memory when it is at
+			// least as large as the buffer
+			if (count - done >= static_cast<std::streamsize>(buffer_.size()))
+			{
+				if (!flushPut())
+				{
+					break;
+				} // end of if
+				setg(nullptr, nullptr, nullptr);
+
+				size_t got = blob_.read(std::span<uint8_t>(reinterpret_cast<uint8_t*>(s + done),
+					static_cast<size_t>(count - done)));
+				if (got == 0)
+				{
+					break;
+				} // end of if
+				done += static_cast<std::streamsize>(got);
+				continue;
+			} // end of if
+
+			if (traits_type::eq_int_type(underflow(), traits_type::eof()))
+			{
+				break;
+			} // end of if
+		} // end of while
+
+		return done;
+	} // end of xsgetn
+
+	std::streamsize BlobStreamBuf::xsputn(const char* s, std::streamsize count)
+	{
+		if (count < static_cast<std::streamsize>(buffer_.size()))
+		{
+			return std::streambuf::xsputn(s, count);
+		} // end of if
+
+		// Write straight from the caller's memory
+		dropReadAhead();
+		if (!flushPut())
+		{
+			return 0;
+		} // end of if
+
+		size_t room = blob_.size() - std::min(blob_.tell(), blob_.size());
+		size_t written = std::min(static_cast<size_t>(count), room);
+		if (!blob_.write(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(s), written)))
+		{
+			return 0;
+		} // end of if
+
+		return static_cast<std::streamsize>(written);
+	} // end of xsputn
+
+	BlobStreamBuf::pos_type BlobStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode)
+	{
+		dropReadAhead();
+		if (!flushPut())
+		{
+			return pos_type(off_type(-1));
+		} // end of if
+
+		off_type base = 0;
+		if (dir == std::ios_base::cur)
+		{
+			base = static_cast<off_type>(blob_.tell());
+		} // end of if
+		else if (dir == std::ios_base::end)
+		{
+			base = static_cast<off_type>(blob_.size());
+		} // end of else if
+
+		off_type target = base + off;
+		if (target < 0 || !blob_.seek(static_cast<size_t>(target)))
+		{
+			return pos_type(off_type(-1));
+		} // end of if
+
+		return pos_type(target);
+	} // end of seekoff
+
+	BlobStreamBuf::pos_type BlobStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+	{
+		return seekoff(off_type(pos), std::ios_base::beg, which);
+	} // end of seekpos
+
+	// ============================================================================
+	// BlobStream implementation
+	// ============================================================================
+
+	BlobStream::BlobStream(Blob& blob, size_t bufferSize)
+		: std::iostream(nullptr), buf_(blob, bufferSize)
+	{
+		rdbuf(&buf_);
+	} // end of BlobStream constructor
+
+} // namespace sqlite_flux
@@ -0,0 +1,44 @@
+// src/ConnectionOptions.cpp
+#include "ConnectionOptions.h"
+
+namespace sqlite_flux
+{
+
+	ConnectionOptions ConnectionOptions::forProfile(ConnectionProfile profile)
+	{
+		ConnectionOptions options;
+
+		switch (profile)
+		{
+		case ConnectionProfile::ReadHeavyMmap:
+			// Map as much of the file as SQLite allows; mapped pages need no copy
+			// into the page cache, so the cache itself can stay modest
+			options.mmapSizeBytes = int64_t{ 256 } * 1024 * 1024 * 1024;
+			options.cacheSizeKiB = 8 * 1024;
+			options.tempStore = TempStore::Memory;
+			break;
+		case ConnectionProfile::BulkIngest:
+			// WAL with synchronous=OFF cannot corrupt the database, but a power
+			// loss may drop the last commits
+			options.synchronous = Synchronous::Off;
+			options.cacheSizeKiB = 64 * 1024;
+			options.tempStore = TempStore::Memory;
+			options.busyTimeoutMs = 30000;
+			break;
+		case ConnectionProfile::LowMemory:
+			options.mmapSizeBytes = 0;
+			options.cacheSizeKiB = 512;
+			options.tempStore = TempStore::File;
+			options.resultArenas.initialBytes = 4 * 1024;
+			options.resultArenas.maxRetainedBytes = 64 * 1024;
+			options.resultArenas.maxIdleArenas = 1;
+			break;
+		case ConnectionProfile::Default:
+		default:
+			break;
+		} // end of switch
+
+		return options;
+	} // end of forProfile
+
+} // namespace sqlite_flux
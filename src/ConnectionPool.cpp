@@ -1,17 +1,34 @@
 // src/ConnectionPool.cpp
 #include "ConnectionPool.h"
+#include "Cursor.h"
 #include <stdexcept>
 #include <cassert>
+#include <algorithm>
+#include <filesystem>
 
 namespace sqlite_flux
 {
 
+	namespace
+	{
+		// The slot this thread last released, per pool. Reusing it keeps that
+		// connection's statement and page caches hot for this thread.
+		struct AffinityHint
+		{
+			uint64_t poolId = 0;
+			size_t slot = 0;
+		}; // end of struct AffinityHint
+
+		thread_local AffinityHint tlsAffinity;
+		std::atomic<uint64_t> nextPoolId{ 1 };
+	} // namespace
+
 	// ============================================================================
 	// Connection implementation
 	// ============================================================================
 
-	ConnectionPool::Connection::Connection(ConnectionPool* pool, std::unique_ptr<Analyzer> conn)
-		: pool_(pool), conn_(std::move(conn))
+	ConnectionPool::Connection::Connection(ConnectionPool* pool, Analyzer* conn, size_t slot, Lane lane)
+		: pool_(pool), conn_(conn), slot_(slot), lane_(lane)
 	{
 	} // end of Connection constructor
 
@@ -19,14 +36,15 @@ namespace sqlite_flux
 	{
 		if (conn_ && pool_)
 		{
-			pool_->release(std::move(conn_));
+			pool_->release(slot_, lane_);
 		} // end of if
 	} // end of Connection destructor
 
 	ConnectionPool::Connection::Connection(Connection&& other) noexcept
-		: pool_(other.pool_), conn_(std::move(other.conn_))
+		: pool_(other.pool_), conn_(other.conn_), slot_(other.slot_), lane_(other.lane_)
 	{
 		other.pool_ = nullptr;
+		other.conn_ = nullptr;
 	} // end of Connection move constructor
 
 	ConnectionPool::Connection& ConnectionPool::Connection::operator=(Connection&& other) noexcept
@@ -36,12 +54,15 @@ namespace sqlite_flux
 			// Release current connection first
 			if (conn_ && pool_)
 			{
-				pool_->release(std::move(conn_));
+				pool_->release(slot_, lane_);
 			} // end of if
 
 			pool_ = other.pool_;
-			conn_ = std::move(other.conn_);
+			conn_ = other.conn_;
+			slot_ = other.slot_;
+			lane_ = other.lane_;
 			other.pool_ = nullptr;
+			other.conn_ = nullptr;
 		} // end of if
 
 		return *this;
@@ -54,45 +75,177 @@ namespace sqlite_flux
 	ConnectionPool::ConnectionPool(
 		const std::string& dbPath,
 		size_t poolSize,
-		bool enableWAL)
+		bool enableWAL,
+		const std::vector<std::string>& warmupStatements)
+		: ConnectionPool(dbPath, PoolOptions{ poolSize, enableWAL, false, warmupStatements })
+	{
+	} // end of ConnectionPool constructor
+
+	ConnectionPool::ConnectionPool(const std::string& dbPath, const PoolOptions& options)
 		: dbPath_(dbPath)
-		, poolSize_(poolSize)
-		, enableWAL_(enableWAL)
-		, totalConnections_(0)
+		, poolSize_(options.poolSize)
+		, connectionOptions_(options.connection)
+		, readWriteSplit_(options.readWriteSplit)
+		, warmupStatements_(options.warmupStatements)
+		, resultCache_(options.resultCache)
+		, metrics_(options.metrics)
+		, id_(nextPoolId.fetch_add(1, std::memory_order_relaxed))
+		, slots_(std::make_unique<Slot[]>(options.poolSize + (options.readWriteSplit ? 1 : 0)))
+		, freeList_(options.poolSize > 0 ? options.poolSize : 1)
+		, emptySlots_(options.poolSize > 0 ? options.poolSize : 1)
+		, minPoolSize_(options.minPoolSize)
+		, idleTimeout_(options.idleTimeout)
+		, checkpointOptions_(options.checkpoint)
 	{
-		if (poolSize == 0)
+		connectionOptions_.enableWAL = options.enableWAL;
+
+		if (checkpointOptions_.enabled)
+		{
+			if (!options.enableWAL)
+			{
+				throw std::invalid_argument("Background checkpoints require WAL mode");
+			} // end of if
+
+			// The checkpointer takes over from commit-time checkpoints
+			if (checkpointOptions_.disableAutoCheckpoint && !connectionOptions_.walAutoCheckpointPages)
+			{
+				connectionOptions_.walAutoCheckpointPages = 0;
+			} // end of if
+		} // end of if
+
+		if (poolSize_ == 0)
 		{
 			throw std::invalid_argument("Connection pool size must be greater than 0");
 		} // end of if
 
-		// Pre-create all connections
-		for (size_t i = 0; i < poolSize_; ++i)
+		if (minPoolSize_ > poolSize_)
+		{
+			throw std::invalid_argument("Connection pool minimum size exceeds its maximum size");
+		} // end of if
+
+		// The writer goes first: it creates the file and switches it to WAL,
+		// which read-only connections cannot do themselves
+		if (readWriteSplit_)
 		{
-			auto conn = std::make_unique<Analyzer>(dbPath_);
+			slots_[poolSize_].conn = openConnection(Lane::Write);
+			writerIdle_ = true;
+			liveConnections_.fetch_add(1, std::memory_order_relaxed);
+		} // end of if
 
-			if (!conn->isOpen())
+		// Open the minimum up front; the remaining slots open on demand
+		for (size_t i = 0; i < poolSize_; ++i)
+		{
+			if (i < minPoolSize_)
 			{
-				throw std::runtime_error("Failed to open database connection: " + conn->getLastError());
+				slots_[i].conn = openConnection(readWriteSplit_ ? Lane::Read : Lane::Shared);
+				slots_[i].inFreeList.store(true, std::memory_order_relaxed);
+				freeList_.tryPush(i);
+				liveConnections_.fetch_add(1, std::memory_order_relaxed);
 			} // end of if
+			else
+			{
+				slots_[i].busy.store(true, std::memory_order_relaxed);
+				emptySlots_.tryPush(i);
+			} // end of else
+		} // end of for
 
-			// Enable WAL mode if requested
-			if (enableWAL_)
+		// Everything that can throw comes before the first thread starts: a
+		// joinable std::thread left behind by a throwing constructor terminates
+		if (checkpointOptions_.enabled)
+		{
+			// Not a pool slot: no schema, warm-up or result cache, and a short busy
+			// timeout so RESTART/TRUNCATE never hold writers up for long
+			ConnectionOptions options = connectionOptions_;
+			options.exclusiveUse = true;
+			options.readOnly = false;
+			options.metrics = metrics_;
+			options.busyTimeoutMs = static_cast<int>(checkpointOptions_.busyTimeout.count());
+
+			checkpointConn_ = std::make_unique<Analyzer>(dbPath_, options);
+			if (!checkpointConn_->isOpen() || !checkpointConn_->isWALMode())
 			{
-				conn->enableWALMode();
+				throw std::runtime_error("Failed to open checkpoint connection: " + checkpointConn_->getLastError());
 			} // end of if
 
-			// Cache schemas once per connection (optimization)
-			conn->cacheAllSchemas();
+			// Each WAL frame is a page plus a 24-byte header
+			auto pageSize = checkpointConn_->queryScalar("PRAGMA page_size");
+			const int64_t* bytes = pageSize ? std::get_if<int64_t>(&*pageSize) : nullptr;
+			frameBytes_ = (bytes ? *bytes : 4096) + 24;
+		} // end of if
 
-			pool_.push(std::move(conn));
-			++totalConnections_;
-		} // end of for
+		if (idleTimeout_.count() > 0)
+		{
+			reaper_ = std::thread(&ConnectionPool::reaperLoop, this);
+		} // end of if
+
+		if (checkpointConn_)
+		{
+			try
+			{
+				checkpointer_ = std::thread(&ConnectionPool::checkpointLoop, this);
+			} // end of try
+			catch (...)
+			{
+				stopBackgroundThreads();
+				throw;
+			} // end of catch
+		} // end of if
 	} // end of ConnectionPool constructor
 
+	std::unique_ptr<Analyzer> ConnectionPool::openConnection(Lane lane)
+	{
+		// A leased connection is only ever used by one thread at a time, so it
+		// skips both SQLite's and the Analyzer's connection mutex
+		ConnectionOptions options = connectionOptions_;
+		options.exclusiveUse = true;
+		options.readOnly = lane == Lane::Read;
+		options.metrics = metrics_;
+
+		auto conn = std::make_unique<Analyzer>(dbPath_, options);
+
+		if (!conn->isOpen())
+		{
+			throw std::runtime_error("Failed to open database connection: " + conn->getLastError());
+		} // end of if
+
+		// Belt and braces: also rejects writes to TEMP tables and ATTACHed databases
+		if (lane == Lane::Read && !conn->execute("PRAGMA query_only=1"))
+		{
+			throw std::runtime_error("Failed to configure read-only connection: " + conn->getLastError());
+		} // end of if
+
+		// Only the first connection reads every table's schema; later ones find it current
+		conn->shareSchema(sharedSchema_);
+		conn->cacheAllSchemas();
+
+		if (resultCache_)
+		{
+			conn->setResultCache(resultCache_);
+		} // end of if
+
+		created_.fetch_add(1, std::memory_order_relaxed);
+
+		// Pre-prepare the application's hot statements
+		if (!warmupStatements_.empty() && !conn->warmStatementCache(warmupStatements_))
+		{
+			throw std::runtime_error("Failed to prepare warm-up statement: " + conn->getLastError());
+		} // end of if
+
+		return conn;
+	} // end of openConnection
+
 	ConnectionPool::~ConnectionPool()
 	{
-		shutdown_.store(true, std::memory_order_release);
+		stopBackgroundThreads();
+
+		// Waiters check shutdown_ under their lane's mutex
+		std::unique_lock lock(mutex_);
 		cv_.notify_all();
+		lock.unlock();
+
+		std::unique_lock writerLock(writerMutex_);
+		writerCv_.notify_all();
+		writerLock.unlock();
 
 		// Check for outstanding connections (safety check)
 		size_t outstanding = outstandingConnections_.load(std::memory_order_acquire);
@@ -106,89 +259,450 @@ namespace sqlite_flux
 		} // end of if
 	} // end of ConnectionPool destructor
 
+	void ConnectionPool::stopBackgroundThreads()
+	{
+		shutdown_.store(true, std::memory_order_release);
+
+		if (reaper_.joinable())
+		{
+			std::unique_lock reaperLock(reaperMutex_);
+			reaperCv_.notify_all();
+			reaperLock.unlock();
+			reaper_.join();
+		} // end of if
+
+		if (checkpointer_.joinable())
+		{
+			std::unique_lock checkpointLock(checkpointMutex_);
+			checkpointCv_.notify_all();
+			checkpointLock.unlock();
+			checkpointer_.join();
+		} // end of if
+	} // end of stopBackgroundThreads
+
 	ConnectionPool::Connection ConnectionPool::acquire()
 	{
-		std::unique_lock lock(mutex_);
+		return readWriteSplit_ ? acquireWrite() : acquireRead();
+	} // end of acquire
 
-		// Wait until a connection is available
-		cv_.wait(lock, [this] {
-			return !pool_.empty() || shutdown_.load(std::memory_order_acquire);
-			});
+	std::optional<ConnectionPool::Connection> ConnectionPool::tryAcquire(std::chrono::milliseconds timeout)
+	{
+		return readWriteSplit_ ? tryAcquireWrite(timeout) : tryAcquireRead(timeout);
+	} // end of tryAcquire
 
-		if (shutdown_.load(std::memory_order_acquire))
+	ConnectionPool::Connection ConnectionPool::acquireRead()
+	{
+		return std::move(*acquireShared(std::nullopt));
+	} // end of acquireRead
+
+	std::optional<ConnectionPool::Connection> ConnectionPool::tryAcquireRead(std::chrono::milliseconds timeout)
+	{
+		return acquireShared(timeout);
+	} // end of tryAcquireRead
+
+	ConnectionPool::Connection ConnectionPool::acquireWrite()
+	{
+		if (!readWriteSplit_)
 		{
-			throw std::runtime_error("Connection pool is shutting down");
+			return acquireRead();
+		} // end of if
+
+		return std::move(*acquireWriter(std::nullopt));
+	} // end of acquireWrite
+
+	std::optional<ConnectionPool::Connection> ConnectionPool::tryAcquireWrite(std::chrono::milliseconds timeout)
+	{
+		if (!readWriteSplit_)
+		{
+			return tryAcquireRead(timeout);
 		} // end of if
 
-		if (pool_.empty())
+		return acquireWriter(timeout);
+	} // end of tryAcquireWrite
+
+	bool ConnectionPool::tryClaimSlot(size_t& slot)
+	{
+		// Fast path: the slot this thread used last, if nobody else holds it
+		if (tlsAffinity.poolId == id_)
 		{
-			throw std::runtime_error("No connections available (should not happen)");
+			bool expected = false;
+			if (slots_[tlsAffinity.slot].busy.compare_exchange_strong(expected, true))
+			{
+				slot = tlsAffinity.slot;
+				affinityHits_.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			} // end of if
 		} // end of if
 
-		auto conn = std::move(pool_.front());
-		pool_.pop();
+		// Fallback: lock-free free list. An index may be stale if its slot was
+		// claimed through the fast path meanwhile; clearing inFreeList first makes
+		// that holder re-queue the slot on release, so dropping it here is safe.
+		size_t candidate;
+		while (freeList_.tryPop(candidate))
+		{
+			slots_[candidate].inFreeList.store(false);
 
-		outstandingConnections_.fetch_add(1, std::memory_order_relaxed);
+			bool expected = false;
+			if (slots_[candidate].busy.compare_exchange_strong(expected, true))
+			{
+				slot = candidate;
+				return true;
+			} // end of if
+		} // end of while
 
-		return Connection(this, std::move(conn));
-	} // end of acquire
+		return false;
+	} // end of tryClaimSlot
 
-	std::optional<ConnectionPool::Connection> ConnectionPool::tryAcquire(std::chrono::milliseconds timeout)
+	ConnectionPool::Connection ConnectionPool::makeConnection(size_t slot, Lane lane, std::chrono::nanoseconds waited)
+	{
+		const size_t inUse = outstandingConnections_.fetch_add(1, std::memory_order_relaxed) + 1;
+		acquisitions_.fetch_add(1, std::memory_order_relaxed);
+
+		if (metrics_)
+		{
+			metrics_->onPoolAcquire(PoolAcquireMetrics{ waited, lane == Lane::Write, inUse,
+				liveConnections_.load(std::memory_order_relaxed) });
+		} // end of if
+
+		return Connection(this, slots_[slot].conn.get(), slot, lane);
+	} // end of makeConnection
+
+	ConnectionPool::Connection ConnectionPool::openInSlot(size_t slot, Lane lane, std::chrono::nanoseconds waited)
 	{
+		// The slot is already ours (empty slots stay busy), so open outside any lock
+		try
+		{
+			slots_[slot].conn = openConnection(lane);
+		} // end of try
+		catch (...)
+		{
+			emptySlots_.tryPush(slot);
+			notifyWaiters();
+			throw;
+		} // end of catch
+
+		liveConnections_.fetch_add(1, std::memory_order_relaxed);
+		return makeConnection(slot, lane, waited);
+	} // end of openInSlot
+
+	std::optional<ConnectionPool::Connection> ConnectionPool::acquireShared(
+		std::optional<std::chrono::milliseconds> timeout)
+	{
+		if (shutdown_.load(std::memory_order_acquire))
+		{
+			throw std::runtime_error("Connection pool is shutting down");
+		} // end of if
+
+		Lane lane = readWriteSplit_ ? Lane::Read : Lane::Shared;
+
+		size_t slot;
+		if (tryClaimSlot(slot))
+		{
+			return makeConnection(slot, lane);
+		} // end of if
+
+		// Every open connection is busy: grow if we are below the maximum
+		if (emptySlots_.tryPop(slot))
+		{
+			return openInSlot(slot, lane);
+		} // end of if
+
+		// Slow path: block until release() pushes a slot. waiters_ is raised before
+		// re-checking the free list, and release() checks it after pushing, so one
+		// side always sees the other.
+		const auto waitStart = metrics_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
 		std::unique_lock lock(mutex_);
+		waiters_.fetch_add(1);
+		waits_.fetch_add(1, std::memory_order_relaxed);
+
+		bool claimed = false;
+		bool mustOpen = false;
+		auto ready = [&] {
+			claimed = tryClaimSlot(slot) || (mustOpen = emptySlots_.tryPop(slot));
+			return claimed || shutdown_.load(std::memory_order_acquire);
+			};
+		if (timeout)
+		{
+			cv_.wait_for(lock, *timeout, ready);
+		} // end of if
+		else
+		{
+			cv_.wait(lock, ready);
+		} // end of else
+
+		waiters_.fetch_sub(1);
+		lock.unlock();
 
-		// Wait with timeout
-		bool available = cv_.wait_for(lock, timeout, [this] {
-			return !pool_.empty() || shutdown_.load(std::memory_order_acquire);
-			});
+		const std::chrono::nanoseconds waited = metrics_ ? std::chrono::steady_clock::now() - waitStart : std::chrono::nanoseconds{};
+
+		if (claimed)
+		{
+			if (shutdown_.load(std::memory_order_acquire))
+			{
+				if (mustOpen)
+				{
+					emptySlots_.tryPush(slot);
+				} // end of if
+				else
+				{
+					returnSlot(slot);
+				} // end of else
+				throw std::runtime_error("Connection pool is shutting down");
+			} // end of if
+			return mustOpen ? openInSlot(slot, lane, waited) : makeConnection(slot, lane, waited);
+		} // end of if
+
+		if (shutdown_.load(std::memory_order_acquire))
+		{
+			throw std::runtime_error("Connection pool is shutting down");
+		} // end of if
+
+		return std::nullopt;  // Timeout
+	} // end of acquireShared
+
+	std::optional<ConnectionPool::Connection> ConnectionPool::acquireWriter(
+		std::optional<std::chrono::milliseconds> timeout)
+	{
+		std::unique_lock lock(writerMutex_);
 
 		if (shutdown_.load(std::memory_order_acquire))
 		{
 			throw std::runtime_error("Connection pool is shutting down");
 		} // end of if
 
-		if (!available || pool_.empty())
+		std::chrono::nanoseconds waited{};
+
+		// Only take the idle writer directly if nobody is queued ahead of us
+		if (writerIdle_ && writeWaiters_.empty())
 		{
-			return std::nullopt;  // Timeout or no connections
+			writerIdle_ = false;
 		} // end of if
+		else
+		{
+			const auto waitStart = metrics_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+			WriteWaiter waiter;
+			writeWaiters_.push_back(&waiter);
+			waitingWriters_.fetch_add(1, std::memory_order_relaxed);
+			waits_.fetch_add(1, std::memory_order_relaxed);
+
+			auto granted = [this, &waiter] {
+				return waiter.granted || shutdown_.load(std::memory_order_acquire);
+				};
+			if (timeout)
+			{
+				writerCv_.wait_for(lock, *timeout, granted);
+			} // end of if
+			else
+			{
+				writerCv_.wait(lock, granted);
+			} // end of else
 
-		auto conn = std::move(pool_.front());
-		pool_.pop();
+			if (!waiter.granted)
+			{
+				// Timed out or shutting down: leave the queue without a grant
+				writeWaiters_.erase(std::find(writeWaiters_.begin(), writeWaiters_.end(), &waiter));
+				waitingWriters_.fetch_sub(1, std::memory_order_relaxed);
+
+				if (shutdown_.load(std::memory_order_acquire))
+				{
+					throw std::runtime_error("Connection pool is shutting down");
+				} // end of if
+				return std::nullopt;
+			} // end of if
 
-		outstandingConnections_.fetch_add(1, std::memory_order_relaxed);
+			if (metrics_) waited = std::chrono::steady_clock::now() - waitStart;
+		} // end of else
 
-		return Connection(this, std::move(conn));
-	} // end of tryAcquire
+		return makeConnection(poolSize_, Lane::Write, waited);
+	} // end of acquireWriter
 
-	void ConnectionPool::release(std::unique_ptr<Analyzer> conn)
+	Cursor ConnectionPool::stream(const std::string& sql, const std::vector<ColumnValue>& params)
 	{
-		if (!conn)
+		auto conn = acquireRead();
+
+		Cursor cursor = conn->stream(sql, params);
+		if (!cursor.isValid())
 		{
-			return;  // Nothing to release
+			throw std::runtime_error("Failed to prepare streaming query: " + conn->getLastError());
 		} // end of if
 
+		cursor.holdConnection(std::move(conn));
+		return cursor;
+	} // end of stream
+
+	void ConnectionPool::release(size_t slot, Lane lane)
+	{
 		outstandingConnections_.fetch_sub(1, std::memory_order_relaxed);
 
-		std::lock_guard lock(mutex_);
-		pool_.push(std::move(conn));
-		cv_.notify_one();  // Notify waiting threads
+		if (lane == Lane::Write)
+		{
+			std::lock_guard lock(writerMutex_);
+			if (!writeWaiters_.empty())
+			{
+				// Hand off to the oldest waiting writer
+				writeWaiters_.front()->granted = true;
+				writeWaiters_.pop_front();
+				waitingWriters_.fetch_sub(1, std::memory_order_relaxed);
+				writerCv_.notify_all();
+			} // end of if
+			else
+			{
+				writerIdle_ = true;
+			} // end of else
+			return;
+		} // end of if
+
+		tlsAffinity = AffinityHint{ id_, slot };
+		slots_[slot].idleSince.store(
+			std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+
+		returnSlot(slot);
 	} // end of release
 
+	void ConnectionPool::returnSlot(size_t slot)
+	{
+		Slot& s = slots_[slot];
+		s.busy.store(false);
+
+		// Queue the index unless it is already there (claimed via the fast path
+		// while its free-list entry was still pending)
+		if (!s.inFreeList.exchange(true))
+		{
+			freeList_.tryPush(slot);  // Never full: each index is queued at most once
+		} // end of if
+
+		notifyWaiters();
+	} // end of returnSlot
+
+	void ConnectionPool::notifyWaiters()
+	{
+		// Pairs with the waiter's fetch_add: either it sees the pushed slot or we see it
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (waiters_.load() > 0)
+		{
+			std::lock_guard lock(mutex_);
+			cv_.notify_one();  // Notify waiting threads
+		} // end of if
+	} // end of notifyWaiters
+
+	void ConnectionPool::reaperLoop()
+	{
+		auto interval = std::max(idleTimeout_ / 2, std::chrono::milliseconds(1));
+
+		std::unique_lock lock(reaperMutex_);
+		while (!shutdown_.load(std::memory_order_acquire))
+		{
+			reaperCv_.wait_for(lock, interval, [this] {
+				return shutdown_.load(std::memory_order_acquire);
+				});
+			if (shutdown_.load(std::memory_order_acquire)) break;
+
+			lock.unlock();
+			reapIdle();
+			lock.lock();
+		} // end of while
+	} // end of reaperLoop
+
+	void ConnectionPool::reapIdle()
+	{
+		const size_t writers = readWriteSplit_ ? 1 : 0;
+		const auto cutoff = (std::chrono::steady_clock::now() -
+			std::chrono::duration_cast<std::chrono::steady_clock::duration>(idleTimeout_)).time_since_epoch().count();
+
+		// The writer is never reaped; readers/shared slots go down to minPoolSize
+		for (size_t i = 0; i < poolSize_; ++i)
+		{
+			if (liveConnections_.load(std::memory_order_relaxed) - writers <= minPoolSize_) break;
+
+			// Claim it like an acquirer would, so nobody can lease it meanwhile
+			Slot& s = slots_[i];
+			bool expected = false;
+			if (!s.busy.compare_exchange_strong(expected, true)) continue;
+
+			if (s.conn && s.idleSince.load(std::memory_order_relaxed) <= cutoff)
+			{
+				s.conn.reset();
+				liveConnections_.fetch_sub(1, std::memory_order_relaxed);
+				reaped_.fetch_add(1, std::memory_order_relaxed);
+
+				// Stays busy; a stale free-list entry is dropped on pop
+				emptySlots_.tryPush(i);
+				notifyWaiters();
+			} // end of if
+			else
+			{
+				returnSlot(i);
+			} // end of else
+		} // end of for
+	} // end of reapIdle
+
+	void ConnectionPool::checkpointLoop()
+	{
+		auto interval = std::max(checkpointOptions_.interval, std::chrono::milliseconds(1));
+
+		std::unique_lock lock(checkpointMutex_);
+		while (!shutdown_.load(std::memory_order_acquire))
+		{
+			checkpointCv_.wait_for(lock, interval, [this] {
+				return shutdown_.load(std::memory_order_acquire);
+				});
+			if (shutdown_.load(std::memory_order_acquire)) break;
+
+			lock.unlock();
+			runCheckpoint();
+			lock.lock();
+		} // end of while
+	} // end of checkpointLoop
+
+	void ConnectionPool::runCheckpoint()
+	{
+		std::error_code ec;
+		const auto walFileBytes = static_cast<int64_t>(std::filesystem::file_size(dbPath_ + "-wal", ec));
+		if (ec || walFileBytes == 0) return;  // No WAL yet, or nothing written since a TRUNCATE
+
+		if (walFileBytes >= checkpointOptions_.truncateThresholdBytes)
+		{
+			checkpointConn_->checkpoint(CheckpointMode::Truncate);
+		} // end of if
+		else
+		{
+			// Wait for a quiet moment unless the WAL is already large: RESTART
+			// leaves the file at its size, so sustained load keeps this open
+			const bool quiet = outstandingConnections_.load(std::memory_order_relaxed) == 0;
+			if (!quiet && walFileBytes < checkpointOptions_.restartThresholdBytes) return;
+
+			// PASSIVE never waits, and tells us how much of the log is live
+			auto result = checkpointConn_->checkpoint(CheckpointMode::Passive);
+			if (result && int64_t{ result.logFrames } * frameBytes_ >= checkpointOptions_.restartThresholdBytes)
+			{
+				checkpoints_.fetch_add(1, std::memory_order_relaxed);
+				checkpointConn_->checkpoint(CheckpointMode::Restart);
+			} // end of if
+		} // end of else
+
+		checkpoints_.fetch_add(1, std::memory_order_relaxed);
+	} // end of runCheckpoint
+
 	size_t ConnectionPool::size() const
 	{
-		return totalConnections_;
+		return liveConnections_.load(std::memory_order_relaxed);
 	} // end of size
 
+	size_t ConnectionPool::maxSize() const
+	{
+		return poolSize_ + (readWriteSplit_ ? 1 : 0);
+	} // end of maxSize
+
 	size_t ConnectionPool::available() const
 	{
-		std::lock_guard lock(mutex_);
-		return pool_.size();
+		size_t live = size();
+		size_t outstanding = outstandingConnections_.load(std::memory_order_relaxed);
+		return outstanding < live ? live - outstanding : 0;
 	} // end of available
 
 	size_t ConnectionPool::inUse() const
 	{
-		std::lock_guard lock(mutex_);
-		return totalConnections_ - pool_.size();
+		return outstandingConnections_.load(std::memory_order_relaxed);
 	} // end of inUse
 
 	size_t ConnectionPool::outstandingConnections() const
@@ -196,4 +710,24 @@ namespace sqlite_flux
 		return outstandingConnections_.load(std::memory_order_relaxed);
 	} // end of outstandingConnections
 
+	size_t ConnectionPool::waitingWriters() const
+	{
+		return waitingWriters_.load(std::memory_order_relaxed);
+	} // end of waitingWriters
+
+	PoolStats ConnectionPool::getStats() const
+	{
+		PoolStats stats;
+		stats.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+		stats.affinityHits = affinityHits_.load(std::memory_order_relaxed);
+		stats.waits = waits_.load(std::memory_order_relaxed);
+		stats.created = created_.load(std::memory_order_relaxed);
+		stats.reaped = reaped_.load(std::memory_order_relaxed);
+		stats.checkpoints = checkpoints_.load(std::memory_order_relaxed);
+		stats.size = size();
+		stats.available = available();
+		stats.inUse = inUse();
+		return stats;
+	} // end of getStats
+
 } // namespace sqlite_flux
\ No newline at end of file
@@ -0,0 +1,264 @@
+// src/Cursor.cpp
+#include "Cursor.h"
+#include "StatementHelpers.h"
+#include <sqlite3.h>
+#include <chrono>
+#include <utility>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// Cursor::iterator implementation
+	// ============================================================================
+
+	Cursor::iterator& Cursor::iterator::operator++()
+	{
+		if (cursor_)
+		{
+			cursor_->next();
+		} // end of if
+		return *this;
+	} // end of operator++
+
+	// ============================================================================
+	// Cursor implementation
+	// ============================================================================
+
+	Cursor::Cursor(sqlite3_stmt* stmt, std::mutex* dbMutex)
+		: stmt_(stmt), dbMutex_(dbMutex)
+	{
+		if (!stmt_)
+		{
+			done_ = true;
+			return;
+		} // end of if
+
+		int columnCount = sqlite3_column_count(stmt_);
+		columnNames_.reserve(columnCount);
+		for (int i = 0; i < columnCount; ++i)
+		{
+			columnNames_.emplace_back(sqlite3_column_name(stmt_, i));
+		} // end of for
+	} // end of Cursor constructor
+
+	Cursor::~Cursor()
+	{
+		finalize();
+	} // end of Cursor destructor
+
+	Cursor::Cursor(Cursor&& other) noexcept
+		: connection_(std::move(other.connection_))
+		, stmt_(other.stmt_)
+		, dbMutex_(other.dbMutex_)
+		, columnNames_(std::move(other.columnNames_))
+		, started_(other.started_)
+		, hasRow_(other.hasRow_)
+		, done_(other.done_)
+		, lastError_(std::move(other.lastError_))
+		, rowsRead_(other.rowsRead_)
+		, report_(std::move(other.report_))
+		, stepTime_(other.stepTime_)
+	{
+		// row_/rowSlots_ are rebuilt on demand: slot pointers refer to other.row_
+		other.connection_.reset();
+		other.stmt_ = nullptr;
+		other.report_ = nullptr;
+		other.hasRow_ = false;
+		other.done_ = true;
+	} // end of Cursor move constructor
+
+	Cursor& Cursor::operator=(Cursor&& other) noexcept
+	{
+		if (this != &other)
+		{
+			finalize();
+			connection_.reset();
+
+			connection_ = std::move(other.connection_);
+			stmt_ = other.stmt_;
+			dbMutex_ = other.dbMutex_;
+			columnNames_ = std::move(other.columnNames_);
+			started_ = other.started_;
+			hasRow_ = other.hasRow_;
+			done_ = other.done_;
+			lastError_ = std::move(other.lastError_);
+			rowsRead_ = other.rowsRead_;
+			report_ = std::move(other.report_);
+			stepTime_ = other.stepTime_;
+			row_.clear();
+			rowSlots_.clear();
+			rowCurrent_ = false;
+
+			other.connection_.reset();
+			other.stmt_ = nullptr;
+			other.report_ = nullptr;
+			other.hasRow_ = false;
+			other.done_ = true;
+		} // end of if
+
+		return *this;
+	} // end of Cursor move assignment
+
+	void Cursor::holdConnection(ConnectionPool::Connection connection)
+	{
+		connection_.emplace(std::move(connection));
+	} // end of holdConnection
+
+	void Cursor::reportTo(std::function<void(StatementMetrics&)> report)
+	{
+		report_ = std::move(report);
+	} // end of reportTo
+
+	std::unique_lock<std::mutex> Cursor::lockDb() const
+	{
+		return dbMutex_ ? std::unique_lock<std::mutex>(*dbMutex_) : std::unique_lock<std::mutex>();
+	} // end of lockDb
+
+	void Cursor::finalize()
+	{
+		if (stmt_)
+		{
+			auto lock = lockDb();
+			if (report_)
+			{
+				StatementMetrics statement;
+				statement.sql = sqlite3_sql(stmt_);
+				statement.step = stepTime_;
+				statement.rows = rowsRead_;
+				statement.success = lastError_.empty();
+				std::exchange(report_, nullptr)(statement);
+			} // end of if
+			sqlite3_finalize(stmt_);
+			stmt_ = nullptr;
+		} // end of if
+		hasRow_ = false;
+	} // end of finalize
+
+	bool Cursor::next()
+	{
+		started_ = true;
+		rowCurrent_ = false;
+
+		if (!stmt_ || done_)
+		{
+			hasRow_ = false;
+			return false;
+		} // end of if
+
+		auto lock = lockDb();  // The handle is shared with the Analyzer's other calls
+		const auto started = report_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+		int rc = sqlite3_step(stmt_);
+		if (report_) stepTime_ += std::chrono::steady_clock::now() - started;
+
+		if (rc == SQLITE_ROW)
+		{
+			hasRow_ = true;
+			++rowsRead_;
+			return true;
+		} // end of if
+
+		if (rc != SQLITE_DONE)
+		{
+			lastError_ = sqlite3_errmsg(sqlite3_db_handle(stmt_));
+		} // end of if
+
+		// Release the read transaction as soon as the scan ends
+		hasRow_ = false;
+		done_ = true;
+		sqlite3_reset(stmt_);
+		return false;
+	} // end of next
+
+	std::optional<size_t> Cursor::columnIndex(const std::string& column_) const
+	{
+		for (size_t i = 0; i < columnNames_.size(); ++i)
+		{
+			if (columnNames_[i] == column_)
+			{
+				return i;
+			} // end of if
+		} // end of for
+
+		return std::nullopt;
+	} // end of columnIndex
+
+	ColumnValue Cursor::value(size_t col) const
+	{
+		if (!hasRow_ || col >= columnNames_.size())
+		{
+			return std::monostate{};
+		} // end of if
+
+		return detail::readColumnValue(stmt_, static_cast<int>(col));
+	} // end of value
+
+	std::vector<ColumnValue> Cursor::values() const
+	{
+		std::vector<ColumnValue> result;
+		if (!hasRow_) return result;
+
+		result.reserve(columnNames_.size());
+		for (size_t i = 0; i < columnNames_.size(); ++i)
+		{
+			result.push_back(detail::readColumnValue(stmt_, static_cast<int>(i)));
+		} // end of for
+
+		return result;
+	} // end of values
+
+	const Row& Cursor::row()
+	{
+		if (!hasRow_)
+		{
+			row_.clear();
+			rowSlots_.clear();
+			return row_;
+		} // end of if
+
+		if (rowCurrent_)
+		{
+			return row_;
+		} // end of if
+
+		// Build the key set once, then overwrite values in place for later rows
+		if (rowSlots_.size() != columnNames_.size())
+		{
+			row_.clear();
+			rowSlots_.clear();
+			row_.reserve(columnNames_.size());
+			for (const auto& name : columnNames_)
+			{
+				row_[name];
+			} // end of for
+			for (const auto& name : columnNames_)
+			{
+				rowSlots_.push_back(&row_[name]);
+			} // end of for
+		} // end of if
+
+		for (size_t i = 0; i < columnNames_.size(); ++i)
+		{
+			*rowSlots_[i] = detail::readColumnValue(stmt_, static_cast<int>(i));
+		} // end of for
+
+		rowCurrent_ = true;
+		return row_;
+	} // end of row
+
+	RowView Cursor::view() const
+	{
+		if (!hasRow_) return RowView();
+		return RowView(stmt_, columnNames_.size());
+	} // end of view
+
+	Cursor::iterator Cursor::begin()
+	{
+		if (!started_)
+		{
+			next();
+		} // end of if
+		return iterator(this);
+	} // end of begin
+
+} // namespace sqlite_flux
\ No newline at end of file
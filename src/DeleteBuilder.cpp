@@ -1,5 +1,6 @@
 // src/DeleteBuilder.cpp
 #include "DeleteBuilder.h"
+#include "WriteBatcher.h"
 #include "ValueVisitor.h"
 #include <sstream>
 #include <stdexcept>
@@ -9,24 +10,152 @@ namespace sqlite_flux
 {
 
 	// ============================================================================
-	// Helper function to convert CompareOp to SQL string
+	// PreparedDelete Implementation
 	// ============================================================================
 
-	static std::string compareOpToString(CompareOp op_)
+	PreparedDelete::PreparedDelete(Analyzer& analyzer, const std::string& tableName, bool allowUnsafe)
+		: analyzer_(analyzer), tableName_(tableName), allowUnsafe_(allowUnsafe)
 	{
-		switch (op_)
+		// Begin transaction for batch operations
+		if (!analyzer_.beginTransaction())
 		{
-		case CompareOp::Equal:              return "=";
-		case CompareOp::NotEqual:           return "!=";
-		case CompareOp::LessThan:           return "<";
-		case CompareOp::LessThanOrEqual:    return "<=";
-		case CompareOp::GreaterThan:        return ">";
-		case CompareOp::GreaterThanOrEqual: return ">=";
-		case CompareOp::Like:               return "LIKE";
-		case CompareOp::In:                 return "IN";
-		default:                            return "=";
-		} // end of switch
-	} // end of compareOpToString
+			throw std::runtime_error("Failed to begin transaction for batch delete");
+		} // end of if
+		inTransaction_ = true;
+	} // end of PreparedDelete constructor
+
+	PreparedDelete::~PreparedDelete()
+	{
+		cleanup();
+	} // end of PreparedDelete destructor
+
+	PreparedDelete::PreparedDelete(PreparedDelete&& other) noexcept
+		: analyzer_(other.analyzer_)
+		, tableName_(std::move(other.tableName_))
+		, allowUnsafe_(other.allowUnsafe_)
+		, currentFilters_(std::move(other.currentFilters_))
+		, params_(std::move(other.params_))
+		, statements_(std::move(other.statements_))
+		, inTransaction_(other.inTransaction_)
+		, deleteCount_(other.deleteCount_)
+		, changesSinceCommit_(other.changesSinceCommit_)
+		, operationCount_(other.operationCount_)
+		, batchSize_(other.batchSize_)
+	{
+		other.inTransaction_ = false;
+	} // end of PreparedDelete move constructor
+
+	PreparedDelete& PreparedDelete::Where(const std::string& column_, const ColumnValue& value_,
+		CompareOp op_)
+	{
+		currentFilters_.emplace_back(column_, value_, op_);
+		return *this;
+	} // end of Where
+
+	sqlite3_stmt* PreparedDelete::statementForCurrentShape()
+	{
+		if (sqlite3_stmt* stmt = statements_.find(currentFilters_))
+		{
+			return stmt;
+		} // end of if
+
+		// First item with this shape: prepare once, owned by statements_
+		std::string sql = "DELETE FROM " + tableName_ + FilterShapeCache::whereClause(currentFilters_);
+		sqlite3_stmt* stmt = analyzer_.prepareStatement(sql);
+		if (!stmt)
+		{
+			throw std::runtime_error("Failed to prepare batch delete: " + analyzer_.getLastError());
+		} // end of if
+
+		statements_.add(currentFilters_, stmt);
+		return stmt;
+	} // end of statementForCurrentShape
+
+	void PreparedDelete::ExecuteBatch()
+	{
+		// Same guard as DeleteBuilder::Execute, per item
+		if (currentFilters_.empty() && !allowUnsafe_)
+		{
+			throw std::runtime_error(
+				"Batch DELETE item without WHERE conditions requires DeleteBuilder::Unsafe() before Prepare()"
+			);
+		} // end of if
+
+		sqlite3_stmt* stmt = statementForCurrentShape();
+
+		params_.clear();
+		for (const auto& filter : currentFilters_)
+		{
+			params_.push_back(filter.value_);
+		} // end of for
+
+		auto result = analyzer_.executePrepared(stmt, params_);
+
+		// Clear current filters for next batch item
+		currentFilters_.clear();
+
+		if (!result)
+		{
+			throw std::runtime_error("Batch delete failed: " + result.error);
+		} // end of if
+
+		deleteCount_ += result.changes;
+		changesSinceCommit_ += result.changes;
+
+		// The update hook misses the truncate optimization and WITHOUT ROWID tables
+		if (result.changes > 0)
+		{
+			analyzer_.invalidateResultCache(tableName_);
+		} // end of if
+
+		// Auto-commit every N operations for better performance
+		if (++operationCount_ % batchSize_ == 0)
+		{
+			if (!analyzer_.commit())
+			{
+				std::string error = analyzer_.getLastError();
+				analyzer_.rollback();
+				inTransaction_ = false;
+				deleteCount_ -= changesSinceCommit_;  // Those changes were rolled back
+				changesSinceCommit_ = 0;
+				throw std::runtime_error("Failed to commit batch delete transaction: " + error);
+			} // end of if
+			changesSinceCommit_ = 0;
+
+			if (!analyzer_.beginTransaction())
+			{
+				inTransaction_ = false;
+				throw std::runtime_error("Failed to begin transaction for batch delete: " + analyzer_.getLastError());
+			} // end of if
+		} // end of if
+	} // end of ExecuteBatch
+
+	int64_t PreparedDelete::Finalize()
+	{
+		if (inTransaction_)
+		{
+			if (!analyzer_.commit())
+			{
+				analyzer_.rollback();
+				throw std::runtime_error("Failed to commit batch delete transaction");
+			} // end of if
+			inTransaction_ = false;
+		} // end of if
+
+		cleanup();
+		return deleteCount_;
+	} // end of Finalize
+
+	void PreparedDelete::cleanup()
+	{
+		if (inTransaction_)
+		{
+			analyzer_.rollback();
+			inTransaction_ = false;
+		} // end of if
+
+		statements_.clear();
+	} // end of cleanup
 
 	// ============================================================================
 	// DeleteBuilder Implementation
@@ -35,10 +164,10 @@ namespace sqlite_flux
 	DeleteBuilder::DeleteBuilder(Analyzer& analyzer, const std::string& tableName)
 		: analyzer_(analyzer), tableName_(tableName)
 	{
-		// Get and cache table schema
-		schema_ = analyzer_.getTableSchema(tableName_);
+		// Shared descriptor from the connection's schema snapshot (no copy)
+		table_ = analyzer_.getTableDescriptor(tableName_);
 
-		if (schema_.empty())
+		if (!table_ || table_->empty())
 		{
 			throw std::runtime_error("Table not found or has no columns: " + tableName_);
 		} // end of if
@@ -91,21 +220,36 @@ namespace sqlite_flux
 
 		std::string sql = buildSql();
 
-		if (!analyzer_.execute(sql))
+		auto result = analyzer_.executeDml(sql, buildParams());
+		if (!result)
 		{
-			throw std::runtime_error("Delete failed: " + analyzer_.getLastError());
+			throw std::runtime_error("Delete failed: " + result.error);
 		} // end of if
 
-		// Get rows affected
-		auto result = analyzer_.query("SELECT changes() as affected");
-		if (!result.empty())
+		analyzer_.invalidateResultCache(tableName_);
+
+		return result.changes;
+	} // end of Execute
+
+	std::future<ExecuteResult> DeleteBuilder::Submit(WriteBatcher& batcher)
+	{
+		validateSafeExecution();
+		return batcher.submit(buildSql(), buildParams());
+	} // end of Submit
+
+	PreparedDelete DeleteBuilder::Prepare()
+	{
+		// Silently dropping conditions here would widen the delete
+		if (!filters_.empty() || !orderByColumn_.empty() || limitValue_ > 0)
 		{
-			auto affected = getValue<int64_t>(result[0], "affected");
-			return affected.value_or(0);
+			throw std::runtime_error(
+				"Prepared delete takes its WHERE conditions per item; "
+				"prepare from a builder without Where(), OrderBy() or Limit()"
+			);
 		} // end of if
 
-		return 0;
-	} // end of Execute
+		return PreparedDelete(analyzer_, tableName_, allowUnsafe_);
+	} // end of Prepare
 
 	std::string DeleteBuilder::buildSql() const
 	{
@@ -140,15 +284,22 @@ namespace sqlite_flux
 		return sql.str();
 	} // end of buildSql
 
-	void DeleteBuilder::validateColumn(const std::string& column_) const
+	std::vector<ColumnValue> DeleteBuilder::buildParams() const
 	{
-		auto it = std::find_if(schema_.begin(), schema_.end(),
-			[&column_](const ColumnInfo& info) { return info.name == column_; });
+		std::vector<ColumnValue> params;
+		params.reserve(filters_.size());
 
-		if (it == schema_.end())
+		for (const auto& filter : filters_)
 		{
-			throw std::runtime_error("Column '" + column_ + "' not found in table '" + tableName_ + "'");
-		} // end of if
+			params.push_back(filter.value_);
+		} // end of for
+
+		return params;
+	} // end of buildParams
+
+	void DeleteBuilder::validateColumn(const std::string& column_) const
+	{
+		table_->require(column_);
 	} // end of validateColumn
 
 	void DeleteBuilder::validateSafeExecution() const
@@ -0,0 +1,81 @@
+// src/FilterShapeCache.cpp
+#include "FilterShapeCache.h"
+#include <sqlite3.h>
+#include <algorithm>
+
+namespace sqlite_flux
+{
+
+	FilterShapeCache::~FilterShapeCache()
+	{
+		clear();
+	} // end of FilterShapeCache destructor
+
+	FilterShapeCache::FilterShapeCache(FilterShapeCache&& other) noexcept
+		: entries_(std::move(other.entries_))
+	{
+		other.entries_.clear();
+	} // end of FilterShapeCache move constructor
+
+	FilterShapeCache& FilterShapeCache::operator=(FilterShapeCache&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			entries_ = std::move(other.entries_);
+			other.entries_.clear();
+		} // end of if
+		return *this;
+	} // end of FilterShapeCache move assignment
+
+	sqlite3_stmt* FilterShapeCache::find(const std::vector<FilterCondition>& filters) const
+	{
+		for (const Entry& entry : entries_)
+		{
+			bool same = std::equal(entry.shape.begin(), entry.shape.end(), filters.begin(), filters.end(),
+				[](const auto& shaped, const FilterCondition& filter) {
+					return shaped.second == filter.op_ && shaped.first == filter.column_;
+				});
+			if (same)
+			{
+				return entry.stmt;
+			} // end of if
+		} // end of for
+
+		return nullptr;
+	} // end of find
+
+	void FilterShapeCache::add(const std::vector<FilterCondition>& filters, sqlite3_stmt* stmt)
+	{
+		Entry entry;
+		entry.shape.reserve(filters.size());
+		for (const auto& filter : filters)
+		{
+			entry.shape.emplace_back(filter.column_, filter.op_);
+		} // end of for
+		entry.stmt = stmt;
+
+		entries_.push_back(std::move(entry));
+	} // end of add
+
+	void FilterShapeCache::clear()
+	{
+		for (Entry& entry : entries_)
+		{
+			sqlite3_finalize(entry.stmt);
+		} // end of for
+		entries_.clear();
+	} // end of clear
+
+	std::string FilterShapeCache::whereClause(const std::vector<FilterCondition>& filters)
+	{
+		std::string sql;
+		for (size_t i = 0; i < filters.size(); ++i)
+		{
+			sql += (i == 0) ? " WHERE " : " AND ";
+			sql += filters[i].toSql();
+		} // end of for
+		return sql;
+	} // end of whereClause
+
+} // namespace sqlite_flux
@@ -1,5 +1,6 @@
 // src/InsertBuilder.cpp
 #include "InsertBuilder.h"
+#include "WriteBatcher.h"
 #include "ValueVisitor.h"
 #include <sqlite3.h>
 #include <sstream>
@@ -9,38 +10,6 @@
 namespace sqlite_flux
 {
 
-	// ============================================================================
-	// Helper function to convert ColumnValue to SQL string
-	// ============================================================================
-
-	static std::string valueToSql(const ColumnValue& value_)
-	{
-		std::ostringstream oss;
-
-		std::visit(overloaded{
-			[&oss](std::monostate) { oss << "NULL"; },
-			[&oss](int64_t v) { oss << v; },
-			[&oss](double v) { oss << v; },
-			[&oss](const std::string& v) {
-				oss << "'";
-				// SQL escape - replace ' with ''
-				for (char c : v)
-				{
-					if (c == '\'')
-						oss << "''";
-					else
-						oss << c;
-				} // end of for
-				oss << "'";
-			},
-			[&oss](const std::vector<uint8_t>&) {
-				oss << "?";  // BLOB needs parameter binding
-			}
-			}, value_);
-
-		return oss.str();
-	} // end of valueToSql
-
 	// ============================================================================
 	// PreparedInsert Implementation
 	// ============================================================================
@@ -69,6 +38,8 @@ namespace sqlite_flux
 		: analyzer_(other.analyzer_)
 		, tableName_(std::move(other.tableName_))
 		, columns_(std::move(other.columns_))
+		, currentValues_(std::move(other.currentValues_))
+		, hasValues_(other.hasValues_)
 		, stmt_(other.stmt_)
 		, inTransaction_(other.inTransaction_)
 		, insertCount_(other.insertCount_)
@@ -117,74 +88,80 @@ namespace sqlite_flux
 
 		sql << ")";
 
-		// Prepare statement (note: we need direct access to sqlite3* db)
-		// This requires adding a helper method to Analyzer
-		// For now, we'll use the execute() approach and optimize later
-		// TODO: Add Analyzer::prepareStatement() method for better performance
+		// Prepare once; the statement is owned by this object and finalized in cleanup()
+		stmt_ = analyzer_.prepareStatement(sql.str());
+		if (!stmt_)
+		{
+			throw std::runtime_error("Failed to prepare batch insert: " + analyzer_.getLastError());
+		} // end of if
 	} // end of prepareStatement
 
 	PreparedInsert& PreparedInsert::Values(const std::unordered_map<std::string, ColumnValue>& values)
 	{
-		// Build INSERT statement for this batch item
-		std::ostringstream sql;
-		sql << "INSERT ";
-
-		// Add conflict resolution clause (we need to store this)
-		sql << "INTO " << tableName_ << " (";
-
-		std::vector<ColumnValue> orderedValues;
+		// Reuse the value buffer across rows
+		currentValues_.clear();
 
-		// Column names and values in order
-		for (size_t i = 0; i < columns_.size(); ++i)
+		for (const auto& column_ : columns_)
 		{
-			if (i > 0) sql << ", ";
-			sql << columns_[i];
-
-			auto it = values.find(columns_[i]);
+			auto it = values.find(column_);
 			if (it == values.end())
 			{
-				throw std::runtime_error("Missing value_ for column_: " + columns_[i]);
+				throw std::runtime_error("Missing value_ for column_: " + column_);
 			} // end of if
-			orderedValues.push_back(it->second);
+			currentValues_.push_back(it->second);
 		} // end of for
 
-		sql << ") VALUES (";
+		hasValues_ = true;
+		return *this;
+	} // end of Values
 
-		for (size_t i = 0; i < orderedValues.size(); ++i)
+	PreparedInsert& PreparedInsert::Values(std::span<const ColumnValue> values)
+	{
+		if (values.size() != columns_.size())
 		{
-			if (i > 0) sql << ", ";
-			sql << valueToSql(orderedValues[i]);
-		} // end of for
-
-		sql << ")";
-
-		// Store for execution
-		currentSql_ = sql.str();
+			throw std::runtime_error("Expected " + std::to_string(columns_.size()) +
+				" values for batch insert, got " + std::to_string(values.size()));
+		} // end of if
 
+		currentValues_.assign(values.begin(), values.end());
+		hasValues_ = true;
 		return *this;
 	} // end of Values
 
 	void PreparedInsert::ExecuteBatch()
 	{
-		if (currentSql_.empty())
+		if (!hasValues_)
 		{
 			throw std::runtime_error("No values set for batch insert");
 		} // end of if
 
-		// Execute the insert
-		if (!analyzer_.execute(currentSql_))
+		// Bind, step and reset the statement prepared in the constructor
+		auto result = analyzer_.executePrepared(stmt_, currentValues_);
+		if (!result)
 		{
-			throw std::runtime_error("Batch insert failed: " + analyzer_.getLastError());
+			throw std::runtime_error("Batch insert failed: " + result.error);
 		} // end of if
 
 		++insertCount_;
-		currentSql_.clear();
+		hasValues_ = false;
 
 		// Auto-commit every N operations for better performance
 		if (insertCount_ % batchSize_ == 0)
 		{
-			analyzer_.commit();
-			analyzer_.beginTransaction();
+			if (!analyzer_.commit())
+			{
+				std::string error = analyzer_.getLastError();
+				analyzer_.rollback();
+				inTransaction_ = false;
+				insertCount_ -= batchSize_;  // Those rows were rolled back
+				throw std::runtime_error("Failed to commit batch insert transaction: " + error);
+			} // end of if
+
+			if (!analyzer_.beginTransaction())
+			{
+				inTransaction_ = false;
+				throw std::runtime_error("Failed to begin transaction for batch insert: " + analyzer_.getLastError());
+			} // end of if
 		} // end of if
 	} // end of ExecuteBatch
 
@@ -219,6 +196,340 @@ namespace sqlite_flux
 		} // end of if
 	} // end of cleanup
 
+	// ============================================================================
+	// BulkInsert Implementation
+	// ============================================================================
+
+	BulkInsert::BulkInsert(Analyzer& analyzer, const std::string& tableName,
+		const std::vector<std::string>& columns,
+		ConflictResolution conflict,
+		const BulkInsertOptions& options)
+		: analyzer_(analyzer), tableName_(tableName), columns_(columns)
+		, conflict_(conflict), options_(options)
+	{
+		if (columns_.empty())
+		{
+			throw std::runtime_error("No columns set for bulk insert");
+		} // end of if
+
+		// Size each statement to stay under the bound-parameter limit
+		size_t maxRows = static_cast<size_t>(analyzer_.getVariableLimit()) / columns_.size();
+		if (maxRows == 0)
+		{
+			throw std::runtime_error("Too many columns for bulk insert into " + tableName_);
+		} // end of if
+
+		rowsPerStatement_ = options_.rowsPerStatement > 0
+			? std::min(options_.rowsPerStatement, maxRows)
+			: std::min(BulkInsertOptions::MaxAutoRowsPerStatement, maxRows);
+
+		fullStmt_ = analyzer_.prepareStatement(buildSql(rowsPerStatement_));
+		if (!fullStmt_)
+		{
+			throw std::runtime_error("Failed to prepare bulk insert: " + analyzer_.getLastError());
+		} // end of if
+
+		pending_.reserve(rowsPerStatement_ * columns_.size());
+
+		try
+		{
+			beginLoad();
+		} // end of try
+		catch (...)
+		{
+			// Destructor will not run: restore indexes/pragmas and free the statement here
+			cleanup();
+			throw;
+		} // end of catch
+	} // end of BulkInsert constructor
+
+	BulkInsert::~BulkInsert()
+	{
+		cleanup();
+	} // end of BulkInsert destructor
+
+	BulkInsert::BulkInsert(BulkInsert&& other) noexcept
+		: analyzer_(other.analyzer_)
+		, tableName_(std::move(other.tableName_))
+		, columns_(std::move(other.columns_))
+		, conflict_(other.conflict_)
+		, options_(other.options_)
+		, rowsPerStatement_(other.rowsPerStatement_)
+		, fullStmt_(other.fullStmt_)
+		, pending_(std::move(other.pending_))
+		, pendingRows_(other.pendingRows_)
+		, inTransaction_(other.inTransaction_)
+		, insertCount_(other.insertCount_)
+		, rowsSinceCommit_(other.rowsSinceCommit_)
+		, pragmasChanged_(other.pragmasChanged_)
+		, previousSynchronous_(other.previousSynchronous_)
+		, previousCacheSize_(other.previousCacheSize_)
+		, deferredIndexSql_(std::move(other.deferredIndexSql_))
+	{
+		other.fullStmt_ = nullptr;
+		other.pendingRows_ = 0;
+		other.inTransaction_ = false;
+		other.pragmasChanged_ = false;
+		other.deferredIndexSql_.clear();
+	} // end of BulkInsert move constructor
+
+	std::string BulkInsert::buildSql(size_t rowCount) const
+	{
+		std::string rowPlaceholders = "(";
+		for (size_t i = 0; i < columns_.size(); ++i)
+		{
+			rowPlaceholders += (i > 0) ? ", ?" : "?";
+		} // end of for
+		rowPlaceholders += ")";
+
+		std::ostringstream sql;
+		sql << "INSERT ";
+
+		switch (conflict_)
+		{
+		case ConflictResolution::Ignore:
+			sql << "OR IGNORE ";
+			break;
+		case ConflictResolution::Replace:
+			sql << "OR REPLACE ";
+			break;
+		default:
+			break;
+		} // end of switch
+
+		sql << "INTO " << tableName_ << " (";
+		for (size_t i = 0; i < columns_.size(); ++i)
+		{
+			if (i > 0) sql << ", ";
+			sql << columns_[i];
+		} // end of for
+		sql << ") VALUES ";
+
+		for (size_t i = 0; i < rowCount; ++i)
+		{
+			if (i > 0) sql << ", ";
+			sql << rowPlaceholders;
+		} // end of for
+
+		return sql.str();
+	} // end of buildSql
+
+	void BulkInsert::beginLoad()
+	{
+		if (options_.fastPragmas)
+		{
+			// Pragmas are applied outside the transaction and restored in endLoad()
+			auto sync = analyzer_.query("PRAGMA synchronous");
+			auto cache = analyzer_.query("PRAGMA cache_size");
+			if (!sync.empty()) previousSynchronous_ = getValue<int64_t>(sync[0], "synchronous").value_or(2);
+			if (!cache.empty()) previousCacheSize_ = getValue<int64_t>(cache[0], "cache_size").value_or(-2000);
+
+			analyzer_.execute("PRAGMA synchronous=OFF");
+			analyzer_.execute("PRAGMA cache_size=-" + std::to_string(options_.cacheSizeKiB));
+			pragmasChanged_ = true;
+		} // end of if
+
+		if (options_.deferIndexes)
+		{
+			// Only non-unique indexes from CREATE INDEX (origin 'c'): unique ones
+			// enforce constraints the load (and OR IGNORE/REPLACE) depends on
+			auto indexes = analyzer_.query("PRAGMA index_list(\"" + tableName_ + "\")");
+
+			for (const auto& row : indexes)
+			{
+				auto name = getValue<std::string>(row, "name");
+				auto origin = getValue<std::string>(row, "origin");
+				if (!name || origin != "c" || getValue<int64_t>(row, "unique").value_or(1) != 0) continue;
+
+				auto sql = analyzer_.queryScalar("SELECT sql FROM sqlite_master WHERE type='index' AND name = ?", { *name });
+				const std::string* createSql = sql ? std::get_if<std::string>(&*sql) : nullptr;
+				if (!createSql) continue;
+
+				if (!analyzer_.execute("DROP INDEX \"" + *name + "\""))
+				{
+					throw std::runtime_error("Failed to defer index " + *name + ": " + analyzer_.getLastError());
+				} // end of if
+				deferredIndexSql_.push_back(*createSql);
+			} // end of for
+		} // end of if
+
+		if (!analyzer_.beginTransaction())
+		{
+			throw std::runtime_error("Failed to begin transaction for bulk insert");
+		} // end of if
+		inTransaction_ = true;
+	} // end of beginLoad
+
+	void BulkInsert::endLoad()
+	{
+		// Settings first, so a failed rebuild cannot leave synchronous=OFF behind
+		if (pragmasChanged_)
+		{
+			analyzer_.execute("PRAGMA synchronous=" + std::to_string(previousSynchronous_));
+			analyzer_.execute("PRAGMA cache_size=" + std::to_string(previousCacheSize_));
+			pragmasChanged_ = false;
+		} // end of if
+
+		// Each index on its own, so one failure does not take the others with it;
+		// the ones that fail stay in deferredIndexSql_ and are reported
+		std::vector<std::string> failed;
+		std::string errors;
+		for (auto& sql : deferredIndexSql_)
+		{
+			if (!analyzer_.execute(sql))
+			{
+				errors += "\n  " + sql + ": " + analyzer_.getLastError();
+				failed.push_back(std::move(sql));
+			} // end of if
+		} // end of for
+		deferredIndexSql_ = std::move(failed);
+
+		if (!deferredIndexSql_.empty())
+		{
+			throw std::runtime_error("Failed to rebuild indexes after bulk insert (recreate them by hand):" + errors);
+		} // end of if
+	} // end of endLoad
+
+	BulkInsert& BulkInsert::Add(std::span<const ColumnValue> row)
+	{
+		if (row.size() != columns_.size())
+		{
+			throw std::runtime_error("Expected " + std::to_string(columns_.size()) +
+				" values for bulk insert, got " + std::to_string(row.size()));
+		} // end of if
+
+		pending_.insert(pending_.end(), row.begin(), row.end());
+		++pendingRows_;
+
+		if (pendingRows_ == rowsPerStatement_)
+		{
+			writePending();
+		} // end of if
+
+		return *this;
+	} // end of Add
+
+	BulkInsert& BulkInsert::Add(const std::unordered_map<std::string, ColumnValue>& row)
+	{
+		for (const auto& column_ : columns_)
+		{
+			auto it = row.find(column_);
+			if (it == row.end())
+			{
+				// Drop the partially appended row before reporting
+				pending_.resize(pendingRows_ * columns_.size());
+				throw std::runtime_error("Missing value_ for column_: " + column_);
+			} // end of if
+			pending_.push_back(it->second);
+		} // end of for
+		++pendingRows_;
+
+		if (pendingRows_ == rowsPerStatement_)
+		{
+			writePending();
+		} // end of if
+
+		return *this;
+	} // end of Add
+
+	void BulkInsert::Flush()
+	{
+		writePending();
+	} // end of Flush
+
+	void BulkInsert::writePending()
+	{
+		if (pendingRows_ == 0) return;
+
+		bool ok;
+		if (pendingRows_ == rowsPerStatement_)
+		{
+			ok = analyzer_.executePrepared(fullStmt_, pending_).success;
+		} // end of if
+		else
+		{
+			// Partial tail: goes through the connection's statement cache
+			ok = analyzer_.execute(buildSql(pendingRows_), pending_);
+		} // end of else
+
+		if (!ok)
+		{
+			pending_.clear();
+			pendingRows_ = 0;
+			throw std::runtime_error("Bulk insert failed: " + analyzer_.getLastError());
+		} // end of if
+
+		insertCount_ += static_cast<int64_t>(pendingRows_);
+		rowsSinceCommit_ += static_cast<int64_t>(pendingRows_);
+		pending_.clear();
+		pendingRows_ = 0;
+
+		if (options_.rowsPerTransaction > 0 && rowsSinceCommit_ >= options_.rowsPerTransaction)
+		{
+			if (!analyzer_.commit())
+			{
+				std::string error = analyzer_.getLastError();
+				analyzer_.rollback();
+				inTransaction_ = false;
+				insertCount_ -= rowsSinceCommit_;  // Those rows were rolled back
+				rowsSinceCommit_ = 0;
+				throw std::runtime_error("Failed to commit bulk insert transaction: " + error);
+			} // end of if
+			rowsSinceCommit_ = 0;
+
+			if (!analyzer_.beginTransaction())
+			{
+				inTransaction_ = false;
+				throw std::runtime_error("Failed to begin transaction for bulk insert: " + analyzer_.getLastError());
+			} // end of if
+		} // end of if
+	} // end of writePending
+
+	int64_t BulkInsert::Finalize()
+	{
+		writePending();
+
+		if (inTransaction_)
+		{
+			if (!analyzer_.commit())
+			{
+				analyzer_.rollback();
+				inTransaction_ = false;
+				throw std::runtime_error("Failed to commit bulk insert transaction");
+			} // end of if
+			inTransaction_ = false;
+		} // end of if
+
+		endLoad();
+		cleanup();
+		return insertCount_;
+	} // end of Finalize
+
+	void BulkInsert::cleanup()
+	{
+		if (inTransaction_)
+		{
+			analyzer_.rollback();
+			inTransaction_ = false;
+		} // end of if
+
+		// Never leave the table without its indexes or the connection with unsafe pragmas
+		try
+		{
+			endLoad();
+		} // end of try
+		catch (const std::exception&)
+		{
+			// Destructor path: nothing more we can do
+		} // end of catch
+
+		if (fullStmt_)
+		{
+			sqlite3_finalize(fullStmt_);
+			fullStmt_ = nullptr;
+		} // end of if
+	} // end of cleanup
+
 	// ============================================================================
 	// InsertBuilder Implementation
 	// ============================================================================
@@ -226,10 +537,10 @@ namespace sqlite_flux
 	InsertBuilder::InsertBuilder(Analyzer& analyzer, const std::string& tableName)
 		: analyzer_(analyzer), tableName_(tableName)
 	{
-		// Get and cache table schema
-		schema_ = analyzer_.getTableSchema(tableName_);
+		// Shared descriptor from the connection's schema snapshot (no copy)
+		table_ = analyzer_.getTableDescriptor(tableName_);
 
-		if (schema_.empty())
+		if (!table_ || table_->empty())
 		{
 			throw std::runtime_error("Table not found or has no columns: " + tableName_);
 		} // end of if
@@ -242,9 +553,37 @@ namespace sqlite_flux
 		// Validate all columns
 		validateAllColumns();
 
+		// A value given here replaces an earlier ZeroBlob() for the column
+		std::erase_if(zeroBlobs_, [this](const auto& zero) { return values_.contains(zero.first); });
+
 		return *this;
 	} // end of Values
 
+	InsertBuilder& InsertBuilder::ZeroBlob(const std::string& column_, int64_t size)
+	{
+		if (size < 0)
+		{
+			throw std::invalid_argument("ZeroBlob size must be non-negative");
+		} // end of if
+
+		validateColumn(column_);
+		validateColumnType(column_, std::vector<uint8_t>{});
+
+		values_.erase(column_);
+		auto it = std::find_if(zeroBlobs_.begin(), zeroBlobs_.end(),
+			[&column_](const auto& zero) { return zero.first == column_; });
+		if (it != zeroBlobs_.end())
+		{
+			it->second = size;
+		} // end of if
+		else
+		{
+			zeroBlobs_.emplace_back(column_, size);
+		} // end of else
+
+		return *this;
+	} // end of ZeroBlob
+
 	InsertBuilder& InsertBuilder::OrIgnore()
 	{
 		conflictResolution_ = ConflictResolution::Ignore;
@@ -259,30 +598,34 @@ namespace sqlite_flux
 
 	int64_t InsertBuilder::Execute()
 	{
-		if (values_.empty())
+		if (values_.empty() && zeroBlobs_.empty())
 		{
 			throw std::runtime_error("No values set for insert");
 		} // end of if
 
 		std::string sql = buildSql();
 
-		if (!analyzer_.execute(sql))
+		auto result = analyzer_.executeDml(sql, buildParams());
+		if (!result)
 		{
-			throw std::runtime_error("Insert failed: " + analyzer_.getLastError());
+			throw std::runtime_error("Insert failed: " + result.error);
 		} // end of if
 
-		// Get last insert rowid
-		// Note: This requires adding a helper method to Analyzer
-		// For now, we'll query it
-		auto result = analyzer_.query("SELECT last_insert_rowid() as rowid");
-		if (!result.empty())
+		analyzer_.invalidateResultCache(tableName_);
+
+		// OR IGNORE may skip the row; the connection's rowid would then be stale
+		return result.changes > 0 ? result.lastInsertRowid : 0;
+	} // end of Execute
+
+	std::future<ExecuteResult> InsertBuilder::Submit(WriteBatcher& batcher)
+	{
+		if (values_.empty() && zeroBlobs_.empty())
 		{
-			auto rowid = getValue<int64_t>(result[0], "rowid");
-			return rowid.value_or(0);
+			throw std::runtime_error("No values set for insert");
 		} // end of if
 
-		return 0;
-	} // end of Execute
+		return batcher.submit(buildSql(), buildParams());
+	} // end of Submit
 
 	PreparedInsert InsertBuilder::Prepare()
 	{
@@ -291,6 +634,11 @@ namespace sqlite_flux
 			throw std::runtime_error("No values set for prepared insert");
 		} // end of if
 
+		if (!zeroBlobs_.empty())
+		{
+			throw std::runtime_error("ZeroBlob() columns are not supported by prepared inserts");
+		} // end of if
+
 		// Extract column names from values
 		std::vector<std::string> columns;
 		for (const auto& [col, val] : values_)
@@ -301,6 +649,32 @@ namespace sqlite_flux
 		return PreparedInsert(analyzer_, tableName_, columns, conflictResolution_);
 	} // end of Prepare
 
+	PreparedInsert InsertBuilder::Prepare(const std::vector<std::string>& columns)
+	{
+		if (columns.empty())
+		{
+			throw std::runtime_error("No columns set for prepared insert");
+		} // end of if
+
+		for (const auto& column_ : columns)
+		{
+			validateColumn(column_);
+		} // end of for
+
+		return PreparedInsert(analyzer_, tableName_, columns, conflictResolution_);
+	} // end of Prepare
+
+	BulkInsert InsertBuilder::PrepareBulk(const std::vector<std::string>& columns,
+		const BulkInsertOptions& options)
+	{
+		for (const auto& column_ : columns)
+		{
+			validateColumn(column_);
+		} // end of for
+
+		return BulkInsert(analyzer_, tableName_, columns, conflictResolution_, options);
+	} // end of PrepareBulk
+
 	std::string InsertBuilder::buildSql() const
 	{
 		std::ostringstream sql;
@@ -315,15 +689,24 @@ namespace sqlite_flux
 			if (index++ > 0) sql << ", ";
 			sql << col;
 		} // end of for
+		for (const auto& [col, size] : zeroBlobs_)
+		{
+			if (index++ > 0) sql << ", ";
+			sql << col;
+		} // end of for
 
 		sql << ") VALUES (";
 
-		// Values
-		index = 0;
-		for (const auto& [col, val] : values_)
+		// Placeholders (values are bound, see buildParams)
+		for (size_t i = 0; i < values_.size(); ++i)
 		{
-			if (index++ > 0) sql << ", ";
-			sql << valueToSql(val);
+			if (i > 0) sql << ", ";
+			sql << "?";
+		} // end of for
+		for (size_t i = 0; i < zeroBlobs_.size(); ++i)
+		{
+			if (i > 0 || !values_.empty()) sql << ", ";
+			sql << "zeroblob(?)";
 		} // end of for
 
 		sql << ")";
@@ -331,39 +714,32 @@ namespace sqlite_flux
 		return sql.str();
 	} // end of buildSql
 
-	void InsertBuilder::validateColumn(const std::string& column_) const
+	std::vector<ColumnValue> InsertBuilder::buildParams() const
 	{
-		auto it = std::find_if(schema_.begin(), schema_.end(), [&column_](const ColumnInfo& info) { return info.name == column_; });
+		// Same iteration order as the column list in buildSql
+		std::vector<ColumnValue> params;
+		params.reserve(values_.size() + zeroBlobs_.size());
 
-		if (it == schema_.end())
+		for (const auto& [col, val] : values_)
 		{
-			throw std::runtime_error("Column '" + column_ + "' not found in table '" + tableName_ + "'");
-		} // end of if
-	} // end of validateColumn
-
-	void InsertBuilder::validateColumnType(const std::string& column_, const ColumnValue& value_) const
-	{
-		// Allow NULL for any column type
-		if (std::holds_alternative<std::monostate>(value_))
+			params.push_back(val);
+		} // end of for
+		for (const auto& [col, size] : zeroBlobs_)
 		{
-			return;
-		} // end of if
+			params.push_back(size);
+		} // end of for
 
-		std::string sqliteType = getSqliteType(column_);
+		return params;
+	} // end of buildParams
 
-		if (!isTypeCompatible(sqliteType, value_))
-		{
-			std::string valueType;
-			std::visit(overloaded{
-				[&valueType](std::monostate) { valueType = "NULL"; },
-				[&valueType](int64_t) { valueType = "int64_t"; },
-				[&valueType](double) { valueType = "double"; },
-				[&valueType](const std::string&) { valueType = "string"; },
-				[&valueType](const std::vector<uint8_t>&) { valueType = "blob"; }
-				}, value_);
+	void InsertBuilder::validateColumn(const std::string& column_) const
+	{
+		table_->require(column_);
+	} // end of validateColumn
 
-			throw std::runtime_error(	"Type mismatch for column_ '" + column_ + "': " +"expected " + sqliteType + ", got " + valueType);
-		} // end of if
+	void InsertBuilder::validateColumnType(const std::string& column_, const ColumnValue& value_) const
+	{
+		table_->validateValue(column_, value_);
 	} // end of validateColumnType
 
 	void InsertBuilder::validateAllColumns() const
@@ -375,55 +751,6 @@ namespace sqlite_flux
 		} // end of for
 	} // end of validateAllColumns
 
-	std::string InsertBuilder::getSqliteType(const std::string& column_) const
-	{
-		auto it = std::find_if(schema_.begin(), schema_.end(),
-			[&column_](const ColumnInfo& info) { return info.name == column_; });
-
-		if (it != schema_.end())
-		{
-			return it->type;
-		} // end of if
-
-		return "";
-	} // end of getSqliteType
-
-	bool InsertBuilder::isTypeCompatible(const std::string& sqliteType, const ColumnValue& value_) const
-	{
-		// SQLite type affinity rules
-		// INTEGER affinity
-		if (sqliteType.find("INT") != std::string::npos)
-		{
-			return std::holds_alternative<int64_t>(value_);
-		} // end of if
-
-		// TEXT affinity
-		if (sqliteType.find("CHAR") != std::string::npos ||
-			sqliteType.find("CLOB") != std::string::npos ||
-			sqliteType.find("TEXT") != std::string::npos)
-		{
-			return std::holds_alternative<std::string>(value_);
-		} // end of if
-
-		// BLOB affinity
-		if (sqliteType.find("BLOB") != std::string::npos)
-		{
-			return std::holds_alternative<std::vector<uint8_t>>(value_);
-		} // end of if
-
-		// REAL affinity
-		if (sqliteType.find("REAL") != std::string::npos ||
-			sqliteType.find("FLOA") != std::string::npos ||
-			sqliteType.find("DOUB") != std::string::npos)
-		{
-			return std::holds_alternative<double>(value_);
-		} // end of if
-
-		// NUMERIC affinity - accepts both int and real
-		return std::holds_alternative<int64_t>(value_) ||
-			std::holds_alternative<double>(value_);
-	} // end of isTypeCompatible
-
 	std::string InsertBuilder::getConflictClause() const
 	{
 		switch (conflictResolution_)
@@ -0,0 +1,265 @@
+// src/Metrics.cpp
+#include "Metrics.h"
+#include <bit>
+#include <cmath>
+
+namespace sqlite_flux
+{
+
+	namespace
+	{
+		constexpr size_t LinearBuckets = 16;  // Values below this get a bucket each
+		constexpr size_t SubBuckets = 4;      // Buckets per power of two above it
+
+		void raiseTo(std::atomic<uint64_t>& target, uint64_t value)
+		{
+			uint64_t current = target.load(std::memory_order_relaxed);
+			while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+			{
+			} // end of while
+		} // end of raiseTo
+	} // namespace
+
+	// ============================================================================
+	// Histogram
+	// ============================================================================
+
+	size_t Histogram::bucketOf(uint64_t value)
+	{
+		if (value < LinearBuckets) return static_cast<size_t>(value);
+
+		// Exponent e >= 4; the two bits below the leading one pick the sub-bucket
+		const unsigned exponent = static_cast<unsigned>(std::bit_width(value)) - 1;
+		const size_t sub = static_cast<size_t>(value >> (exponent - 2)) & (SubBuckets - 1);
+		return LinearBuckets + (exponent - 4) * SubBuckets + sub;
+	} // end of bucketOf
+
+	uint64_t Histogram::bucketUpperBound(size_t bucket)
+	{
+		if (bucket < LinearBuckets) return bucket;
+
+		const unsigned exponent = static_cast<unsigned>((bucket - LinearBuckets) / SubBuckets) + 4;
+		const uint64_t sub = (bucket - LinearBuckets) % SubBuckets;
+		const uint64_t step = uint64_t{ 1 } << (exponent - 2);
+		return ((SubBuckets + sub) << (exponent - 2)) + (step - 1);
+	} // end of bucketUpperBound
+
+	void Histogram::record(uint64_t value)
+	{
+		buckets_[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+		count_.fetch_add(1, std::memory_order_relaxed);
+		sum_.fetch_add(value, std::memory_order_relaxed);
+		raiseTo(max_, value);
+	} // end of record
+
+	uint64_t Histogram::percentile(double p) const
+	{
+		// Read the buckets once; concurrent records may make this a little stale
+		std::array<uint64_t, BucketCount> counts;
+		uint64_t total = 0;
+		for (size_t i = 0; i < BucketCount; ++i)
+		{
+			counts[i] = buckets_[i].load(std::memory_order_relaxed);
+			total += counts[i];
+		} // end of for
+
+		if (total == 0) return 0;
+
+		p = std::clamp(p, 0.0, 1.0);
+		const uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(p * static_cast<double>(total))), 1);
+
+		uint64_t seen = 0;
+		for (size_t i = 0; i < BucketCount; ++i)
+		{
+			seen += counts[i];
+			if (seen >= rank)
+			{
+				return std::min(bucketUpperBound(i), max());
+			} // end of if
+		} // end of for
+		return max();
+	} // end of percentile
+
+	void Histogram::reset()
+	{
+		for (auto& bucket : buckets_)
+		{
+			bucket.store(0, std::memory_order_relaxed);
+		} // end of for
+		count_.store(0, std::memory_order_relaxed);
+		sum_.store(0, std::memory_order_relaxed);
+		max_.store(0, std::memory_order_relaxed);
+	} // end of reset
+
+	HistogramSummary summarize(const Histogram& histogram)
+	{
+		HistogramSummary summary;
+		summary.count = histogram.count();
+		if (summary.count == 0) return summary;
+
+		summary.mean = static_cast<double>(histogram.sum()) / static_cast<double>(summary.count);
+		summary.p50 = histogram.percentile(0.50);
+		summary.p90 = histogram.percentile(0.90);
+		summary.p99 = histogram.percentile(0.99);
+		summary.max = histogram.max();
+		return summary;
+	} // end of summarize
+
+	// ============================================================================
+	// MetricsRegistry
+	// ============================================================================
+
+	void MetricsRegistry::setSlowQueryHook(std::chrono::nanoseconds threshold, SlowQueryHook hook)
+	{
+		slowThreshold_ = threshold;
+		slowQueryHook_ = std::move(hook);
+	} // end of setSlowQueryHook
+
+	void MetricsRegistry::onStatement(const StatementMetrics& statement)
+	{
+		const auto total = statement.total();
+
+		statements_.fetch_add(1, std::memory_order_relaxed);
+		if (!statement.success) failedStatements_.fetch_add(1, std::memory_order_relaxed);
+		rows_.fetch_add(static_cast<uint64_t>(statement.rows), std::memory_order_relaxed);
+		if (statement.busyRetries > 0)
+		{
+			busyRetries_.fetch_add(static_cast<uint64_t>(statement.busyRetries), std::memory_order_relaxed);
+		} // end of if
+
+		// Statements that bypass the cache count as neither hits nor misses
+		if (!statement.usedStatementCache)
+		{
+			if (statement.prepare.count() > 0) prepareTime_.record(statement.prepare);
+		} // end of if
+		else if (statement.statementCacheHit)
+		{
+			statementCacheHits_.fetch_add(1, std::memory_order_relaxed);
+		} // end of else if
+		else
+		{
+			statementCacheMisses_.fetch_add(1, std::memory_order_relaxed);
+			prepareTime_.record(statement.prepare);
+		} // end of else
+
+		statementTime_.record(total);
+		stepTime_.record(statement.step);
+		decodeTime_.record(statement.decode);
+		rowsPerStatement_.record(static_cast<uint64_t>(statement.rows));
+
+		if (slowQueryHook_ && total >= slowThreshold_)
+		{
+			slowQueries_.fetch_add(1, std::memory_order_relaxed);
+
+			SlowQuery slow;
+			slow.sql.assign(statement.sql);
+			slow.params.assign(statement.params.begin(), statement.params.end());
+			slow.duration = total;
+			slow.rows = statement.rows;
+			slowQueryHook_(slow);
+		} // end of if
+	} // end of onStatement
+
+	void MetricsRegistry::onSchemaLookup(bool refreshed)
+	{
+		schemaLookups_.fetch_add(1, std::memory_order_relaxed);
+		if (refreshed) schemaRefreshes_.fetch_add(1, std::memory_order_relaxed);
+	} // end of onSchemaLookup
+
+	void MetricsRegistry::onPoolAcquire(const PoolAcquireMetrics& acquire)
+	{
+		poolAcquisitions_.fetch_add(1, std::memory_order_relaxed);
+		if (acquire.wait.count() > 0) poolWaits_.fetch_add(1, std::memory_order_relaxed);
+		poolInUse_.store(acquire.inUse, std::memory_order_relaxed);
+		poolOpen_.store(acquire.open, std::memory_order_relaxed);
+		poolWaitTime_.record(acquire.wait);
+	} // end of onPoolAcquire
+
+	void MetricsRegistry::onTask(const TaskMetrics& task)
+	{
+		tasks_.fetch_add(1, std::memory_order_relaxed);
+		queueDepth_.store(task.queueDepth, std::memory_order_relaxed);
+
+		size_t deepest = maxQueueDepth_.load(std::memory_order_relaxed);
+		while (deepest < task.queueDepth
+			&& !maxQueueDepth_.compare_exchange_weak(deepest, task.queueDepth, std::memory_order_relaxed))
+		{
+		} // end of while
+
+		taskQueueTime_.record(task.queued);
+		taskRunTime_.record(task.run);
+	} // end of onTask
+
+	void MetricsRegistry::onCheckpoint(const CheckpointMetrics& checkpoint)
+	{
+		checkpoints_.fetch_add(1, std::memory_order_relaxed);
+		if (!checkpoint.success) failedCheckpoints_.fetch_add(1, std::memory_order_relaxed);
+		if (checkpoint.checkpointedFrames > 0)
+		{
+			checkpointedFrames_.fetch_add(static_cast<uint64_t>(checkpoint.checkpointedFrames), std::memory_order_relaxed);
+		} // end of if
+		walFrames_.store(std::max(checkpoint.logFrames, 0), std::memory_order_relaxed);
+		checkpointTime_.record(checkpoint.duration);
+	} // end of onCheckpoint
+
+	MetricsSnapshot MetricsRegistry::snapshot() const
+	{
+		MetricsSnapshot snap;
+		snap.statements = statements_.load(std::memory_order_relaxed);
+		snap.failedStatements = failedStatements_.load(std::memory_order_relaxed);
+		snap.rows = rows_.load(std::memory_order_relaxed);
+		snap.busyRetries = busyRetries_.load(std::memory_order_relaxed);
+		snap.statementCacheHits = statementCacheHits_.load(std::memory_order_relaxed);
+		snap.statementCacheMisses = statementCacheMisses_.load(std::memory_order_relaxed);
+		snap.schemaLookups = schemaLookups_.load(std::memory_order_relaxed);
+		snap.schemaRefreshes = schemaRefreshes_.load(std::memory_order_relaxed);
+		snap.slowQueries = slowQueries_.load(std::memory_order_relaxed);
+		snap.statementTime = summarize(statementTime_);
+		snap.prepareTime = summarize(prepareTime_);
+		snap.stepTime = summarize(stepTime_);
+		snap.decodeTime = summarize(decodeTime_);
+		snap.rowsPerStatement = summarize(rowsPerStatement_);
+
+		snap.poolAcquisitions = poolAcquisitions_.load(std::memory_order_relaxed);
+		snap.poolWaits = poolWaits_.load(std::memory_order_relaxed);
+		snap.poolInUse = poolInUse_.load(std::memory_order_relaxed);
+		snap.poolOpen = poolOpen_.load(std::memory_order_relaxed);
+		snap.poolWaitTime = summarize(poolWaitTime_);
+
+		snap.tasks = tasks_.load(std::memory_order_relaxed);
+		snap.queueDepth = queueDepth_.load(std::memory_order_relaxed);
+		snap.maxQueueDepth = maxQueueDepth_.load(std::memory_order_relaxed);
+		snap.taskQueueTime = summarize(taskQueueTime_);
+		snap.taskRunTime = summarize(taskRunTime_);
+
+		snap.checkpoints = checkpoints_.load(std::memory_order_relaxed);
+		snap.failedCheckpoints = failedCheckpoints_.load(std::memory_order_relaxed);
+		snap.checkpointedFrames = checkpointedFrames_.load(std::memory_order_relaxed);
+		snap.walFrames = walFrames_.load(std::memory_order_relaxed);
+		snap.checkpointTime = summarize(checkpointTime_);
+		return snap;
+	} // end of snapshot
+
+	void MetricsRegistry::reset()
+	{
+		for (auto* counter : { &statements_, &failedStatements_, &rows_, &busyRetries_, &statementCacheHits_,
+			&statementCacheMisses_, &schemaLookups_, &schemaRefreshes_, &slowQueries_, &poolAcquisitions_,
+			&poolWaits_, &tasks_, &checkpoints_, &failedCheckpoints_, &checkpointedFrames_ })
+		{
+			counter->store(0, std::memory_order_relaxed);
+		} // end of for
+
+		poolInUse_.store(0, std::memory_order_relaxed);
+		poolOpen_.store(0, std::memory_order_relaxed);
+		queueDepth_.store(0, std::memory_order_relaxed);
+		maxQueueDepth_.store(0, std::memory_order_relaxed);
+		walFrames_.store(0, std::memory_order_relaxed);
+
+		for (auto* histogram : { &statementTime_, &prepareTime_, &stepTime_, &decodeTime_, &rowsPerStatement_,
+			&poolWaitTime_, &taskQueueTime_, &taskRunTime_, &checkpointTime_ })
+		{
+			histogram->reset();
+		} // end of for
+	} // end of reset
+
+} // namespace sqlite_flux
@@ -0,0 +1,284 @@
+// src/ParallelScan.cpp
+#include "ParallelScan.h"
+#include "ReadSession.h"
+#include "ValueVisitor.h"
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+
+namespace sqlite_flux
+{
+
+	namespace
+	{
+		bool equalsIgnoreCase(const std::string& a, const std::string& b)
+		{
+			return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char x, unsigned char y) {
+				return std::tolower(x) == std::tolower(y);
+				});
+		} // end of equalsIgnoreCase
+
+		bool isRowidAlias(const std::string& column_)
+		{
+			return equalsIgnoreCase(column_, "rowid") || equalsIgnoreCase(column_, "_rowid_") ||
+				equalsIgnoreCase(column_, "oid");
+		} // end of isRowidAlias
+
+		// The INTEGER PRIMARY KEY column (a rowid alias), if the table has one
+		std::string integerPrimaryKey(const TableDescriptor& table)
+		{
+			std::string key;
+			for (const ColumnInfo& column_ : table.columns())
+			{
+				if (!column_.primaryKey) continue;
+				if (!key.empty()) return {};  // Composite key
+
+				std::string type = column_.type;
+				std::transform(type.begin(), type.end(), type.begin(),
+					[](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+				if (type != "INTEGER") return {};
+				key = column_.name;
+			} // end of for
+			return key;
+		} // end of integerPrimaryKey
+	} // namespace
+
+	ParallelScan::ParallelScan(ConnectionPool& pool, ThreadPool& threads, std::string tableName,
+		const ParallelScanOptions& options)
+		: pool_(pool), threads_(threads), tableName_(std::move(tableName)), options_(options)
+	{
+		{
+			auto conn = pool_.acquireRead();
+			table_ = conn->getTableDescriptor(tableName_);
+		} // end of connection scope
+
+		if (!table_ || table_->empty())
+		{
+			throw std::runtime_error("Table not found or has no columns: " + tableName_);
+		} // end of if
+
+		// Any other column may hold NULLs, REALs or TEXT, which no integer range
+		// matches: those rows would silently go missing
+		const std::string primaryKey = integerPrimaryKey(*table_);
+		keyColumn_ = options_.keyColumn;
+		if (keyColumn_.empty())
+		{
+			keyColumn_ = primaryKey.empty() ? "rowid" : primaryKey;
+		} // end of if
+		else if (!isRowidAlias(keyColumn_) && !equalsIgnoreCase(keyColumn_, primaryKey))
+		{
+			throw std::invalid_argument("ParallelScan key must be rowid or the INTEGER PRIMARY KEY of " +
+				tableName_ + ": " + keyColumn_);
+		} // end of else if
+	} // end of ParallelScan constructor
+
+	ParallelScan& ParallelScan::Columns(std::vector<std::string> columns)
+	{
+		for (const auto& col : columns)
+		{
+			table_->require(col);
+		} // end of for
+
+		selectedColumns_ = std::move(columns);
+		return *this;
+	} // end of Columns
+
+	ParallelScan& ParallelScan::Filter(const std::string& column_, const ColumnValue& value_, CompareOp op_)
+	{
+		table_->validateValue(column_, value_);
+		filters_.emplace_back(column_, value_, op_);
+		return *this;
+	} // end of Filter
+
+	std::string ParallelScan::buildSql() const
+	{
+		std::ostringstream sql;
+		sql << "SELECT ";
+		if (selectedColumns_.empty())
+		{
+			sql << "*";
+		} // end of if
+		else
+		{
+			for (size_t i = 0; i < selectedColumns_.size(); ++i)
+			{
+				if (i > 0) sql << ", ";
+				sql << selectedColumns_[i];
+			} // end of for
+		} // end of else
+
+		sql << " FROM " << tableName_ << " WHERE ";
+		for (const auto& filter : filters_)
+		{
+			sql << filter.toSql() << " AND ";
+		} // end of for
+
+		// Each range is one index seek (rowid order) and read back in key order
+		sql << keyColumn_ << " BETWEEN ? AND ? ORDER BY " << keyColumn_;
+		return sql.str();
+	} // end of buildSql
+
+	ResultSet ParallelScan::Execute()
+	{
+		std::vector<ResultSet> parts(partitionTarget());
+
+		Stream([&parts](const ScanPartition& partition, Cursor& cursor) {
+			ResultSet& rows = parts[partition.index];
+			for (const Row& row : cursor)
+			{
+				rows.push_back(row);
+			} // end of for
+			});
+
+		// Partition order is key order
+		size_t total = 0;
+		for (const auto& part : parts) total += part.size();
+
+		ResultSet merged;
+		merged.reserve(total);
+		for (auto& part : parts)
+		{
+			std::move(part.begin(), part.end(), std::back_inserter(merged));
+		} // end of for
+		return merged;
+	} // end of Execute
+
+	void ParallelScan::Stream(const PartitionCallback& fn)
+	{
+		partitions_.clear();
+
+		ReadSessionOptions sessionOptions;
+		sessionOptions.connections = partitionTarget();
+		sessionOptions.acquireTimeout = options_.acquireTimeout;
+		sessionOptions.pinSnapshot = options_.pinSnapshot;
+		ReadSession session(pool_, sessionOptions);  // Ends the reads on every way out
+
+		planPartitions(session[0], session.width());
+
+		const std::string sql = buildSql();
+		std::vector<ColumnValue> baseParams;
+		baseParams.reserve(filters_.size() + 2);
+		for (const auto& filter : filters_)
+		{
+			baseParams.push_back(filter.value_);
+		} // end of for
+
+		auto scan = [&](size_t i) {
+			const ScanPartition& partition = partitions_[i];
+			std::vector<ColumnValue> params = baseParams;
+			params.emplace_back(partition.firstKey);
+			params.emplace_back(partition.lastKey);
+
+			Cursor cursor = session[i].stream(sql, params);
+			if (!cursor.isValid())
+			{
+				throw std::runtime_error("Failed to prepare scan: " + session[i].getLastError());
+			} // end of if
+
+			fn(partition, cursor);
+
+			if (cursor.hasError())
+			{
+				throw std::runtime_error("Scan failed: " + cursor.getLastError());
+			} // end of if
+		};
+
+		// The caller takes partition 0; every started partition is waited for
+		// before anything is rethrown, as they all use the session
+		std::vector<std::future<void>> running;
+		std::exception_ptr firstError;
+		for (size_t i = 1; i < partitions_.size(); ++i)
+		{
+			try
+			{
+				running.push_back(threads_.enqueue(scan, i));
+			} // end of try
+			catch (const ThreadPoolFullError&)
+			{
+				try
+				{
+					scan(i);
+				} // end of try
+				catch (...)
+				{
+					if (!firstError) firstError = std::current_exception();
+				} // end of catch
+			} // end of catch
+		} // end of for
+
+		if (!partitions_.empty())
+		{
+			try
+			{
+				scan(0);
+			} // end of try
+			catch (...)
+			{
+				if (!firstError) firstError = std::current_exception();
+			} // end of catch
+		} // end of if
+
+		for (auto& part : running)
+		{
+			try
+			{
+				part.get();
+			} // end of try
+			catch (...)
+			{
+				if (!firstError) firstError = std::current_exception();
+			} // end of catch
+		} // end of for
+
+		if (firstError)
+		{
+			std::rethrow_exception(firstError);
+		} // end of if
+	} // end of Stream
+
+	size_t ParallelScan::partitionTarget() const
+	{
+		size_t target = options_.partitions > 0 ? options_.partitions : threads_.size() + 1;
+		return std::max<size_t>(target, 1);
+	} // end of partitionTarget
+
+	void ParallelScan::planPartitions(Analyzer& conn, size_t count)
+	{
+		auto bounds = conn.query("SELECT MIN(" + keyColumn_ + ") AS lo, MAX(" + keyColumn_ + ") AS hi FROM " + tableName_);
+		if (bounds.empty())
+		{
+			throw std::runtime_error("Failed to read key range: " + conn.getLastError());
+		} // end of if
+
+		if (std::holds_alternative<std::monostate>(bounds[0]["lo"]))
+		{
+			return;  // Empty table
+		} // end of if
+
+		auto lo = getValue<int64_t>(bounds[0], "lo");
+		auto hi = getValue<int64_t>(bounds[0], "hi");
+		if (!lo || !hi)
+		{
+			throw std::runtime_error("ParallelScan key " + keyColumn_ + " of " + tableName_ + " is not an integer");
+		} // end of if
+
+		// Width of [lo, hi] minus one, in unsigned arithmetic so it cannot overflow
+		const uint64_t span = static_cast<uint64_t>(*hi) - static_cast<uint64_t>(*lo);
+		if (span < count - 1) count = static_cast<size_t>(span) + 1;
+
+		const uint64_t width = span / count;
+		const uint64_t extra = span % count + 1;  // The first `extra` ranges take one more key
+
+		uint64_t first = static_cast<uint64_t>(*lo);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint64_t last = first + width - (i < extra ? 0 : 1);
+			partitions_.push_back(ScanPartition{ i, static_cast<int64_t>(first), static_cast<int64_t>(last) });
+			first = last + 1;
+		} // end of for
+	} // end of planPartitions
+
+} // namespace sqlite_flux
@@ -11,58 +11,6 @@
 namespace sqlite_flux
 {
 
-    // ============================================================================
-    // Helper function to convert CompareOp to SQL string
-    // ============================================================================
-
-    static std::string compareOpToString(CompareOp op_)
-    {
-        switch (op_)
-        {
-        case CompareOp::Equal:              return "=";
-        case CompareOp::NotEqual:           return "!=";
-        case CompareOp::LessThan:           return "<";
-        case CompareOp::LessThanOrEqual:    return "<=";
-        case CompareOp::GreaterThan:        return ">";
-        case CompareOp::GreaterThanOrEqual: return ">=";
-        case CompareOp::Like:               return "LIKE";
-        case CompareOp::In:                 return "IN";
-        default:                            return "=";
-        }
-    }
-
-    // ============================================================================
-    // Helper function to convert ColumnValue to SQL string
-    // ============================================================================
-
-    static std::string valueToSql(const ColumnValue& value_)
-    {
-        std::ostringstream oss;
-
-        std::visit(overloaded{
-            [&oss](std::monostate) { oss << "NULL"; },
-            [&oss](int64_t v) { oss << v; },
-            [&oss](double v) { oss << v; },
-            [&oss](const std::string& v) {
-                oss << "'";
-                // Basic SQL escape - replace ' with ''
-                for (char c : v)
-                {
-                    if (c == '\'')
-                        oss << "''";
-                    else
-                        oss << c;
-                }
-                oss << "'";
-            },
-            [&oss](const std::vector<uint8_t>&) {
-                oss << "?";  // BLOB needs parameter binding
-            }
-            }, value_);
-
-        return oss.str();
-    }
-
     // ============================================================================
     // FilterCondition Implementation
     // ============================================================================
@@ -74,9 +22,13 @@ namespace sqlite_flux
 
     std::string FilterCondition::toSql() const
     {
-        std::ostringstream oss;
-        oss << column_ << " " << compareOpToString(op_) << " " << valueToSql(value_);
-        return oss.str();
+        std::string sql;
+        sql.reserve(column_.size() + 12);
+        sql += column_;
+        sql += ' ';
+        sql += compareOpSql(op_);
+        sql += (op_ == CompareOp::In) ? " (?)" : " ?";
+        return sql;
     }
 
     // ============================================================================
@@ -86,10 +38,10 @@ namespace sqlite_flux
     QueryBuilder::QueryBuilder(Analyzer& analyzer, const std::string& tableName)
         : analyzer_(analyzer), tableName_(tableName)
     {
-        // Get and cache the table schema
-        schema_ = analyzer_.getTableSchema(tableName_);
+        // Shared descriptor from the connection's schema snapshot (no copy)
+        table_ = analyzer_.getTableDescriptor(tableName_);
 
-        if (schema_.empty())
+        if (!table_ || table_->empty())
         {
             throw std::runtime_error("Table not found or has no columns: " + tableName_);
         }
@@ -147,10 +99,54 @@ namespace sqlite_flux
         return *this;
     }
 
+    QueryBuilder& QueryBuilder::After(const std::string& column_, const ColumnValue& lastValue)
+    {
+        validateColumn(column_);
+        validateColumnType(column_, lastValue);
+
+        if (orderByColumn_.empty())
+        {
+            OrderBy(column_);
+        }
+        else if (orderByColumn_ != column_)
+        {
+            throw std::invalid_argument("After() column '" + column_ +
+                "' must be the OrderBy() column '" + orderByColumn_ + "'");
+        }
+
+        afterColumn_ = column_;
+        afterValue_ = lastValue;
+        return *this;
+    }
+
     ResultSet QueryBuilder::Execute()
     {
         std::string sql = buildSql();
-        return analyzer_.query(sql);
+        return analyzer_.query(sql, buildParams());
+    }
+
+    ResultTable QueryBuilder::ExecuteTable()
+    {
+        std::string sql = buildSql();
+        return analyzer_.queryTable(sql, buildParams());
+    }
+
+    ArenaResultTable QueryBuilder::ExecuteArena()
+    {
+        std::string sql = buildSql();
+        return analyzer_.queryArena(sql, buildParams());
+    }
+
+    Cursor QueryBuilder::Stream()
+    {
+        Cursor cursor = analyzer_.stream(buildSql(), buildParams());
+
+        if (!cursor.isValid())
+        {
+            throw std::runtime_error("Failed to prepare streaming query: " + analyzer_.getLastError());
+        }
+
+        return cursor;
     }
 
     std::optional<Row> QueryBuilder::ExecuteFirst()
@@ -174,37 +170,58 @@ namespace sqlite_flux
 
     int64_t QueryBuilder::Count()
     {
-        // Save current state
-        auto originalColumns = selectedColumns_;
-        int originalLimit = limitValue_;
-        int originalOffset = offsetValue_;
+        std::ostringstream sql;
+        sql << "SELECT COUNT(*)";
+        appendFromWhere(sql);
 
-        // Modify for COUNT query
-        selectedColumns_.clear();
-        selectedColumns_.push_back("COUNT(*) as count");
-        limitValue_ = -1;
-        offsetValue_ = -1;
+        auto count = analyzer_.queryScalar(sql.str(), buildParams());
+        if (!count)
+        {
+            return 0;
+        }
 
-        // Execute
-        auto results = Execute();
+        auto* value = std::get_if<int64_t>(&*count);
+        return value ? *value : 0;
+    }
 
-        // Restore state
-        selectedColumns_ = originalColumns;
-        limitValue_ = originalLimit;
-        offsetValue_ = originalOffset;
+    bool QueryBuilder::Any()
+    {
+        std::ostringstream sql;
+        sql << "SELECT EXISTS(SELECT 1";
+        appendFromWhere(sql);
+        sql << " LIMIT 1)";
 
-        if (results.empty())
+        auto exists = analyzer_.queryScalar(sql.str(), buildParams());
+        if (!exists)
         {
-            return 0;
+            return false;
         }
 
-        auto count = getValue<int64_t>(results[0], "count");
-        return count.value_or(0);
+        auto* value = std::get_if<int64_t>(&*exists);
+        return value && *value != 0;
     }
 
-    bool QueryBuilder::Any()
+    void QueryBuilder::appendFromWhere(std::ostringstream& sql) const
     {
-        return Count() > 0;
+        // FROM clause
+        sql << " FROM " << tableName_;
+
+        // WHERE clause (the keyset bound goes last, matching buildParams())
+        if (!filters_.empty() || !afterColumn_.empty())
+        {
+            sql << " WHERE ";
+            for (size_t i = 0; i < filters_.size(); ++i)
+            {
+                if (i > 0) sql << " AND ";
+                sql << filters_[i].toSql();
+            }
+
+            if (!afterColumn_.empty())
+            {
+                if (!filters_.empty()) sql << " AND ";
+                sql << afterColumn_ << (orderAscending_ ? " > ?" : " < ?");
+            }
+        }
     }
 
     std::string QueryBuilder::buildSql() const
@@ -226,21 +243,15 @@ namespace sqlite_flux
             }
         }
 
-        // FROM clause
-        sql << " FROM " << tableName_;
+        appendFromWhere(sql);
 
-        // WHERE clause
-        if (!filters_.empty())
+        // ORDER BY clause
+        if (!afterColumn_.empty() && orderByColumn_ != afterColumn_)
         {
-            sql << " WHERE ";
-            for (size_t i = 0; i < filters_.size(); ++i)
-            {
-                if (i > 0) sql << " AND ";
-                sql << filters_[i].toSql();
-            }
+            throw std::invalid_argument("After() column '" + afterColumn_ +
+                "' must be the OrderBy() column '" + orderByColumn_ + "'");
         }
 
-        // ORDER BY clause
         if (!orderByColumn_.empty())
         {
             sql << " ORDER BY " << orderByColumn_;
@@ -253,96 +264,42 @@ namespace sqlite_flux
             sql << " LIMIT " << limitValue_;
         }
 
-        // OFFSET clause
+        // OFFSET clause (SQLite only accepts it after a LIMIT; -1 is unbounded)
         if (offsetValue_ > 0)
         {
+            if (limitValue_ <= 0) sql << " LIMIT -1";
             sql << " OFFSET " << offsetValue_;
         }
 
         return sql.str();
     }
 
-    void QueryBuilder::validateColumn(const std::string& column_) const
+    std::vector<ColumnValue> QueryBuilder::buildParams() const
     {
-        auto it = std::find_if(schema_.begin(), schema_.end(),  [&column_](const ColumnInfo& info) { return info.name == column_; });
+        std::vector<ColumnValue> params;
+        params.reserve(filters_.size() + 1);
 
-        if (it == schema_.end())
+        for (const auto& filter : filters_)
         {
-            throw std::runtime_error("Column '" + column_ + "' not found in table '" + tableName_ + "'");
+            params.push_back(filter.value_);
         }
-    }
 
-    void QueryBuilder::validateColumnType(const std::string& column_, const ColumnValue& value_) const
-    {
-        // Allow NULL for any column type
-        if (std::holds_alternative<std::monostate>(value_))
+        if (!afterColumn_.empty())
         {
-            return;
+            params.push_back(afterValue_);
         }
 
-        std::string sqliteType = getSqliteType(column_);
-
-        if (!isTypeCompatible(sqliteType, value_))
-        {
-            std::string valueType;
-            std::visit(overloaded{
-                [&valueType](std::monostate) { valueType = "NULL"; },
-                [&valueType](int64_t) { valueType = "int64_t"; },
-                [&valueType](double) { valueType = "double"; },
-                [&valueType](const std::string&) { valueType = "string"; },
-                [&valueType](const std::vector<uint8_t>&) { valueType = "blob"; }
-                }, value_);
-
-            throw std::runtime_error( "Type mismatch for column_ '" + column_ + "': " +   "expected " + sqliteType + ", got " + valueType );
-        }
+        return params;
     }
 
-    std::string QueryBuilder::getSqliteType(const std::string& column_) const
+    void QueryBuilder::validateColumn(const std::string& column_) const
     {
-        auto it = std::find_if(schema_.begin(), schema_.end(),  [&column_](const ColumnInfo& info) { return info.name == column_; });
-
-        if (it != schema_.end())
-        {
-            return it->type;
-        }
-
-        return "";
+        table_->require(column_);
     }
 
-    bool QueryBuilder::isTypeCompatible(const std::string& sqliteType, const ColumnValue& value_) const
+    void QueryBuilder::validateColumnType(const std::string& column_, const ColumnValue& value_) const
     {
-        // SQLite type affinity rules
-        // INTEGER affinity
-        if (sqliteType.find("INT") != std::string::npos)
-        {
-            return std::holds_alternative<int64_t>(value_);
-        }
-
-        // TEXT affinity
-        if (sqliteType.find("CHAR") != std::string::npos ||
-            sqliteType.find("CLOB") != std::string::npos ||
-            sqliteType.find("TEXT") != std::string::npos)
-        {
-            return std::holds_alternative<std::string>(value_);
-        }
-
-        // BLOB affinity
-        if (sqliteType.find("BLOB") != std::string::npos)
-        {
-            return std::holds_alternative<std::vector<uint8_t>>(value_);
-        }
-
-        // REAL affinity
-        if (sqliteType.find("REAL") != std::string::npos ||
-            sqliteType.find("FLOA") != std::string::npos ||
-            sqliteType.find("DOUB") != std::string::npos)
-        {
-            return std::holds_alternative<double>(value_);
-        }
-
-        // NUMERIC affinity - accepts both int and real
-        return std::holds_alternative<int64_t>(value_) ||
-            std::holds_alternative<double>(value_);
+        table_->validateValue(column_, value_);
     }
 
     // ============================================================================
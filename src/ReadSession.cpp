@@ -0,0 +1,229 @@
+// src/ReadSession.cpp
+#include "ReadSession.h"
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+
+namespace sqlite_flux
+{
+
+	namespace
+	{
+#ifdef SQLITE_ENABLE_SNAPSHOT
+		constexpr bool snapshotApi = true;
+#else
+		constexpr bool snapshotApi = false;
+#endif
+	} // namespace
+
+	// ============================================================================
+	// Lease implementation
+	// ============================================================================
+
+	ReadSession::Lease::Lease(ReadSession* session, size_t index)
+		: session_(session), index_(index)
+	{
+	} // end of Lease constructor
+
+	ReadSession::Lease::~Lease()
+	{
+		release();
+	} // end of Lease destructor
+
+	ReadSession::Lease::Lease(Lease&& other) noexcept
+		: session_(std::exchange(other.session_, nullptr)), index_(other.index_)
+	{
+	} // end of Lease move constructor
+
+	ReadSession::Lease& ReadSession::Lease::operator=(Lease&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			session_ = std::exchange(other.session_, nullptr);
+			index_ = other.index_;
+		} // end of if
+		return *this;
+	} // end of Lease move assignment
+
+	void ReadSession::Lease::release()
+	{
+		if (session_)
+		{
+			std::exchange(session_, nullptr)->release(index_);
+		} // end of if
+	} // end of release
+
+	// ============================================================================
+	// ReadSession implementation
+	// ============================================================================
+
+	ReadSession::ReadSession(ConnectionPool& pool, const ReadSessionOptions& options)
+		: pool_(pool), options_(options)
+	{
+		acquireConnections();
+		begin();
+
+		// Lowest index leased first
+		free_.reserve(conns_.size());
+		for (size_t i = conns_.size(); i > 0; --i)
+		{
+			free_.push_back(i - 1);
+		} // end of for
+	} // end of ReadSession constructor
+
+	ReadSession::~ReadSession()
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			cv_.wait(lock, [this] { return pendingTasks_ == 0 && free_.size() == conns_.size(); });
+		} // end of lock scope
+
+		endReads(conns_.size());
+	} // end of ReadSession destructor
+
+	ReadSession::Lease ReadSession::lease()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		cv_.wait(lock, [this] { return !free_.empty(); });
+
+		size_t index = free_.back();
+		free_.pop_back();
+		return Lease(this, index);
+	} // end of lease
+
+	void ReadSession::release(size_t index)
+	{
+		// Notified under the lock: the destructor may be waiting to free cv_
+		std::lock_guard<std::mutex> lock(mutex_);
+		free_.push_back(index);
+		cv_.notify_all();
+	} // end of release
+
+	void ReadSession::beginTask()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		++pendingTasks_;
+	} // end of beginTask
+
+	void ReadSession::endTask()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		--pendingTasks_;
+		cv_.notify_all();
+	} // end of endTask
+
+	void ReadSession::acquireConnections()
+	{
+		size_t wanted = std::max<size_t>(options_.connections, 1);
+
+		// Without a separate writer the pinning connection comes out of the same
+		// pool, so leave one for it
+		if (options_.pinSnapshot && !pool_.isReadWriteSplit() && pool_.maxSize() > 1)
+		{
+			wanted = std::min(wanted, pool_.maxSize() - 1);
+		} // end of if
+		else
+		{
+			wanted = std::min(wanted, std::max<size_t>(pool_.maxSize(), 1));
+		} // end of else
+
+		conns_.reserve(wanted);
+		conns_.push_back(pool_.acquireRead());
+
+		while (conns_.size() < wanted)
+		{
+			auto conn = pool_.tryAcquireRead(options_.acquireTimeout);
+			if (!conn) break;  // Busy pool: a narrower session
+			conns_.push_back(std::move(*conn));
+		} // end of while
+	} // end of acquireConnections
+
+	bool ReadSession::startRead(Analyzer& conn, std::string& error)
+	{
+		if (!conn.execute("BEGIN"))
+		{
+			error = conn.getLastError();
+			return false;
+		} // end of if
+
+		// BEGIN is deferred; the first read is what takes the snapshot
+		if (!conn.queryScalar("PRAGMA schema_version"))
+		{
+			error = conn.getLastError();
+			conn.rollback();
+			return false;
+		} // end of if
+
+		return true;
+	} // end of startRead
+
+	void ReadSession::begin()
+	{
+		const bool pin = options_.pinSnapshot && conns_.size() > 1;
+		std::string error;
+
+		// Preferred: open the first connection's snapshot on the rest, which
+		// never holds up writers
+		if (pin && snapshotApi)
+		{
+			if (!startRead(*conns_[0], error))
+			{
+				throw std::runtime_error("Failed to start read session: " + error);
+			} // end of if
+
+			size_t shared = 1;
+			while (shared < conns_.size() && conns_[0]->shareReadSnapshot(*conns_[shared]))
+			{
+				++shared;
+			} // end of while
+
+			if (shared == conns_.size())
+			{
+				sharedSnapshot_ = true;
+				return;
+			} // end of if
+
+			endReads(shared);  // Start over under the write lock
+		} // end of if
+
+		// Pinning: nothing can commit while the read transactions start, so the
+		// first read of each sees the same version. Released right after.
+		std::optional<ConnectionPool::Connection> barrier;
+		if (pin)
+		{
+			barrier.emplace(pool_.acquireWrite());
+			if (!(*barrier)->execute("BEGIN IMMEDIATE"))
+			{
+				throw std::runtime_error("Failed to pin read session: " + (*barrier)->getLastError());
+			} // end of if
+		} // end of if
+
+		size_t begun = 0;
+		while (begun < conns_.size() && startRead(*conns_[begun], error))
+		{
+			++begun;
+		} // end of while
+
+		if (barrier)
+		{
+			(*barrier)->rollback();
+			barrier.reset();
+		} // end of if
+
+		if (begun < conns_.size())
+		{
+			endReads(begun);
+			throw std::runtime_error("Failed to start read session: " + error);
+		} // end of if
+	} // end of begin
+
+	void ReadSession::endReads(size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			conns_[i]->rollback();  // Read-only: ends the read transaction
+		} // end of for
+	} // end of endReads
+
+} // namespace sqlite_flux
@@ -0,0 +1,88 @@
+// src/ResultArena.cpp
+#include "ResultArena.h"
+#include <algorithm>
+#include <bit>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// ResultArena implementation
+	// ============================================================================
+
+	ResultArena::ResultArena(size_t initialBytes, size_t maxRetainedBytes)
+		: block_(std::make_unique<std::byte[]>(std::max<size_t>(initialBytes, 1)))
+		, capacity_(std::max<size_t>(initialBytes, 1))
+		, maxRetained_(std::max(maxRetainedBytes, capacity_))
+	{
+		resource_.emplace(block_.get(), capacity_, std::pmr::new_delete_resource());
+	} // end of ResultArena constructor
+
+	void ResultArena::reset()
+	{
+		resource_.reset();  // Returns the overflow chunks to the heap
+
+		// Fit the whole of the next result of this size into one block
+		if (allocated_ > capacity_ && capacity_ < maxRetained_)
+		{
+			capacity_ = std::min(std::bit_ceil(allocated_), maxRetained_);
+			block_ = std::make_unique<std::byte[]>(capacity_);
+		} // end of if
+
+		allocated_ = 0;
+		resource_.emplace(block_.get(), capacity_, std::pmr::new_delete_resource());
+	} // end of reset
+
+	void* ResultArena::do_allocate(size_t bytes, size_t alignment)
+	{
+		allocated_ += bytes;
+		return resource_->allocate(bytes, alignment);
+	} // end of do_allocate
+
+	// ============================================================================
+	// ResultArenaPool implementation
+	// ============================================================================
+
+	ResultArenaPool::ResultArenaPool(const ResultArenaOptions& options)
+		: state_(std::make_shared<State>())
+	{
+		state_->options = options;
+		state_->idle.reserve(options.maxIdleArenas);  // Returning an arena never allocates
+	} // end of ResultArenaPool constructor
+
+	std::shared_ptr<ResultArena> ResultArenaPool::acquire()
+	{
+		std::unique_ptr<ResultArena> arena;
+		{
+			std::lock_guard lock(state_->mutex);
+			if (!state_->idle.empty())
+			{
+				arena = std::move(state_->idle.back());
+				state_->idle.pop_back();
+			} // end of if
+		} // end of lock scope
+
+		if (!arena)
+		{
+			arena = std::make_unique<ResultArena>(state_->options.initialBytes, state_->options.maxRetainedBytes);
+		} // end of if
+
+		return std::shared_ptr<ResultArena>(arena.release(), [state = state_](ResultArena* returned) {
+			std::unique_ptr<ResultArena> owned(returned);
+			owned->reset();
+
+			std::lock_guard lock(state->mutex);
+			if (state->idle.size() < state->options.maxIdleArenas)
+			{
+				state->idle.push_back(std::move(owned));
+			} // end of if
+			});
+	} // end of acquire
+
+	size_t ResultArenaPool::idle() const
+	{
+		std::lock_guard lock(state_->mutex);
+		return state_->idle.size();
+	} // end of idle
+
+} // namespace sqlite_flux
@@ -0,0 +1,260 @@
+// src/ResultCache.cpp
+#include "ResultCache.h"
+#include "ValueVisitor.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace sqlite_flux
+{
+
+	namespace
+	{
+		void appendLength(std::string& key, size_t size)
+		{
+			uint64_t length = size;
+			key.append(reinterpret_cast<const char*>(&length), sizeof(length));
+		} // end of appendLength
+
+		// Collapse whitespace runs outside quotes and comments to one space and
+		// trim both ends. Comments are kept verbatim with their terminator: the
+		// newline that ends a -- comment decides what the rest of the line means.
+		void appendNormalizedSql(std::string& key, std::string_view sql)
+		{
+			char quote = 0;
+			bool pendingSpace = false;
+			for (size_t i = 0; i < sql.size(); ++i)
+			{
+				const char c = sql[i];
+				if (quote)
+				{
+					key.push_back(c);
+					if (c == quote) quote = 0;  // A doubled quote reopens on the next char
+					continue;
+				} // end of if
+
+				if (std::isspace(static_cast<unsigned char>(c)))
+				{
+					pendingSpace = !key.empty() && key.back() != '\n';  // A -- comment's newline already separates
+					continue;
+				} // end of if
+
+				if (pendingSpace)
+				{
+					key.push_back(' ');
+					pendingSpace = false;
+				} // end of if
+
+				const std::string_view rest = sql.substr(i);
+				if (rest.starts_with("--") || rest.starts_with("/*"))
+				{
+					const bool line = rest[0] == '-';
+					size_t end = line ? rest.find('\n') : rest.find("*/", 2);
+					end = end == std::string_view::npos ? rest.size() : end + (line ? 1 : 2);
+					key.append(rest.substr(0, end));
+					i += end - 1;
+					continue;
+				} // end of if
+
+				key.push_back(c);
+				if (c == '\'' || c == '"' || c == '`') quote = c;
+				else if (c == '[') quote = ']';
+			} // end of for
+		} // end of appendNormalizedSql
+	} // namespace
+
+	ResultCache::ResultCache(const ResultCacheOptions& options)
+		: options_(options)
+	{
+		if (options_.maxEntryBytes == 0)
+		{
+			options_.maxEntryBytes = options_.maxBytes / 4;
+		} // end of if
+	} // end of ResultCache constructor
+
+	std::string ResultCache::makeKey(std::string_view sql, std::span<const ColumnValue> params)
+	{
+		std::string key;
+		key.reserve(sql.size() + 1 + params.size() * 9);
+		appendNormalizedSql(key, sql);
+		key.push_back('\0');
+
+		// Type-tagged so 1, 1.0 and '1' are different keys
+		for (const ColumnValue& value : params)
+		{
+			std::visit(overloaded{
+				[&key](std::monostate) { key.push_back('n'); },
+				[&key](int64_t v) { key.push_back('i'); key.append(reinterpret_cast<const char*>(&v), sizeof(v)); },
+				[&key](double v) { key.push_back('r'); key.append(reinterpret_cast<const char*>(&v), sizeof(v)); },
+				[&key](const std::string& v) { key.push_back('t'); appendLength(key, v.size()); key.append(v); },
+				[&key](const std::vector<uint8_t>& v) {
+					key.push_back('b');
+					appendLength(key, v.size());
+					key.append(reinterpret_cast<const char*>(v.data()), v.size());
+				}
+				}, value);
+		} // end of for
+
+		return key;
+	} // end of makeKey
+
+	size_t ResultCache::estimateBytes(const ResultSet& results)
+	{
+		// Per map node: key string, value variant and the node/bucket overhead
+		constexpr size_t nodeOverhead = sizeof(std::string) + sizeof(ColumnValue) + 4 * sizeof(void*);
+
+		size_t bytes = results.capacity() * sizeof(Row);
+		for (const Row& row : results)
+		{
+			bytes += row.bucket_count() * sizeof(void*);
+			for (const auto& [name, value] : row)
+			{
+				bytes += nodeOverhead;
+				if (name.size() >= sizeof(std::string)) bytes += name.capacity();
+
+				if (const auto* text = std::get_if<std::string>(&value))
+				{
+					bytes += text->capacity();
+				} // end of if
+				else if (const auto* blob = std::get_if<std::vector<uint8_t>>(&value))
+				{
+					bytes += blob->capacity();
+				} // end of else if
+			} // end of for
+		} // end of for
+
+		return bytes;
+	} // end of estimateBytes
+
+	std::shared_ptr<const ResultSet> ResultCache::lookup(const std::string& key)
+	{
+		std::lock_guard lock(mutex_);
+
+		auto it = index_.find(key);
+		if (it == index_.end())
+		{
+			++misses_;
+			return nullptr;
+		} // end of if
+
+		++hits_;
+		lru_.splice(lru_.begin(), lru_, it->second);
+		return it->second->results;
+	} // end of lookup
+
+	uint64_t ResultCache::epoch() const
+	{
+		std::lock_guard lock(mutex_);
+		return epoch_;
+	} // end of epoch
+
+	void ResultCache::insert(std::string key, ResultSet results, const std::vector<std::string>& tables,
+		uint64_t startEpoch)
+	{
+		const size_t bytes = estimateBytes(results) + key.capacity() + sizeof(Entry);
+
+		std::lock_guard lock(mutex_);
+
+		bool stale = clearedAt_ > startEpoch;
+		for (size_t i = 0; i < tables.size() && !stale; ++i)
+		{
+			auto changed = invalidatedAt_.find(tables[i]);
+			stale = changed != invalidatedAt_.end() && changed->second > startEpoch;
+		} // end of for
+
+		if (stale || bytes > options_.maxEntryBytes)
+		{
+			++rejected_;
+			return;
+		} // end of if
+
+		auto existing = index_.find(key);
+		if (existing != index_.end())
+		{
+			erase(existing->second);
+		} // end of if
+
+		lru_.push_front(Entry{ std::move(key), std::make_shared<const ResultSet>(std::move(results)), tables, bytes });
+		Entry& entry = lru_.front();
+		index_.emplace(entry.key, lru_.begin());
+		for (const std::string& table : entry.tables)
+		{
+			byTable_[table].insert(&entry);
+		} // end of for
+
+		bytes_ += bytes;
+		++insertions_;
+
+		while (bytes_ > options_.maxBytes && !lru_.empty())
+		{
+			erase(std::prev(lru_.end()));
+			++evictions_;
+		} // end of while
+	} // end of insert
+
+	void ResultCache::invalidateTable(const std::string& tableName)
+	{
+		std::lock_guard lock(mutex_);
+
+		invalidatedAt_[tableName] = ++epoch_;
+
+		auto it = byTable_.find(tableName);
+		if (it == byTable_.end()) return;
+
+		// erase() edits this set through the other tables' entries, so empty it first
+		std::unordered_set<Entry*> victims = std::move(it->second);
+		byTable_.erase(it);
+
+		for (Entry* entry : victims)
+		{
+			erase(index_.at(entry->key));
+			++invalidations_;
+		} // end of for
+	} // end of invalidateTable
+
+	void ResultCache::clear()
+	{
+		std::lock_guard lock(mutex_);
+
+		clearedAt_ = ++epoch_;
+		invalidations_ += lru_.size();
+		index_.clear();
+		byTable_.clear();
+		lru_.clear();
+		bytes_ = 0;
+	} // end of clear
+
+	ResultCacheStats ResultCache::getStats() const
+	{
+		std::lock_guard lock(mutex_);
+
+		ResultCacheStats stats;
+		stats.hits = hits_;
+		stats.misses = misses_;
+		stats.insertions = insertions_;
+		stats.evictions = evictions_;
+		stats.invalidations = invalidations_;
+		stats.rejected = rejected_;
+		stats.bytes = bytes_;
+		stats.entries = lru_.size();
+		return stats;
+	} // end of getStats
+
+	void ResultCache::erase(EntryList::iterator it)
+	{
+		Entry* entry = &*it;
+		for (const std::string& table : entry->tables)
+		{
+			auto set = byTable_.find(table);
+			if (set == byTable_.end()) continue;
+
+			set->second.erase(entry);
+			if (set->second.empty()) byTable_.erase(set);
+		} // end of for
+
+		bytes_ -= entry->bytes;
+		index_.erase(entry->key);
+		lru_.erase(it);
+	} // end of erase
+
+} // namespace sqlite_flux
@@ -0,0 +1,119 @@
+// src/ResultTable.cpp
+#include "ResultTable.h"
+#include <stdexcept>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// ResultHeader implementation
+	// ============================================================================
+
+	ResultHeader::ResultHeader(std::vector<std::string> columnNames)
+		: names(std::move(columnNames))
+	{
+		index.reserve(names.size());
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			// Last occurrence wins for duplicate names, matching Row semantics
+			index[names[i]] = i;
+		} // end of for
+	} // end of ResultHeader constructor
+
+	std::optional<size_t> ResultHeader::find(const std::string& name) const
+	{
+		auto it = index.find(name);
+		if (it == index.end())
+		{
+			return std::nullopt;
+		} // end of if
+		return it->second;
+	} // end of find
+
+	// ============================================================================
+	// ResultTable implementation
+	// ============================================================================
+
+	ResultTable::ResultTable(std::shared_ptr<const ResultHeader> header, std::vector<ColumnValue> cells)
+		: header_(std::move(header)), cells_(std::move(cells))
+	{
+		if (!header_ && !cells_.empty())
+		{
+			throw std::invalid_argument("ResultTable cells require a header");
+		} // end of if
+
+		if (header_ && !header_->names.empty() && cells_.size() % header_->names.size() != 0)
+		{
+			throw std::invalid_argument("ResultTable cell count is not a multiple of the column count");
+		} // end of if
+	} // end of ResultTable constructor
+
+	size_t ResultTable::rowCount() const
+	{
+		size_t columns = columnCount();
+		return columns == 0 ? 0 : cells_.size() / columns;
+	} // end of rowCount
+
+	const std::vector<std::string>& ResultTable::columnNames() const
+	{
+		static const std::vector<std::string> noColumns;
+		return header_ ? header_->names : noColumns;
+	} // end of columnNames
+
+	std::optional<size_t> ResultTable::columnIndex(const std::string& column_) const
+	{
+		if (!header_)
+		{
+			return std::nullopt;
+		} // end of if
+		return header_->find(column_);
+	} // end of columnIndex
+
+	const ColumnValue& ResultTable::at(size_t row, size_t col) const
+	{
+		if (row >= rowCount() || col >= columnCount())
+		{
+			throw std::out_of_range("ResultTable cell (" + std::to_string(row) + ", " +
+				std::to_string(col) + ") out of range");
+		} // end of if
+		return cell(row, col);
+	} // end of at
+
+	const ColumnValue& ResultTable::at(size_t row, const std::string& column_) const
+	{
+		auto col = columnIndex(column_);
+		if (!col)
+		{
+			throw std::out_of_range("Column '" + column_ + "' not in result");
+		} // end of if
+		return at(row, *col);
+	} // end of at
+
+	ResultSet ResultTable::toResultSet() const
+	{
+		ResultSet results;
+		results.reserve(rowCount());
+
+		for (auto row : *this)
+		{
+			results.push_back(row.toRow());
+		} // end of for
+
+		return results;
+	} // end of toResultSet
+
+	Row ResultTable::RowRef::toRow() const
+	{
+		Row row;
+		const auto& names = table_->columnNames();
+		row.reserve(names.size());
+
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			row[names[i]] = (*this)[i];
+		} // end of for
+
+		return row;
+	} // end of toRow
+
+} // namespace sqlite_flux
\ No newline at end of file
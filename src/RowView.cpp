@@ -0,0 +1,70 @@
+// src/RowView.cpp
+#include "RowView.h"
+#include "StatementHelpers.h"
+#include <sqlite3.h>
+
+namespace sqlite_flux
+{
+
+	// ============================================================================
+	// RowView implementation
+	// ============================================================================
+
+	std::string_view RowView::columnName(size_t col) const
+	{
+		if (!inRange(col)) return {};
+		return sqlite3_column_name(stmt_, static_cast<int>(col));
+	} // end of columnName
+
+	ValueType RowView::type(size_t col) const
+	{
+		if (!inRange(col)) return ValueType::Null;
+
+		switch (sqlite3_column_type(stmt_, static_cast<int>(col)))
+		{
+		case SQLITE_INTEGER: return ValueType::Integer;
+		case SQLITE_FLOAT: return ValueType::Real;
+		case SQLITE_TEXT: return ValueType::Text;
+		case SQLITE_BLOB: return ValueType::Blob;
+		default: return ValueType::Null;
+		} // end of switch
+	} // end of type
+
+	int64_t RowView::getInt64(size_t col) const
+	{
+		if (!inRange(col)) return 0;
+		return sqlite3_column_int64(stmt_, static_cast<int>(col));
+	} // end of getInt64
+
+	double RowView::getDouble(size_t col) const
+	{
+		if (!inRange(col)) return 0.0;
+		return sqlite3_column_double(stmt_, static_cast<int>(col));
+	} // end of getDouble
+
+	std::string_view RowView::text(size_t col) const
+	{
+		if (!inRange(col)) return {};
+
+		// Fetch the pointer before the size, as the SQLite docs recommend
+		const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt_, static_cast<int>(col)));
+		if (!text) return {};
+		return std::string_view(text, static_cast<size_t>(sqlite3_column_bytes(stmt_, static_cast<int>(col))));
+	} // end of text
+
+	std::span<const uint8_t> RowView::blob(size_t col) const
+	{
+		if (!inRange(col)) return {};
+
+		const uint8_t* data = static_cast<const uint8_t*>(sqlite3_column_blob(stmt_, static_cast<int>(col)));
+		if (!data) return {};
+		return std::span<const uint8_t>(data, static_cast<size_t>(sqlite3_column_bytes(stmt_, static_cast<int>(col))));
+	} // end of blob
+
+	ColumnValue RowView::value(size_t col) const
+	{
+		if (!inRange(col)) return std::monostate{};
+		return detail::readColumnValue(stmt_, static_cast<int>(col));
+	} // end of value
+
+} // namespace sqlite_flux
@@ -0,0 +1,80 @@
+// src/StatementHelpers.h
+#pragma once
+
+#include "ColumnValue.h"
+#include "ValueVisitor.h"
+#include <sqlite3.h>
+#include <span>
+
+namespace sqlite_flux
+{
+	namespace detail
+	{
+
+		// Bind one ColumnValue to a 1-based parameter index
+		// By default values are bound SQLITE_STATIC and must outlive the step/reset of
+		// stmt; pass copy=true when the statement outlives the values (e.g. Cursor)
+		inline int bindColumnValue(sqlite3_stmt* stmt, int index, const ColumnValue& value_, bool copy = false)
+		{
+			sqlite3_destructor_type lifetime = copy ? SQLITE_TRANSIENT : SQLITE_STATIC;
+
+			return std::visit(overloaded{
+				[&](std::monostate) { return sqlite3_bind_null(stmt, index); },
+				[&](int64_t v) { return sqlite3_bind_int64(stmt, index, v); },
+				[&](double v) { return sqlite3_bind_double(stmt, index, v); },
+				[&](const std::string& v) {
+					return sqlite3_bind_text64(stmt, index, v.data(), v.size(), lifetime, SQLITE_UTF8);
+				},
+				[&](const std::vector<uint8_t>& v) {
+					// A null data pointer would bind NULL, so empty blobs need zeroblob
+					if (v.empty()) return sqlite3_bind_zeroblob(stmt, index, 0);
+					return sqlite3_bind_blob64(stmt, index, v.data(), v.size(), lifetime);
+				}
+				}, value_);
+		} // end of bindColumnValue
+
+		// Bind values positionally to ?1..?N; returns the first non-OK result code
+		inline int bindParameters(sqlite3_stmt* stmt, std::span<const ColumnValue> params, bool copy = false)
+		{
+			for (size_t i = 0; i < params.size(); ++i)
+			{
+				int rc = bindColumnValue(stmt, static_cast<int>(i + 1), params[i], copy);
+				if (rc != SQLITE_OK)
+				{
+					return rc;
+				} // end of if
+			} // end of for
+
+			return SQLITE_OK;
+		} // end of bindParameters
+
+		// Decode the current row's column into an owning ColumnValue
+		inline ColumnValue readColumnValue(sqlite3_stmt* stmt, int col)
+		{
+			switch (sqlite3_column_type(stmt, col))
+			{
+			case SQLITE_INTEGER:
+				return sqlite3_column_int64(stmt, col);
+			case SQLITE_FLOAT:
+				return sqlite3_column_double(stmt, col);
+			case SQLITE_TEXT:
+			{
+				// Fetch the pointer before the size, as the SQLite docs recommend
+				const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+				int size = sqlite3_column_bytes(stmt, col);
+				return std::string(text, static_cast<size_t>(size));
+			} // end of case SQLITE_TEXT
+			case SQLITE_BLOB:
+			{
+				const uint8_t* data = static_cast<const uint8_t*>(sqlite3_column_blob(stmt, col));
+				int size = sqlite3_column_bytes(stmt, col);
+				return std::vector<uint8_t>(data, data + size);
+			} // end of case SQLITE_BLOB
+			case SQLITE_NULL:
+			default:
+				return std::monostate{};
+			} // end of switch
+		} // end of readColumnValue
+
+	} // namespace detail
+} // namespace sqlite_flux
@@ -0,0 +1,117 @@
+// src/TableDescriptor.cpp
+#include "TableDescriptor.h"
+#include "ValueVisitor.h"
+#include <stdexcept>
+
+namespace sqlite_flux
+{
+
+	ColumnAffinity affinityOf(const std::string& declaredType)
+	{
+		if (declaredType.find("INT") != std::string::npos)
+		{
+			return ColumnAffinity::Integer;
+		} // end of if
+
+		if (declaredType.find("CHAR") != std::string::npos ||
+			declaredType.find("CLOB") != std::string::npos ||
+			declaredType.find("TEXT") != std::string::npos)
+		{
+			return ColumnAffinity::Text;
+		} // end of if
+
+		if (declaredType.find("BLOB") != std::string::npos)
+		{
+			return ColumnAffinity::Blob;
+		} // end of if
+
+		if (declaredType.find("REAL") != std::string::npos ||
+			declaredType.find("FLOA") != std::string::npos ||
+			declaredType.find("DOUB") != std::string::npos)
+		{
+			return ColumnAffinity::Real;
+		} // end of if
+
+		return ColumnAffinity::Numeric;
+	} // end of affinityOf
+
+	bool acceptsValue(ColumnAffinity affinity, const ColumnValue& value_)
+	{
+		if (std::holds_alternative<std::monostate>(value_))
+		{
+			return true;
+		} // end of if
+
+		switch (affinity)
+		{
+		case ColumnAffinity::Integer:
+			return std::holds_alternative<int64_t>(value_);
+		case ColumnAffinity::Text:
+			return std::holds_alternative<std::string>(value_);
+		case ColumnAffinity::Blob:
+			return std::holds_alternative<std::vector<uint8_t>>(value_);
+		case ColumnAffinity::Real:
+			return std::holds_alternative<double>(value_);
+		case ColumnAffinity::Numeric:
+		default:
+			return std::holds_alternative<int64_t>(value_) ||
+				std::holds_alternative<double>(value_);
+		} // end of switch
+	} // end of acceptsValue
+
+	// ============================================================================
+	// TableDescriptor implementation
+	// ============================================================================
+
+	TableDescriptor::TableDescriptor(std::string name, TableSchema columns)
+		: name_(std::move(name)), columns_(std::move(columns))
+	{
+		affinities_.reserve(columns_.size());
+		index_.reserve(columns_.size());
+		for (size_t i = 0; i < columns_.size(); ++i)
+		{
+			affinities_.push_back(affinityOf(columns_[i].type));
+			index_.emplace(columns_[i].name, i);
+		} // end of for
+	} // end of TableDescriptor constructor
+
+	std::optional<size_t> TableDescriptor::indexOf(const std::string& column_) const
+	{
+		auto it = index_.find(column_);
+		if (it == index_.end()) return std::nullopt;
+		return it->second;
+	} // end of indexOf
+
+	size_t TableDescriptor::require(const std::string& column_) const
+	{
+		auto it = index_.find(column_);
+		if (it == index_.end())
+		{
+			throw std::runtime_error("Column '" + column_ + "' not found in table '" + name_ + "'");
+		} // end of if
+
+		return it->second;
+	} // end of require
+
+	void TableDescriptor::validateValue(const std::string& column_, const ColumnValue& value_) const
+	{
+		size_t index = require(column_);
+		if (acceptsValue(affinities_[index], value_))
+		{
+			return;
+		} // end of if
+
+		std::string valueType;
+		std::visit(overloaded{
+			[&valueType](std::monostate) { valueType = "NULL"; },
+			[&valueType](int64_t) { valueType = "int64_t"; },
+			[&valueType](double) { valueType = "double"; },
+			[&valueType](const std::string&) { valueType = "string"; },
+			[&valueType](const std::vector<uint8_t>&) { valueType = "blob"; }
+			}, value_);
+
+		throw std::runtime_error("Type mismatch for column_ '" + column_ + "': " +
+			"expected " + columns_[index].type + ", got " + valueType);
+	} // end of validateValue
+
+} // namespace sqlite_flux
@@ -1,5 +1,6 @@
 // src/UpdateBuilder.cpp
 #include "UpdateBuilder.h"
+#include "WriteBatcher.h"
 #include "ValueVisitor.h"
 #include <sstream>
 #include <stdexcept>
@@ -8,66 +9,27 @@
 namespace sqlite_flux
 {
 
-	// ============================================================================
-	// Helper function to convert ColumnValue to SQL string (reuse from InsertBuilder)
-	// ============================================================================
-
-	static std::string valueToSql(const ColumnValue& value_)
-	{
-		std::ostringstream oss;
-
-		std::visit(overloaded{
-			[&oss](std::monostate) { oss << "NULL"; },
-			[&oss](int64_t v) { oss << v; },
-			[&oss](double v) { oss << v; },
-			[&oss](const std::string& v) {
-				oss << "'";
-				// SQL escape - replace ' with ''
-				for (char c : v)
-				{
-					if (c == '\'')
-						oss << "''";
-					else
-						oss << c;
-				} // end of for
-				oss << "'";
-			},
-			[&oss](const std::vector<uint8_t>&) {
-				oss << "?";  // BLOB needs parameter binding
-			}
-			}, value_);
-
-		return oss.str();
-	} // end of valueToSql
-
-	// ============================================================================
-	// Helper function to convert CompareOp to SQL string (reuse from QueryBuilder)
-	// ============================================================================
-
-	static std::string compareOpToString(CompareOp op_)
-	{
-		switch (op_)
-		{
-		case CompareOp::Equal:              return "=";
-		case CompareOp::NotEqual:           return "!=";
-		case CompareOp::LessThan:           return "<";
-		case CompareOp::LessThanOrEqual:    return "<=";
-		case CompareOp::GreaterThan:        return ">";
-		case CompareOp::GreaterThanOrEqual: return ">=";
-		case CompareOp::Like:               return "LIKE";
-		case CompareOp::In:                 return "IN";
-		default:                            return "=";
-		} // end of switch
-	} // end of compareOpToString
-
 	// ============================================================================
 	// PreparedUpdate Implementation
 	// ============================================================================
 
 	PreparedUpdate::PreparedUpdate(Analyzer& analyzer, const std::string& tableName,
 		const std::unordered_map<std::string, ColumnValue>& updates)
-		: analyzer_(analyzer), tableName_(tableName), updates_(updates)
+		: analyzer_(analyzer), tableName_(tableName), setCount_(updates.size())
 	{
+		// Fix the SET order once; every statement prepared later shares it
+		setSql_ = "UPDATE " + tableName_ + " SET ";
+		params_.reserve(updates.size() + 4);
+
+		size_t index = 0;
+		for (const auto& [col, val] : updates)
+		{
+			if (index++ > 0) setSql_ += ", ";
+			setSql_ += col;
+			setSql_ += " = ?";
+			params_.push_back(val);
+		} // end of for
+
 		// Begin transaction for batch operations
 		if (!analyzer_.beginTransaction())
 		{
@@ -84,10 +46,15 @@ namespace sqlite_flux
 	PreparedUpdate::PreparedUpdate(PreparedUpdate&& other) noexcept
 		: analyzer_(other.analyzer_)
 		, tableName_(std::move(other.tableName_))
-		, updates_(std::move(other.updates_))
+		, setSql_(std::move(other.setSql_))
+		, params_(std::move(other.params_))
+		, setCount_(other.setCount_)
 		, currentFilters_(std::move(other.currentFilters_))
+		, statements_(std::move(other.statements_))
 		, inTransaction_(other.inTransaction_)
 		, updateCount_(other.updateCount_)
+		, changesSinceCommit_(other.changesSinceCommit_)
+		, operationCount_(other.operationCount_)
 		, batchSize_(other.batchSize_)
 	{
 		other.inTransaction_ = false;
@@ -100,53 +67,74 @@ namespace sqlite_flux
 		return *this;
 	} // end of Where
 
+	sqlite3_stmt* PreparedUpdate::statementForCurrentShape()
+	{
+		if (sqlite3_stmt* stmt = statements_.find(currentFilters_))
+		{
+			return stmt;
+		} // end of if
+
+		// First item with this shape: prepare once, owned by statements_
+		std::string sql = setSql_ + FilterShapeCache::whereClause(currentFilters_);
+		sqlite3_stmt* stmt = analyzer_.prepareStatement(sql);
+		if (!stmt)
+		{
+			throw std::runtime_error("Failed to prepare batch update: " + analyzer_.getLastError());
+		} // end of if
+
+		statements_.add(currentFilters_, stmt);
+		return stmt;
+	} // end of statementForCurrentShape
+
 	void PreparedUpdate::ExecuteBatch()
 	{
-		// Build UPDATE statement
-		std::ostringstream sql;
-		sql << "UPDATE " << tableName_ << " SET ";
+		sqlite3_stmt* stmt = statementForCurrentShape();
 
-		// SET clause
-		size_t index = 0;
-		for (const auto& [col, val] : updates_)
+		// SET values stay in place; only the WHERE values change per item
+		params_.resize(setCount_);
+		for (const auto& filter : currentFilters_)
 		{
-			if (index++ > 0) sql << ", ";
-			sql << col << " = " << valueToSql(val);
+			params_.push_back(filter.value_);
 		} // end of for
 
-		// WHERE clause
-		if (!currentFilters_.empty())
-		{
-			sql << " WHERE ";
-			for (size_t i = 0; i < currentFilters_.size(); ++i)
-			{
-				if (i > 0) sql << " AND ";
-				sql << currentFilters_[i].toSql();
-			} // end of for
-		} // end of if
+		auto result = analyzer_.executePrepared(stmt, params_);
 
-		// Execute the update
-		if (!analyzer_.execute(sql.str()))
+		// Clear current filters for next batch item
+		currentFilters_.clear();
+
+		if (!result)
 		{
-			throw std::runtime_error("Batch update failed: " + analyzer_.getLastError());
+			throw std::runtime_error("Batch update failed: " + result.error);
 		} // end of if
 
-		// Get rows affected (requires adding helper to Analyzer)
-		auto result = analyzer_.query("SELECT changes() as affected");
-		if (!result.empty())
+		updateCount_ += result.changes;
+		changesSinceCommit_ += result.changes;
+
+		// The update hook misses the truncate optimization and WITHOUT ROWID tables
+		if (result.changes > 0)
 		{
-			auto affected = getValue<int64_t>(result[0], "affected");
-			updateCount_ += affected.value_or(0);
+			analyzer_.invalidateResultCache(tableName_);
 		} // end of if
 
-		// Clear current filters for next batch item
-		currentFilters_.clear();
-
-		// Auto-commit every N operations for better performance
-		if (updateCount_ % batchSize_ == 0)
+		// Auto-commit every N operations (not rows: items matching nothing count too)
+		if (++operationCount_ % batchSize_ == 0)
 		{
-			analyzer_.commit();
-			analyzer_.beginTransaction();
+			if (!analyzer_.commit())
+			{
+				std::string error = analyzer_.getLastError();
+				analyzer_.rollback();
+				inTransaction_ = false;
+				updateCount_ -= changesSinceCommit_;  // Those changes were rolled back
+				changesSinceCommit_ = 0;
+				throw std::runtime_error("Failed to commit batch update transaction: " + error);
+			} // end of if
+			changesSinceCommit_ = 0;
+
+			if (!analyzer_.beginTransaction())
+			{
+				inTransaction_ = false;
+				throw std::runtime_error("Failed to begin transaction for batch update: " + analyzer_.getLastError());
+			} // end of if
 		} // end of if
 	} // end of ExecuteBatch
 
@@ -162,6 +150,7 @@ namespace sqlite_flux
 			inTransaction_ = false;
 		} // end of if
 
+		cleanup();
 		return updateCount_;
 	} // end of Finalize
 
@@ -172,6 +161,8 @@ namespace sqlite_flux
 			analyzer_.rollback();
 			inTransaction_ = false;
 		} // end of if
+
+		statements_.clear();
 	} // end of cleanup
 
 	// ============================================================================
@@ -181,10 +172,10 @@ namespace sqlite_flux
 	UpdateBuilder::UpdateBuilder(Analyzer& analyzer, const std::string& tableName)
 		: analyzer_(analyzer), tableName_(tableName)
 	{
-		// Get and cache table schema
-		schema_ = analyzer_.getTableSchema(tableName_);
+		// Shared descriptor from the connection's schema snapshot (no copy)
+		table_ = analyzer_.getTableDescriptor(tableName_);
 
-		if (schema_.empty())
+		if (!table_ || table_->empty())
 		{
 			throw std::runtime_error("Table not found or has no columns: " + tableName_);
 		} // end of if
@@ -237,21 +228,27 @@ namespace sqlite_flux
 
 		std::string sql = buildSql();
 
-		if (!analyzer_.execute(sql))
+		auto result = analyzer_.executeDml(sql, buildParams());
+		if (!result)
 		{
-			throw std::runtime_error("Update failed: " + analyzer_.getLastError());
+			throw std::runtime_error("Update failed: " + result.error);
 		} // end of if
 
-		// Get rows affected
-		auto result = analyzer_.query("SELECT changes() as affected");
-		if (!result.empty())
+		analyzer_.invalidateResultCache(tableName_);
+
+		return result.changes;
+	} // end of Execute
+
+	std::future<ExecuteResult> UpdateBuilder::Submit(WriteBatcher& batcher)
+	{
+		if (updates_.empty())
 		{
-			auto affected = getValue<int64_t>(result[0], "affected");
-			return affected.value_or(0);
+			throw std::runtime_error("No columns set for update");
 		} // end of if
 
-		return 0;
-	} // end of Execute
+		validateSafeExecution();
+		return batcher.submit(buildSql(), buildParams());
+	} // end of Submit
 
 	PreparedUpdate UpdateBuilder::Prepare()
 	{
@@ -274,7 +271,7 @@ namespace sqlite_flux
 		for (const auto& [col, val] : updates_)
 		{
 			if (index++ > 0) sql << ", ";
-			sql << col << " = " << valueToSql(val);
+			sql << col << " = ?";
 		} // end of for
 
 		// WHERE clause
@@ -291,93 +288,34 @@ namespace sqlite_flux
 		return sql.str();
 	} // end of buildSql
 
-	void UpdateBuilder::validateColumn(const std::string& column_) const
+	std::vector<ColumnValue> UpdateBuilder::buildParams() const
 	{
-		auto it = std::find_if(schema_.begin(), schema_.end(),
-			[&column_](const ColumnInfo& info) { return info.name == column_; });
-
-		if (it == schema_.end())
-		{
-			throw std::runtime_error("Column '" + column_ + "' not found in table '" + tableName_ + "'");
-		} // end of if
-	} // end of validateColumn
+		// SET values first, then WHERE values - same order as buildSql
+		std::vector<ColumnValue> params;
+		params.reserve(updates_.size() + filters_.size());
 
-	void UpdateBuilder::validateColumnType(const std::string& column_, const ColumnValue& value_) const
-	{
-		// Allow NULL for any column type
-		if (std::holds_alternative<std::monostate>(value_))
+		for (const auto& [col, val] : updates_)
 		{
-			return;
-		} // end of if
-
-		std::string sqliteType = getSqliteType(column_);
+			params.push_back(val);
+		} // end of for
 
-		if (!isTypeCompatible(sqliteType, value_))
+		for (const auto& filter : filters_)
 		{
-			std::string valueType;
-			std::visit(overloaded{
-				[&valueType](std::monostate) { valueType = "NULL"; },
-				[&valueType](int64_t) { valueType = "int64_t"; },
-				[&valueType](double) { valueType = "double"; },
-				[&valueType](const std::string&) { valueType = "string"; },
-				[&valueType](const std::vector<uint8_t>&) { valueType = "blob"; }
-				}, value_);
+			params.push_back(filter.value_);
+		} // end of for
 
-			throw std::runtime_error(
-				"Type mismatch for column_ '" + column_ + "': " +
-				"expected " + sqliteType + ", got " + valueType
-			);
-		} // end of if
-	} // end of validateColumnType
+		return params;
+	} // end of buildParams
 
-	std::string UpdateBuilder::getSqliteType(const std::string& column_) const
+	void UpdateBuilder::validateColumn(const std::string& column_) const
 	{
-		auto it = std::find_if(schema_.begin(), schema_.end(),
-			[&column_](const ColumnInfo& info) { return info.name == column_; });
-
-		if (it != schema_.end())
-		{
-			return it->type;
-		} // end of if
-
-		return "";
-	} // end of getSqliteType
+		table_->require(column_);
+	} // end of validateColumn
 
-	bool UpdateBuilder::isTypeCompatible(const std::string& sqliteType, const ColumnValue& value_) const
+	void UpdateBuilder::validateColumnType(const std::string& column_, const ColumnValue& value_) const
 	{
-		// SQLite type affinity rules (same as InsertBuilder)
-		// INTEGER affinity
-		if (sqliteType.find("INT") != std::string::npos)
-		{
-			return std::holds_alternative<int64_t>(value_);
-		} // end of if
-
-		// TEXT affinity
-		if (sqliteType.find("CHAR") != std::string::npos ||
-			sqliteType.find("CLOB") != std::string::npos ||
-			sqliteType.find("TEXT") != std::string::npos)
-		{
-			return std::holds_alternative<std::string>(value_);
-		} // end of if
-
-		// BLOB affinity
-		if (sqliteType.find("BLOB") != std::string::npos)
-		{
-			return std::holds_alternative<std::vector<uint8_t>>(value_);
-		} // end of if
-
-		// REAL affinity
-		if (sqliteType.find("REAL") != std::string::npos ||
-			sqliteType.find("FLOA") != std::string::npos ||
-			sqliteType.find("DOUB") != std::string::npos)
-		{
-			return std::holds_alternative<double>(value_);
-		} // end of if
-
-		// NUMERIC affinity - accepts both int and real
-		return std::holds_alternative<int64_t>(value_) ||
-			std::holds_alternative<double>(value_);
-	} // end of isTypeCompatible
+		table_->validateValue(column_, value_);
+	} // end of validateColumnType
 
 	void UpdateBuilder::validateSafeExecution() const
 	{
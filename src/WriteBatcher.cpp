@@ -0,0 +1,223 @@
+// src/WriteBatcher.cpp
+#include "WriteBatcher.h"
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+
+namespace sqlite_flux
+{
+
+	namespace
+	{
+		ExecuteResult failure(std::string error)
+		{
+			ExecuteResult result;
+			result.error = std::move(error);
+			return result;
+		} // end of failure
+	} // namespace
+
+	WriteBatcher::WriteBatcher(ConnectionPool& pool, const WriteBatcherOptions& options)
+		: pool_(pool), options_(options)
+	{
+		options_.maxBatchRows = std::max<size_t>(options_.maxBatchRows, 1);
+		flusher_ = std::thread(&WriteBatcher::flusherLoop, this);
+	} // end of WriteBatcher constructor
+
+	WriteBatcher::~WriteBatcher()
+	{
+		{
+			std::lock_guard lock(mutex_);
+			stopping_ = true;
+		} // end of lock scope
+		queueCv_.notify_one();
+
+		if (flusher_.joinable())
+		{
+			flusher_.join();
+		} // end of if
+	} // end of WriteBatcher destructor
+
+	std::future<ExecuteResult> WriteBatcher::submit(std::string sql, std::vector<ColumnValue> params)
+	{
+		auto promise = std::make_shared<std::promise<ExecuteResult>>();
+		auto future = promise->get_future();
+
+		submit(std::move(sql), std::move(params), [promise](ExecuteResult result) {
+			promise->set_value(std::move(result));
+			});
+
+		return future;
+	} // end of submit
+
+	void WriteBatcher::submit(std::string sql, std::vector<ColumnValue> params, Completion done)
+	{
+		{
+			std::lock_guard lock(mutex_);
+			if (stopping_)
+			{
+				throw std::runtime_error("WriteBatcher is shutting down");
+			} // end of if
+
+			queue_.push_back(PendingWrite{ std::move(sql), std::move(params), std::move(done),
+				std::chrono::steady_clock::now() });
+			++submitted_;
+		} // end of lock scope
+
+		queueCv_.notify_one();
+	} // end of submit
+
+	void WriteBatcher::flush()
+	{
+		std::unique_lock lock(mutex_);
+		const uint64_t target = submitted_;
+		flushUpTo_ = std::max(flushUpTo_, target);
+		queueCv_.notify_one();
+
+		doneCv_.wait(lock, [this, target] { return completed_ >= target; });
+	} // end of flush
+
+	WriteBatcherStats WriteBatcher::getStats() const
+	{
+		std::lock_guard lock(mutex_);
+
+		WriteBatcherStats stats;
+		stats.submitted = submitted_;
+		stats.batches = batches_;
+		stats.failed = failed_;
+		stats.largestBatch = largestBatch_;
+		stats.pending = queue_.size();
+		return stats;
+	} // end of getStats
+
+	void WriteBatcher::flusherLoop()
+	{
+		std::unique_lock lock(mutex_);
+		while (true)
+		{
+			queueCv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+			if (queue_.empty()) break;  // Stopping and drained
+
+			// Let the batch fill up, unless it is full, flushed or we are shutting down
+			if (options_.maxDelay.count() > 0)
+			{
+				const auto deadline = queue_.front().queuedAt + options_.maxDelay;
+				queueCv_.wait_until(lock, deadline, [this] {
+					return stopping_ || queue_.size() >= options_.maxBatchRows || flushUpTo_ > completed_;
+					});
+			} // end of if
+
+			const size_t count = std::min(queue_.size(), options_.maxBatchRows);
+			std::vector<PendingWrite> batch(std::make_move_iterator(queue_.begin()),
+				std::make_move_iterator(queue_.begin() + count));
+			queue_.erase(queue_.begin(), queue_.begin() + count);
+			lock.unlock();
+
+			std::vector<ExecuteResult> results(batch.size());
+			writeBatch(batch, results);
+
+			uint64_t failures = 0;
+			for (size_t i = 0; i < batch.size(); ++i)
+			{
+				if (!results[i]) ++failures;
+				if (!batch[i].done) continue;
+
+				try
+				{
+					batch[i].done(std::move(results[i]));
+				} // end of try
+				catch (...)
+				{
+					// A throwing callback must not take the flusher (and everyone else's writes) down
+				} // end of catch
+			} // end of for
+
+			lock.lock();
+			completed_ += batch.size();
+			failed_ += failures;
+			++batches_;
+			largestBatch_ = std::max(largestBatch_, batch.size());
+			doneCv_.notify_all();
+		} // end of while
+	} // end of flusherLoop
+
+	void WriteBatcher::writeBatch(const std::vector<PendingWrite>& batch, std::vector<ExecuteResult>& results)
+	{
+		std::optional<ConnectionPool::Connection> conn;
+		try
+		{
+			conn.emplace(pool_.acquireWrite());
+		} // end of try
+		catch (const std::exception& e)
+		{
+			std::fill(results.begin(), results.end(), failure(std::string("Failed to acquire writer: ") + e.what()));
+			return;
+		} // end of catch
+
+		Analyzer& db = **conn;
+
+		if (batch.size() == 1)
+		{
+			// A lone statement is already atomic; skip BEGIN/SAVEPOINT/COMMIT
+			results[0] = db.executeDml(batch[0].sql, batch[0].params);
+		} // end of if
+		else
+		{
+			size_t next = 0;
+			while (next < batch.size())
+			{
+				const size_t first = next;
+				if (!db.execute("BEGIN IMMEDIATE"))
+				{
+					std::fill(results.begin() + next, results.end(), failure("Failed to begin batch: " + db.getLastError()));
+					break;
+				} // end of if
+
+				bool aborted = false;
+				for (; next < batch.size(); ++next)
+				{
+					db.executeDml("SAVEPOINT write_batcher");
+					results[next] = db.executeDml(batch[next].sql, batch[next].params);
+					if (results[next])
+					{
+						db.executeDml("RELEASE write_batcher");
+						continue;
+					} // end of if
+
+					if (!db.isInTransaction())
+					{
+						// SQLite rolled the whole transaction back: earlier writes are gone too.
+						// Carry on with the rest in a fresh transaction.
+						std::fill(results.begin() + first, results.begin() + next,
+							failure("Batch rolled back: " + results[next].error));
+						++next;
+						aborted = true;
+						break;
+					} // end of if
+
+					db.executeDml("ROLLBACK TO write_batcher");
+					db.executeDml("RELEASE write_batcher");
+				} // end of for
+
+				if (aborted) continue;
+
+				if (!db.commit())
+				{
+					std::string error = db.getLastError();
+					db.rollback();
+					std::fill(results.begin() + first, results.begin() + next, failure("Commit failed: " + error));
+				} // end of if
+			} // end of while
+		} // end of else
+
+		for (ExecuteResult& result : results)
+		{
+			// Otherwise this would be whichever write last inserted on the connection
+			if (result.success && result.changes == 0)
+			{
+				result.lastInsertRowid = 0;
+			} // end of if
+		} // end of for
+	} // end of writeBatch
+
+} // namespace sqlite_flux